@@ -1179,6 +1179,11 @@ namespace DataOutBase
     /**
      * Flag determining the compression level at which zlib, if available, is
      * run. The default is <tt>best_speed</tt>.
+     *
+     * Data arrays larger than one megabyte are split into blocks of that size
+     * as described by the VTK compression header format. The blocks are
+     * compressed independently of each other and concurrently on the
+     * available threads.
      */
     DataOutBase::CompressionLevel compression_level;
 
@@ -1224,6 +1229,55 @@ namespace DataOutBase
      */
     std::map<std::string, std::string> physical_units;
 
+    /**
+     * The number of significant binary digits with which the values of the
+     * data vectors are written in VTU format. The default, 24, is the
+     * precision of the <code>Float32</code> values in VTU files, i.e., the
+     * values are written without additional loss of accuracy. Smaller values
+     * round every value to that many significant binary digits, so that the
+     * relative error of each value is at most $2^{-n}$, and set the remaining
+     * bits of its <code>Float32</code> representation to zero. For example,
+     * 11 significant digits correspond to the precision of IEEE half
+     * precision numbers.
+     *
+     * The output remains a regular VTU file readable by all visualization
+     * programs, but compresses considerably better when zlib compression is
+     * enabled, see #compression_level. The coordinates of the points are not
+     * affected by this flag.
+     */
+    unsigned int n_significant_bits;
+
+    /**
+     * A map from the names of (some or all) of the output quantities to
+     * absolute error tolerances. In VTU output, the values of these
+     * quantities are rounded to multiples of the largest power of two that
+     * does not exceed twice the tolerance, so that the error of every value
+     * is at most the tolerance. Like #n_significant_bits, this lets zlib
+     * compress the data much better. Vectors and tensors are looked up by
+     * their name or, if they have no name, by the name of their first
+     * component, as for #physical_units.
+     *
+     * The default is an empty map, i.e., no quantization.
+     */
+    std::map<std::string, double> quantization_tolerances;
+
+    /**
+     * If positive, every patch of hypercube shape whose data can be
+     * represented with an absolute error of at most this tolerance by
+     * multilinear interpolation on a coarser subdivision is written to VTU
+     * files with the smallest such number of subdivisions that divides its
+     * Patch::n_subdivisions. The positions of the points of patches with
+     * explicitly given points (for example curved cells at the boundary)
+     * must also be represented within this tolerance. This typically reduces
+     * the size of output that was built with many subdivisions to resolve
+     * high order or strongly varying data only in parts of the domain.
+     *
+     * This flag is ignored if #write_higher_order_cells is set, and by
+     * DataOut::write_vtu_higher_order(). The default is zero, i.e., all
+     * patches are written with all of their subdivisions.
+     */
+    double subdivision_tolerance;
+
     /**
      * Constructor. Initializes the member variables with names corresponding
      * to the argument names of this function.
@@ -2086,6 +2140,67 @@ namespace DataOutBase
     const VtkFlags &flags,
     std::ostream   &out);
 
+  /**
+   * Same as above, but the <code>Points</code> and <code>Cells</code>
+   * sections of the output are taken from @p mesh_output if that string is
+   * not empty. Otherwise, they are generated from the patches as usual and
+   * stored in @p mesh_output. This avoids encoding the vertices and the
+   * connectivity again when writing output for patches that only differ in
+   * their data, for example for the time steps of a simulation on a fixed
+   * mesh. It is the caller's responsibility to clear @p mesh_output whenever
+   * the geometry of the patches, the compression level or
+   * VtkFlags::write_higher_order_cells in @p flags, or the precision of
+   * @p out changes.
+   */
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string>          &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+                   &nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::string    &mesh_output,
+    std::ostream   &out);
+
+  /**
+   * Write a <code>DataArray</code> element of a vtu file that holds the given
+   * @p data, with the given @p attributes (for example,
+   * <code>type="Float32" Name="solution"</code>) in its opening tag. The data
+   * is compressed and base64-encoded, or written as plain text, depending on
+   * the compression level set in @p flags, and written with the precision of
+   * @p out.
+   *
+   * This function is used by writers that assemble the pieces of a vtu file
+   * themselves instead of going through write_vtu_main(), such as
+   * DataOut::write_vtu_higher_order(). It is instantiated for @p T equal to
+   * <code>float</code>, <code>std::int32_t</code>, and
+   * <code>std::uint8_t</code>.
+   */
+  template <typename T>
+  void
+  write_vtu_data_array(const std::vector<T> &data,
+                       const std::string    &attributes,
+                       const VtkFlags       &flags,
+                       std::ostream         &out);
+
+  /**
+   * Round the values in @p data of the output quantity with the given
+   * @p name as described for VtkFlags::quantization_tolerances and
+   * VtkFlags::n_significant_bits. write_vtu() does this for all data
+   * vectors. Writers that assemble the pieces of a vtu file themselves with
+   * write_vtu_data_array() need to call this function on their data arrays
+   * to honor these flags.
+   */
+  void
+  quantize_vtu_data(std::vector<float> &data,
+                    const std::string  &name,
+                    const VtkFlags     &flags);
+
   /**
    * Some visualization programs, such as ParaView, can read several separate
    * VTU files that all form part of the same simulation, in order to
@@ -3063,6 +3178,15 @@ protected:
   virtual const std::vector<DataOutBase::Patch<dim, spacedim>> &
   get_patches() const = 0;
 
+  /**
+   * Return the patches and leave this object without any, for use by
+   * DataOutBackgroundWriter. The default implementation returns a copy of
+   * the patches returned by get_patches(). Derived classes that store their
+   * patches override this function to move them out of the object instead.
+   */
+  virtual std::vector<DataOutBase::Patch<dim, spacedim>>
+  release_patches();
+
   /**
    * Abstract virtual function through which the names of data sets are
    * obtained by the output functions of the base class.
@@ -3104,6 +3228,25 @@ protected:
   void
   validate_dataset_names() const;
 
+  /**
+   * Return the flags used for output in VTK and VTU format, as set by
+   * set_flags().
+   */
+  const DataOutBase::VtkFlags &
+  get_vtk_flags() const;
+
+  /**
+   * An identifier for the geometric part of the patches returned by
+   * get_patches(), i.e., their vertices, points, and connectivity. A derived
+   * class that knows that the geometry of its patches did not change between
+   * two calls of its build_patches() function can set this variable to the
+   * same nonzero value after both calls, and must set it to a different value
+   * whenever the geometry changes. write_vtu() and write_vtu_in_parallel()
+   * then reuse the encoded points and cells of the previous output rather
+   * than encoding them again. The default value zero means that nothing is
+   * known about the geometry and that nothing is reused.
+   */
+  unsigned int patch_geometry_id;
 
   /**
    * The default number of subdivisions for patches. This is filled by
@@ -3174,6 +3317,25 @@ private:
    */
   DataOutBase::VtkFlags vtk_flags;
 
+  /**
+   * The <code>Points</code> and <code>Cells</code> sections of the last VTU
+   * output written for patches with a nonzero patch_geometry_id, along with
+   * that identifier, the compression level, whether higher order cells were
+   * written, and the precision of the output stream.
+   */
+  mutable std::string vtu_mesh_cache;
+  mutable std::
+    tuple<unsigned int, DataOutBase::CompressionLevel, bool, std::streamsize>
+      vtu_mesh_cache_key;
+
+  /**
+   * Return a reference to vtu_mesh_cache after clearing it if it was not
+   * written for the current patch_geometry_id, VTK flags, and the given
+   * @p precision of the output stream.
+   */
+  std::string &
+  get_vtu_mesh_cache(const std::streamsize precision) const;
+
   /**
    * Flags to be used upon output of svg data in one space dimension. Can be
    * changed by using the <tt>set_flags</tt> function.
@@ -3185,6 +3347,14 @@ private:
    * dimension. Can be changed by using the <tt>set_flags</tt> function.
    */
   DataOutBase::Deal_II_IntermediateFlags deal_II_intermediate_flags;
+
+  // DataOutBackgroundWriter needs access to the patches and the VTK flags
+  template <int, int>
+  friend class DataOutBackgroundWriter;
+
+  // DataOutHDF5TimeSeries needs to know the reference cell of the patches
+  template <int, int>
+  friend class DataOutHDF5TimeSeries;
 };
 
 
@@ -3371,6 +3541,276 @@ private:
 
 
 
+/**
+ * A class that writes the output of DataOut and related classes in the
+ * background, so that a simulation can continue with its next time step
+ * while the output of the previous one is still being compressed and
+ * written to disk.
+ *
+ * write_vtu_with_pvtu_record() takes over the patches of the object passed
+ * to it (see DataOutInterface::release_patches()), copies the names of the
+ * data sets and the VTK flags, and hands this data to a separate thread
+ * (started with `std::async(std::launch::async, ...)`) that writes the files
+ * the same way DataOutInterface::write_vtu_with_pvtu_record() would. A
+ * dedicated thread is used rather than a task (see Threads::new_task()), so
+ * that the writing makes progress even while the main program keeps all
+ * threads of the task scheduler busy.
+ * The object passed in can therefore be reused (for example, by calling
+ * DataOut::build_patches() for the next time step) or destroyed as soon as
+ * the function returns. To bound the memory held by this class, at most
+ * @p max_n_pending_writes writes (an argument of the constructor) are in
+ * flight at any time: further calls first wait for the oldest write to
+ * finish. wait() blocks until all pending writes are complete.
+ *
+ * A typical use looks as follows:
+ * @code
+ * DataOutBackgroundWriter<dim> writer;
+ * for (unsigned int step = 0; step < n_time_steps; ++step)
+ *   {
+ *     ... // solve for this time step
+ *
+ *     DataOut<dim> data_out;
+ *     data_out.attach_dof_handler(dof_handler);
+ *     data_out.add_data_vector(solution, "solution");
+ *     data_out.build_patches();
+ *     writer.write_vtu_with_pvtu_record(
+ *       data_out, "output/", "solution", step, mpi_communicator, 4);
+ *   }
+ * writer.wait();
+ * @endcode
+ *
+ * If every MPI rank writes its own file (i.e., if @p n_groups is zero), the
+ * background threads do not communicate. Writing fewer files than there are
+ * ranks requires collective MPI I/O operations, which can only run
+ * concurrently with the communication of the main program if MPI was
+ * initialized with @p MPI_THREAD_MULTIPLE support. In that case, the files
+ * are written on a duplicate of the given communicator.
+ *
+ * Otherwise, write_vtu_with_pvtu_record() falls back to serial output: It
+ * simply calls DataOutInterface::write_vtu_with_pvtu_record() on the object
+ * passed to it, so all ranks take part in the collective MPI I/O operations
+ * on the calling thread and the files are complete when the function
+ * returns. The object keeps its patches in that case, and
+ * n_pending_writes() does not change.
+ *
+ * @note Errors that happen while writing are reported by wait() (and by
+ * write_vtu_with_pvtu_record() when it has to wait for an earlier write).
+ * The destructor also waits for all pending writes, but has to ignore
+ * errors.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim = dim>
+class DataOutBackgroundWriter
+{
+public:
+  /**
+   * Constructor. @p max_n_pending_writes is the maximal number of writes
+   * that may be in progress at the same time, and with it the maximal
+   * number of sets of patches this object holds.
+   */
+  explicit DataOutBackgroundWriter(const unsigned int max_n_pending_writes = 1);
+
+  /**
+   * Destructor. Waits for all pending writes to finish.
+   */
+  ~DataOutBackgroundWriter();
+
+  /**
+   * Write the data of @p data_out in the background. The arguments and the
+   * files written are the same as for
+   * DataOutInterface::write_vtu_with_pvtu_record(), whose documentation
+   * describes them in detail.
+   *
+   * The patches are moved out of @p data_out rather than copied if it stores
+   * them itself, as DataOut and the other classes derived from
+   * DataOut_DoFData do. @p data_out then has no patches anymore, and needs to
+   * build new ones before it can produce output again.
+   *
+   * The return value is the name of the pvtu record. Note that the file may
+   * not yet exist when this function returns.
+   *
+   * If fewer files than ranks are to be written and MPI does not support
+   * @p MPI_THREAD_MULTIPLE, this function writes the files itself before it
+   * returns and leaves the patches in @p data_out (see the class
+   * documentation).
+   */
+  std::string
+  write_vtu_with_pvtu_record(
+    DataOutInterface<dim, spacedim> &data_out,
+    const std::string               &directory,
+    const std::string               &filename_without_extension,
+    const unsigned int               counter,
+    const MPI_Comm                   mpi_communicator,
+    const unsigned int n_digits_for_counter = numbers::invalid_unsigned_int,
+    const unsigned int n_groups             = 0);
+
+  /**
+   * Wait until all writes started so far have been completed.
+   */
+  void
+  wait();
+
+  /**
+   * Return the number of writes that have been started but not yet waited
+   * for.
+   */
+  unsigned int
+  n_pending_writes() const;
+
+private:
+  /**
+   * A class holding the output data taken from a DataOutInterface object.
+   */
+  class OutputData;
+
+  /**
+   * A write that has been started: the data it writes, the future of the
+   * thread doing the work, and the communicator the thread uses (which needs
+   * to be freed once the thread is done), if any. Declared here and defined
+   * in the source file, so that this header does not need to include
+   * `<future>`.
+   */
+  struct PendingWrite;
+
+  /**
+   * Wait for the oldest pending write and remove it from the list.
+   */
+  void
+  finish_oldest_write();
+
+  /**
+   * The maximal number of pending writes.
+   */
+  const unsigned int max_n_pending_writes;
+
+  /**
+   * The writes that have been started, oldest first.
+   */
+  std::vector<PendingWrite> pending_writes;
+};
+
+
+
+/**
+ * A class that writes the output of a time-dependent simulation into a
+ * single HDF5 file, along with an XDMF file that describes the time series
+ * for visualization programs such as ParaView or VisIt.
+ *
+ * DataOutInterface::write_hdf5_parallel() writes a new file (or pair of
+ * files) for every time step, and DataOutInterface::write_xdmf_file() has to
+ * rewrite the XDMF file with the entries of all time steps every time. In
+ * contrast, every call to write_time_step() of this class appends to both
+ * files: The data of the $n$th time step goes into the group
+ * <code>/step_n</code> of the HDF5 file, and a grid that refers to it is
+ * appended to the temporal collection in the XDMF file. The mesh, i.e., the
+ * locations of the nodes and the cells, is only written if it differs from
+ * the one of the previous time step, into the group <code>/mesh_k</code>;
+ * the XDMF entries of all time steps on the same mesh refer to the same
+ * datasets. Whether the mesh has changed is determined by comparing a
+ * checksum of the nodes and cells on each process with the one of the
+ * previous time step.
+ *
+ * All datasets are written collectively via MPI-IO if HDF5 was built with
+ * MPI support. They are stored in chunks of about one megabyte that are
+ * compressed with zlib at the level given by
+ * DataOutBase::Hdf5Flags::compression_level if deal.II was configured with
+ * zlib (and, for parallel output, if the HDF5 library is recent enough to
+ * support filters in parallel).
+ *
+ * A typical use looks as follows:
+ * @code
+ * DataOutHDF5TimeSeries<dim> time_series("solution.h5",
+ *                                        "solution.xdmf",
+ *                                        mpi_communicator);
+ * for (unsigned int step = 0; step < n_time_steps; ++step)
+ *   {
+ *     ... // solve for this time step
+ *
+ *     DataOut<dim> data_out;
+ *     data_out.attach_dof_handler(dof_handler);
+ *     data_out.add_data_vector(solution, "solution");
+ *     data_out.build_patches();
+ *     time_series.write_time_step(data_out, time);
+ *   }
+ * @endcode
+ *
+ * The XDMF file refers to the HDF5 file by its name without the directory,
+ * so both files need to be placed into the same directory. Both files are
+ * valid after every call to write_time_step(), so they can already be
+ * visualized while the simulation is still running.
+ *
+ * @ingroup output
+ */
+template <int dim, int spacedim = dim>
+class DataOutHDF5TimeSeries
+{
+public:
+  /**
+   * Constructor. Create (or overwrite) the HDF5 file @p h5_filename and the
+   * XDMF file @p xdmf_filename, which are written collectively by all
+   * processes in @p mpi_communicator.
+   */
+  DataOutHDF5TimeSeries(
+    const std::string            &h5_filename,
+    const std::string            &xdmf_filename,
+    const MPI_Comm                mpi_communicator,
+    const DataOutBase::Hdf5Flags &flags = DataOutBase::Hdf5Flags());
+
+  /**
+   * Append the data of @p data_out at time @p time to the time series. This
+   * function needs to be called by all processes of the communicator given
+   * to the constructor.
+   */
+  void
+  write_time_step(const DataOutInterface<dim, spacedim> &data_out,
+                  const double                           time);
+
+  /**
+   * Return the number of time steps written so far.
+   */
+  unsigned int
+  n_time_steps() const;
+
+  /**
+   * Return the number of different meshes written so far.
+   */
+  unsigned int
+  n_meshes() const;
+
+private:
+  /**
+   * The names of the HDF5 and XDMF files.
+   */
+  const std::string h5_filename;
+  const std::string xdmf_filename;
+
+  /**
+   * The communicator all processes that write belong to.
+   */
+  const MPI_Comm mpi_communicator;
+
+  /**
+   * The flags controlling the compression of the datasets.
+   */
+  const DataOutBase::Hdf5Flags flags;
+
+  /**
+   * The number of time steps and meshes written so far.
+   */
+  unsigned int n_written_time_steps;
+  unsigned int n_written_meshes;
+
+  /**
+   * A checksum of the nodes and cells of this process in the mesh that was
+   * written last, used to find out whether the mesh of the next time step
+   * differs from it.
+   */
+  std::uint64_t mesh_checksum;
+};
+
+
+
 /**
  * A class to store relevant data to use when writing a lightweight XDMF
  * file. The XDMF file in turn points to heavy data files (such as HDF5)
@@ -223,6 +223,25 @@ public:
   virtual RangeNumberType
   value(const Point<dim> &p, const unsigned int component = 0) const;
 
+  /**
+   * Return the value of the function at a batch of points given as a
+   * Point with VectorizedArray coordinates, as used in the matrix-free
+   * framework (see, e.g., FEEvaluation::quadrature_point()). Each lane of the
+   * returned array contains the value of the specified component at the
+   * point formed by the respective lane of the coordinates of @p p.
+   *
+   * This function is not virtual: it calls value() for each lane, so
+   * derived classes only need to implement the scalar version. It is a
+   * convenience for code that evaluates a function in one quadrature point
+   * of a batch of cells at a time. Code that evaluates many points at once
+   * should collect them and call value_list() instead, which derived
+   * classes such as FunctionParser implement more efficiently.
+   */
+  template <typename Number, std::size_t width>
+  VectorizedArray<Number, width>
+  value_batch(const Point<dim, VectorizedArray<Number, width>> &p,
+              const unsigned int component = 0) const;
+
   /**
    * Return all components of a vector-valued function at a given point.
    *
@@ -1230,6 +1249,28 @@ inline Function<dim, RangeNumberType>::~Function() = default;
 #endif
 
 
+
+#ifndef DOXYGEN
+template <int dim, typename RangeNumberType>
+template <typename Number, std::size_t width>
+inline VectorizedArray<Number, width>
+Function<dim, RangeNumberType>::value_batch(
+  const Point<dim, VectorizedArray<Number, width>> &p,
+  const unsigned int                                component) const
+{
+  VectorizedArray<Number, width> result;
+  for (unsigned int v = 0; v < width; ++v)
+    {
+      Point<dim> point;
+      for (unsigned int d = 0; d < dim; ++d)
+        point[d] = p[d][v];
+      result[v] = this->value(point, component);
+    }
+  return result;
+}
+#endif
+
+
 DEAL_II_NAMESPACE_CLOSE
 
 #endif
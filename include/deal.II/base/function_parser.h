@@ -145,11 +145,14 @@ class Vector;
  *         << " is " << result << std::endl;
  * @endcode
  *
- * This class overloads the virtual methods value() and vector_value() of the
- * Function base class with the byte compiled versions of the expressions
- * given to the initialize() methods. Note that the class will not work unless
- * you first call the initialize() method that accepts the text description of
- * the function as an argument (among other things).
+ * This class overloads the virtual methods value(), vector_value(),
+ * value_list(), and vector_value_list() of the Function base class with the
+ * byte compiled versions of the expressions given to the initialize()
+ * methods. The list versions evaluate the byte code for all points in a row
+ * and should be preferred when evaluating the function at many points. Note
+ * that the class will not work unless you first call the initialize() method
+ * that accepts the text description of the function as an argument (among
+ * other things).
  *
  * The syntax to describe a function follows usual programming practice, and
  * is explained in detail at the homepage of the underlying muparser library
@@ -344,6 +347,34 @@ public:
   virtual double
   value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+  /**
+   * Return all components of the function at the given point. The
+   * thread-local parser objects are looked up only once for all components.
+   */
+  virtual void
+  vector_value(const Point<dim> &p, Vector<double> &values) const override;
+
+  /**
+   * Set <tt>values</tt> to the values of the specified component of the
+   * function at the <tt>points</tt>. The compiled expression is evaluated for
+   * all points in a row, rather than going through value() for every point
+   * separately.
+   */
+  virtual void
+  value_list(const std::vector<Point<dim>> &points,
+             std::vector<double>           &values,
+             const unsigned int             component = 0) const override;
+
+  /**
+   * Set <tt>values</tt> to the values of all components of the function at
+   * the <tt>points</tt>, evaluating the compiled expressions for all points in
+   * a row. This function is called, e.g., by VectorTools::interpolate() and
+   * VectorTools::interpolate_boundary_values().
+   */
+  virtual void
+  vector_value_list(const std::vector<Point<dim>> &points,
+                    std::vector<Vector<double>>   &values) const override;
+
   /**
    * Return an array of function expressions (one per component), used to
    * initialize this function.
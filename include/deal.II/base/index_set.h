@@ -25,6 +25,7 @@
 #include <boost/container/small_vector.hpp>
 
 #include <algorithm>
+#include <atomic>
 #include <vector>
 
 
@@ -107,15 +108,17 @@ public:
   explicit IndexSet(const size_type size);
 
   /**
-   * Copy constructor.
+   * Copy constructor. The input set is compressed before its data is copied,
+   * so that the new object is compressed as well.
    */
-  IndexSet(const IndexSet &) = default;
+  IndexSet(const IndexSet &is);
 
   /**
-   * Copy assignment operator.
+   * Copy assignment operator. The input set is compressed before its data is
+   * copied, so that the current object is compressed as well.
    */
   IndexSet &
-  operator=(const IndexSet &) = default;
+  operator=(const IndexSet &is);
 
   /**
    * Move constructor. Create a new IndexSet by transferring the internal data
@@ -312,6 +315,13 @@ public:
   /**
    * Compress the internal representation by merging individual elements with
    * contiguous ranges, etc. This function does not have any external effect.
+   *
+   * Many of the other `const` member functions call this function. It is safe
+   * to do so from several threads concurrently: The compression itself is
+   * protected by a mutex, but once the set has been compressed, checking
+   * this is a single atomic load, so that concurrent queries of a compressed
+   * index set such as is_element() or index_within_set() do not need to
+   * synchronize with each other.
    */
   void
   compress() const;
@@ -1023,9 +1033,12 @@ private:
    *
    * The variable is marked "mutable" so that it can be changed by compress(),
    * though this of course doesn't change anything about the external
-   * representation of this index set.
+   * representation of this index set. It is atomic so that compress() can
+   * check it without acquiring the mutex below. Setting it to true with
+   * release semantics after the compression makes the results of the
+   * compression visible to all threads that see the new value.
    */
-  mutable bool is_compressed;
+  mutable std::atomic<bool> is_compressed;
 
   /**
    * The overall size of the index range. Elements of this index set have to
@@ -1047,6 +1060,7 @@ private:
   /**
    * A mutex that is used to synchronize operations of the do_compress()
    * function that is called from many 'const' functions via compress().
+   * It is only acquired if the set is not yet compressed.
    */
   mutable Threads::Mutex compress_mutex;
 
@@ -1590,9 +1604,37 @@ inline IndexSet::IndexSet(const size_type size)
 
 
 
+inline IndexSet::IndexSet(const IndexSet &is)
+  : is_compressed(true)
+  , index_space_size(is.index_space_size)
+{
+  is.compress();
+  ranges        = is.ranges;
+  largest_range = is.largest_range;
+}
+
+
+
+inline IndexSet &
+IndexSet::operator=(const IndexSet &is)
+{
+  if (this == &is)
+    return *this;
+
+  is.compress();
+  ranges           = is.ranges;
+  is_compressed    = true;
+  index_space_size = is.index_space_size;
+  largest_range    = is.largest_range;
+
+  return *this;
+}
+
+
+
 inline IndexSet::IndexSet(IndexSet &&is) noexcept
   : ranges(std::move(is.ranges))
-  , is_compressed(is.is_compressed)
+  , is_compressed(is.is_compressed.load())
   , index_space_size(is.index_space_size)
   , largest_range(is.largest_range)
 {
@@ -1610,7 +1652,7 @@ inline IndexSet &
 IndexSet::operator=(IndexSet &&is) noexcept
 {
   ranges           = std::move(is.ranges);
-  is_compressed    = is.is_compressed;
+  is_compressed    = is.is_compressed.load();
   index_space_size = is.index_space_size;
   largest_range    = is.largest_range;
 
@@ -1703,7 +1745,7 @@ IndexSet::size() const
 inline void
 IndexSet::compress() const
 {
-  if (is_compressed == true)
+  if (is_compressed.load(std::memory_order_acquire) == true)
     return;
 
   do_compress();
@@ -1740,7 +1782,9 @@ IndexSet::add_range(const size_type begin, const size_type end)
       else
         add_range_lower_bound(Range(begin, end));
 
-      is_compressed = false;
+      // no other thread may access the object while it is modified, so a
+      // relaxed store is sufficient
+      is_compressed.store(false, std::memory_order_relaxed);
     }
 }
 
@@ -1863,13 +1907,6 @@ IndexSet::n_elements() const
       v              = r.nth_index_in_set + r.end - r.begin;
     }
 
-#ifdef DEBUG
-  size_type s = 0;
-  for (const auto &range : ranges)
-    s += (range.end - range.begin);
-  Assert(s == v, ExcInternalError());
-#endif
-
   return v;
 }
 
@@ -2039,7 +2076,11 @@ template <class Archive>
 inline void
 IndexSet::serialize(Archive &ar, const unsigned int)
 {
-  ar &ranges &is_compressed &index_space_size &largest_range;
+  // std::atomic can not be serialized directly, so go through a local
+  // variable
+  bool compressed = is_compressed;
+  ar &ranges &compressed &index_space_size &largest_range;
+  is_compressed = compressed;
 }
 
 DEAL_II_NAMESPACE_CLOSE
@@ -196,6 +196,30 @@ namespace internal
                     const double       time,
                     ArrayView<Number> &values) const;
 
+      /**
+       * Compute the values of a single component at all of the given points.
+       * In contrast to calling do_value() for each point, the thread-local
+       * parser objects are only looked up once and the byte code compiled by
+       * muParser is then evaluated for all points in a row.
+       */
+      void
+      do_value_list(const ArrayView<const Point<dim>> &points,
+                    const double                       time,
+                    const unsigned int                 component,
+                    const ArrayView<Number>           &values) const;
+
+      /**
+       * Compute the values of all components at all of the given points.
+       * There has to be one entry in @p values for each point, each of them
+       * a view to `n_components` elements into which the values of all
+       * components at that point are written.
+       */
+      void
+      do_all_values_list(
+        const ArrayView<const Point<dim>>        &points,
+        const double                              time,
+        const ArrayView<const ArrayView<Number>> &values) const;
+
       /**
        * An array of function expressions (one per component), required to
        * initialize tfp in each thread.
@@ -200,6 +200,26 @@ namespace Functions
     virtual double
     value(const Point<dim> &p, const unsigned int component = 0) const override;
 
+    /**
+     * Set @p values to the values of the specified component of the function
+     * at the @p points. This function forwards to
+     * FunctionParser::value_list(), which evaluates the parsed expression for
+     * all points in a row.
+     */
+    virtual void
+    value_list(const std::vector<Point<dim>> &points,
+               std::vector<double>           &values,
+               const unsigned int             component = 0) const override;
+
+    /**
+     * Set @p values to the values of all components of the function at the
+     * @p points. This function forwards to
+     * FunctionParser::vector_value_list().
+     */
+    virtual void
+    vector_value_list(const std::vector<Point<dim>> &points,
+                      std::vector<Vector<double>>   &values) const override;
+
     /**
      * Set the time to a specific value for time-dependent functions.
      *
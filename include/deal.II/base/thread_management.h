@@ -364,14 +364,16 @@ namespace Threads
 
 
       /**
-       * This function does nothing, because the `std::future` object
-       * does not actually hold a return value. However, if the future
-       * object holds an exception, the set will not happen and this function
-       * instead throws the exception stored in the future object.
+       * The `std::future` object does not actually hold a return value, so
+       * there is nothing to store. However, if the future object holds an
+       * exception, this function throws the exception stored in the future
+       * object.
        */
       inline void
-      set_from(std::future<void> &)
-      {}
+      set_from(std::future<void> &v)
+      {
+        v.get();
+      }
     };
   } // namespace internal
 
@@ -887,16 +889,11 @@ namespace Threads
 #endif
 
             // Wait for the task to finish and then move its
-            // result. (We could have made the set_from() function
-            // that we call here wait for the future to be ready --
-            // which happens implicitly when it calls future.get() --
-            // but that would have required putting an explicit
-            // future.wait() into the implementation of
-            // internal::return_value<void>::set_from(), which is a
-            // bit awkward: that class doesn't actually need to set
-            // anything, and so it looks odd to have the explicit call
-            // to future.wait() in the set_from() function. Avoid the
-            // issue by just explicitly calling future.wait() here.)
+            // result. (The set_from() function that we call here
+            // would also wait for the future to be ready, since it
+            // calls future.get() -- even for tasks without a return
+            // value, where it only does so to re-throw a stored
+            // exception. But being explicit about waiting is clearer.)
             future.wait();
 
             // Acquire the returned object. If the task ended in an
@@ -1393,14 +1393,16 @@ private:
     MGVertexDoFs();
 
     /**
-     * A function that is called to allocate the necessary amount of memory to
-     * store the indices of the DoFs that live on this vertex for the given
-     * (inclusive) range of levels.
+     * Set the (inclusive) range of levels this vertex lives on, and the
+     * position where the indices of the DoFs that live on this vertex are
+     * stored. The memory is not owned by this object but is part of
+     * DoFHandler::mg_vertex_dof_indices, and needs to provide space for
+     * <code>(finest_level-coarsest_level+1)*dofs_per_vertex</code> indices.
      */
     void
-    init(const unsigned int coarsest_level,
-         const unsigned int finest_level,
-         const unsigned int dofs_per_vertex);
+    init(const unsigned int       coarsest_level,
+         const unsigned int       finest_level,
+         types::global_dof_index *storage);
 
     /**
      * Return the coarsest level for which this structure stores data.
@@ -1435,15 +1437,16 @@ private:
     unsigned int finest_level;
 
     /**
-     * A pointer to an array where we store the indices of the DoFs that live
-     * on the various levels this vertex exists on.
+     * A pointer to the array where we store the indices of the DoFs that live
+     * on the various levels this vertex exists on. The array is a part of
+     * DoFHandler::mg_vertex_dof_indices.
      *
      * The starting offset of the DoFs that belong to a @p level are given by
      * <code>n_dofs_per_vertex() * (level-coarsest_level)</code>. @p n_dofs_per_vertex()
      * must therefore be passed as an argument to the functions that set or
      * read an index.
      */
-    std::unique_ptr<types::global_dof_index[]> indices;
+    types::global_dof_index *indices;
   };
 
   /**
@@ -1589,6 +1592,13 @@ private:
    */
   std::vector<MGVertexDoFs> mg_vertex_dofs;
 
+  /**
+   * The storage for the level DoF indices of all vertices, in the order of
+   * the vertices. The objects in #mg_vertex_dofs point into this array, so
+   * that a single allocation holds the level indices of all vertices.
+   */
+  std::vector<types::global_dof_index> mg_vertex_dof_indices;
+
   /**
    * Space to store the DoF numbers for the different multigrid levels.
    */
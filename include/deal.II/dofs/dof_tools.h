@@ -754,6 +754,11 @@ namespace DoFTools
    * all constraints due to differing mesh sizes (h) or polynomial degrees (p)
    * between adjacent cells.
    *
+   * On large meshes and if several threads are available, the cells are
+   * split into chunks whose constraints are computed concurrently into
+   * separate buffers. These are merged in the order of the cells afterwards,
+   * so the result is the same as that of a sequential loop over all cells.
+   *
    * @ingroup constraints
    */
   template <int dim, int spacedim, typename number>
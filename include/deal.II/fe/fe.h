@@ -51,6 +51,8 @@ namespace NonMatching
 }
 template <int dim, int spacedim>
 class FESystem;
+template <int dim, int spacedim, typename VectorizedArrayType>
+class FEValuesVectorized;
 #endif
 
 /**
@@ -3065,6 +3067,8 @@ protected:
   friend class FESubfaceValues<dim, spacedim>;
   friend class NonMatching::FEImmersedSurfaceValues<dim>;
   friend class FESystem<dim, spacedim>;
+  template <int, int, typename>
+  friend class FEValuesVectorized;
 
   // explicitly check for sensible template arguments, but not on windows
   // because MSVC creates bogus warnings during normal compilation
@@ -464,6 +464,14 @@ public:
    * elements, there is another get_function_values() below,
    * returning a vector of vectors of results.
    *
+   * For FEValues objects that use an element of the form FE_Q or FE_DGQ of
+   * degree three or higher and a quadrature formula that is the tensor
+   * product of the same one-dimensional formula in each direction, this
+   * function and get_function_gradients() do not loop over the table of
+   * shape functions, but evaluate the function with sum factorization, at a
+   * cost proportional to $p^{d+1}$ rather than $p^{2d}$ for polynomial degree
+   * $p$ in $d$ space dimensions.
+   *
    * @param[in] fe_function A vector of values that describes (globally) the
    * finite element function that this function should evaluate at the
    * quadrature points of the current cell.
@@ -1757,7 +1765,56 @@ protected:
   check_cell_similarity(
     const typename Triangulation<dim, spacedim>::cell_iterator &cell);
 
+  /**
+   * A structure holding the one-dimensional shape functions and the
+   * lexicographic numbering of the degrees of freedom needed to evaluate
+   * finite element functions with sum factorization.
+   */
+  struct TensorProductData;
+
+  /**
+   * The data for evaluating finite element functions with sum
+   * factorization, or a null pointer if the finite element and the
+   * quadrature formula do not allow for it (or it would not pay off).
+   */
+  std::unique_ptr<const TensorProductData> tensor_product_data;
+
+  /**
+   * Set up the #tensor_product_data field if the finite element is a scalar
+   * element based on TensorProductPolynomials of degree three or higher and
+   * @p quadrature is the tensor product of the same one-dimensional formula
+   * in all coordinate directions. Called from the @p initialize function of
+   * FEValues.
+   */
+  void
+  initialize_tensor_product_evaluation(const Quadrature<dim> &quadrature);
+
 private:
+  /**
+   * If #tensor_product_data is set, compute the values (unless @p values is
+   * empty) and the gradients (unless @p gradients is empty) in the
+   * quadrature points of the finite element function with the local
+   * @p dof_values by sum factorization and return true. Otherwise, return
+   * false and do not touch the output arrays. Only number types @p Number
+   * for which this pays off (namely @p double and @p float) are handled,
+   * false is returned for all others.
+   */
+  template <typename Number, typename ValueNumber, typename GradientNumber>
+  bool
+  maybe_evaluate_by_sum_factorization(
+    const ArrayView<const Number>                        &dof_values,
+    const ArrayView<ValueNumber>                         &values,
+    const ArrayView<Tensor<1, spacedim, GradientNumber>> &gradients) const;
+
+  /**
+   * Worker function for maybe_evaluate_by_sum_factorization().
+   */
+  void
+  evaluate_by_sum_factorization(
+    const ArrayView<const double>        &dof_values,
+    const ArrayView<double>              &values,
+    const ArrayView<Tensor<1, spacedim>> &gradients) const;
+
   /**
    * A cache for all possible FEValuesViews objects.
    */
@@ -2449,6 +2506,49 @@ FEValuesBase<dim, spacedim>::normal_vector(const unsigned int q_point) const
   return this->mapping_output.normal_vectors[q_point];
 }
 
+
+
+template <int dim, int spacedim>
+template <typename Number, typename ValueNumber, typename GradientNumber>
+inline bool
+FEValuesBase<dim, spacedim>::maybe_evaluate_by_sum_factorization(
+  const ArrayView<const Number>                        &dof_values,
+  const ArrayView<ValueNumber>                         &values,
+  const ArrayView<Tensor<1, spacedim, GradientNumber>> &gradients) const
+{
+  if (tensor_product_data == nullptr)
+    return false;
+
+  if constexpr (std::is_same_v<Number, double> &&
+                std::is_same_v<ValueNumber, double> &&
+                std::is_same_v<GradientNumber, double>)
+    {
+      evaluate_by_sum_factorization(dof_values, values, gradients);
+      return true;
+    }
+  else if constexpr ((std::is_same_v<Number, double> ||
+                      std::is_same_v<Number, float>) &&
+                     std::is_floating_point_v<ValueNumber> &&
+                     std::is_floating_point_v<GradientNumber>)
+    {
+      // compute in double precision and convert the results
+      std::vector<double> dof_values_double(dof_values.begin(),
+                                            dof_values.end());
+      std::vector<double> values_double(values.size());
+      std::vector<Tensor<1, spacedim>> gradients_double(gradients.size());
+      evaluate_by_sum_factorization(make_array_view(dof_values_double),
+                                    make_array_view(values_double),
+                                    make_array_view(gradients_double));
+      for (unsigned int q = 0; q < values.size(); ++q)
+        values[q] = values_double[q];
+      for (unsigned int q = 0; q < gradients.size(); ++q)
+        gradients[q] = gradients_double[q];
+      return true;
+    }
+  else
+    return false;
+}
+
 #endif
 
 DEAL_II_NAMESPACE_CLOSE
@@ -0,0 +1,651 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_fe_values_vectorized_h
+#define dealii_fe_values_vectorized_h
+
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/derivative_form.h>
+#include <deal.II/base/exceptions.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/quadrature.h>
+#include <deal.II/base/std_cxx20/iota_view.h>
+#include <deal.II/base/table.h>
+#include <deal.II/base/tensor.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_update_flags.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping.h>
+
+#include <memory>
+#include <vector>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+/**
+ * A class that provides the values of shape functions, their gradients, the
+ * quadrature points and the JxW values on a batch of up to
+ * VectorizedArrayType::size() cells at once, with each lane of a
+ * VectorizedArray corresponding to one cell of the batch. It offers the same
+ * interface as FEValues for these quantities (shape_value(), shape_grad(),
+ * JxW(), quadrature_point()), except that the returned numbers are of type
+ * VectorizedArrayType. This allows to write matrix-based assembly loops in
+ * which the arithmetic in the innermost loops over the degrees of freedom
+ * and quadrature points is vectorized across cells, in the same way as done
+ * by FEEvaluation for matrix-free operator evaluation.
+ *
+ * The data on each cell is computed by an FEValues object, so all elements
+ * and mappings supported by FEValues are supported here. The data is then
+ * transposed into arrays of VectorizedArrayType. If fewer cells than lanes
+ * are passed to reinit(), the remaining lanes contain a copy of the data of
+ * the first cell, except for the JxW values which are set to zero. As a
+ * consequence, integrals computed on unused lanes are zero.
+ *
+ * For elements whose shape functions are defined on the reference cell and
+ * mapped without any transformation of their values, such as FE_Q or
+ * FE_DGQ, the values of the shape functions are the same on all cells and
+ * the gradients only depend on the cell through the inverse Jacobian of the
+ * mapping. For these elements, the values and the reference gradients are
+ * evaluated once in the constructor, and reinit() only transposes the
+ * inverse Jacobians, JxW values, and quadrature points and then computes
+ * the gradients with vectorized arithmetic. The FEValues objects then do
+ * not compute the shape values and gradients themselves.
+ *
+ * A typical assembly loop looks as follows:
+ * @code
+ *   FEValuesVectorized<dim> fe_values(fe, quadrature,
+ *                                     update_gradients | update_JxW_values);
+ *   constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+ *   Table<2, VectorizedArray<double>> cell_matrix(dofs_per_cell,
+ *                                                 dofs_per_cell);
+ *
+ *   std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+ *   for (const auto &cell : dof_handler.active_cell_iterators())
+ *     {
+ *       cells.push_back(cell);
+ *       if (cells.size() < n_lanes && std::next(cell) != dof_handler.end())
+ *         continue;
+ *
+ *       fe_values.reinit(make_array_view(cells));
+ *       for (const unsigned int i : fe_values.dof_indices())
+ *         for (const unsigned int j : fe_values.dof_indices())
+ *           {
+ *             VectorizedArray<double> sum = 0.;
+ *             for (const unsigned int q :
+ *                  fe_values.quadrature_point_indices())
+ *               sum += fe_values.shape_grad(i, q) *
+ *                      fe_values.shape_grad(j, q) * fe_values.JxW(q);
+ *             cell_matrix(i, j) = sum;
+ *           }
+ *
+ *       // copy lane 'v' of 'cell_matrix' into a FullMatrix and
+ *       // distribute it to the global matrix for each of the cells
+ *       for (unsigned int v = 0; v < cells.size(); ++v)
+ *         ...
+ *       cells.clear();
+ *     }
+ * @endcode
+ *
+ * @ingroup feaccess
+ */
+template <int dim,
+          int spacedim                 = dim,
+          typename VectorizedArrayType = VectorizedArray<double>>
+class FEValuesVectorized
+{
+public:
+  /**
+   * The number of cells processed at once.
+   */
+  static constexpr unsigned int n_lanes = VectorizedArrayType::size();
+
+  /**
+   * Constructor. Create one FEValues object for each lane with the given
+   * arguments. Only the flags update_values, update_gradients,
+   * update_quadrature_points, and update_JxW_values are represented in the
+   * vectorized arrays, but any other flags are passed on to the FEValues
+   * objects accessible through get_fe_values(). If the shape functions of
+   * @p fe do not depend on the cell other than through the inverse Jacobian
+   * (see the class documentation), update_values and update_gradients are
+   * replaced by update_inverse_jacobians for the FEValues objects.
+   */
+  FEValuesVectorized(const Mapping<dim, spacedim>       &mapping,
+                     const FiniteElement<dim, spacedim> &fe,
+                     const Quadrature<dim>              &quadrature,
+                     const UpdateFlags                   update_flags);
+
+  /**
+   * Constructor. Like the previous one, but use the default linear mapping
+   * of the reference cell of @p fe.
+   */
+  FEValuesVectorized(const FiniteElement<dim, spacedim> &fe,
+                     const Quadrature<dim>              &quadrature,
+                     const UpdateFlags                   update_flags);
+
+  /**
+   * Reinitialize the data for the given batch of cells. The number of cells
+   * must be at least one and at most #n_lanes. The cell with index @p v in
+   * @p cells corresponds to lane @p v of the vectorized data.
+   */
+  template <typename CellIteratorType>
+  void
+  reinit(const ArrayView<const CellIteratorType> &cells);
+
+  /**
+   * Same as above, for a batch of cells stored in a non-const array.
+   */
+  template <typename CellIteratorType>
+  void
+  reinit(const ArrayView<CellIteratorType> &cells);
+
+  /**
+   * Return the number of cells passed to the last call of reinit(), i.e.,
+   * the number of lanes that hold valid data.
+   */
+  unsigned int
+  n_active_lanes() const;
+
+  /**
+   * Return the FEValues object that computed the data of lane @p lane. It
+   * gives access to all data computed on the corresponding cell, including
+   * the data that is not represented in vectorized form, but possibly
+   * without the shape values and gradients (see the constructor).
+   */
+  const FEValues<dim, spacedim> &
+  get_fe_values(const unsigned int lane) const;
+
+  /**
+   * Return the value of the @p i-th shape function at the @p q-th quadrature
+   * point on all cells of the batch. See FEValuesBase::shape_value().
+   */
+  const VectorizedArrayType &
+  shape_value(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the gradient of the @p i-th shape function at the @p q-th
+   * quadrature point on all cells of the batch. See
+   * FEValuesBase::shape_grad().
+   */
+  const Tensor<1, spacedim, VectorizedArrayType> &
+  shape_grad(const unsigned int i, const unsigned int q) const;
+
+  /**
+   * Return the mapped quadrature weight of the @p q-th quadrature point on
+   * all cells of the batch. The value is zero on unused lanes.
+   */
+  const VectorizedArrayType &
+  JxW(const unsigned int q) const;
+
+  /**
+   * Return the location of the @p q-th quadrature point in real space on all
+   * cells of the batch.
+   */
+  const Point<spacedim, VectorizedArrayType> &
+  quadrature_point(const unsigned int q) const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `dofs_per_cell`, see FEValuesBase::dof_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  dof_indices() const;
+
+  /**
+   * Return an object that can be thought of as an array containing all
+   * indices from zero to `n_quadrature_points`, see
+   * FEValuesBase::quadrature_point_indices().
+   */
+  std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+  quadrature_point_indices() const;
+
+  /**
+   * Return the finite element in use.
+   */
+  const FiniteElement<dim, spacedim> &
+  get_fe() const;
+
+  /**
+   * Return the update flags set for this object.
+   */
+  UpdateFlags
+  get_update_flags() const;
+
+  /**
+   * Number of shape functions per cell.
+   */
+  const unsigned int dofs_per_cell;
+
+  /**
+   * Number of quadrature points.
+   */
+  const unsigned int n_quadrature_points;
+
+private:
+  /**
+   * Return whether the values of the shape functions of @p fe are the same
+   * on all cells and their gradients only depend on the cell through the
+   * inverse Jacobian of the mapping.
+   */
+  static bool
+  has_cell_independent_shape_data(const FiniteElement<dim, spacedim> &fe);
+
+  /**
+   * Copy the data of the FEValues objects into the vectorized arrays.
+   */
+  void
+  transpose_data();
+
+  /**
+   * Whether the shape values and gradients are computed from the data
+   * evaluated in the constructor, see has_cell_independent_shape_data().
+   */
+  const bool shape_data_is_constant;
+
+  /**
+   * One FEValues object per lane.
+   */
+  std::vector<std::unique_ptr<FEValues<dim, spacedim>>> fe_values;
+
+  /**
+   * The update flags represented by this object, i.e., the flags of the
+   * FEValues objects plus the ones computed from constant shape data.
+   */
+  UpdateFlags update_flags;
+
+  /**
+   * The number of cells passed to the last call of reinit().
+   */
+  unsigned int n_filled_lanes;
+
+  /**
+   * Shape function values, indexed by shape function and quadrature point.
+   */
+  Table<2, VectorizedArrayType> shape_values;
+
+  /**
+   * Shape function gradients, indexed by shape function and quadrature
+   * point.
+   */
+  Table<2, Tensor<1, spacedim, VectorizedArrayType>> shape_gradients;
+
+  /**
+   * Gradients of the shape functions on the reference cell, indexed by
+   * shape function and quadrature point. Only used if
+   * #shape_data_is_constant is set. They are stored as scalars since they
+   * are the same for all lanes.
+   */
+  Table<2, Tensor<1, dim, typename VectorizedArrayType::value_type>>
+    reference_gradients;
+
+  /**
+   * JxW values in the quadrature points.
+   */
+  AlignedVector<VectorizedArrayType> JxW_values;
+
+  /**
+   * Quadrature points in real space.
+   */
+  std::vector<Point<spacedim, VectorizedArrayType>> quadrature_points;
+};
+
+
+
+/*---------------------- Inline functions -----------------------------------*/
+
+#ifndef DOXYGEN
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::FEValuesVectorized(
+  const Mapping<dim, spacedim>       &mapping,
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim>              &quadrature,
+  const UpdateFlags                   update_flags)
+  : dofs_per_cell(fe.n_dofs_per_cell())
+  , n_quadrature_points(quadrature.size())
+  , shape_data_is_constant(has_cell_independent_shape_data(fe))
+  , n_filled_lanes(0)
+{
+  // if the shape data is the same on all cells, let the FEValues objects
+  // only compute the inverse Jacobians needed to map the gradients
+  const UpdateFlags shape_flags     = update_values | update_gradients;
+  UpdateFlags       fe_values_flags = update_flags;
+  if (shape_data_is_constant)
+    {
+      fe_values_flags = static_cast<UpdateFlags>(update_flags & ~shape_flags);
+      if (update_flags & update_gradients)
+        fe_values_flags |= update_inverse_jacobians;
+    }
+
+  for (unsigned int v = 0; v < n_lanes; ++v)
+    fe_values.push_back(std::make_unique<FEValues<dim, spacedim>>(
+      mapping, fe, quadrature, fe_values_flags));
+
+  this->update_flags = fe_values[0]->get_update_flags();
+  if (shape_data_is_constant)
+    this->update_flags |= (update_flags & shape_flags);
+
+  // size the vectorized arrays once here, so that reinit() only overwrites
+  // their content
+  const UpdateFlags flags = get_update_flags();
+  if (flags & update_values)
+    shape_values.reinit(dofs_per_cell, n_quadrature_points);
+  if (flags & update_gradients)
+    shape_gradients.reinit(dofs_per_cell, n_quadrature_points);
+  if (flags & update_JxW_values)
+    JxW_values.resize(n_quadrature_points);
+  if (flags & update_quadrature_points)
+    quadrature_points.resize(n_quadrature_points);
+
+  // broadcast the shape values to all lanes and store the reference
+  // gradients, both of which reinit() does not need to touch anymore
+  if (shape_data_is_constant)
+    {
+      if (flags & update_gradients)
+        reference_gradients.reinit(dofs_per_cell, n_quadrature_points);
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          {
+            if (flags & update_values)
+              shape_values(i, q) = fe.shape_value(i, quadrature.point(q));
+            if (flags & update_gradients)
+              reference_gradients(i, q) =
+                fe.shape_grad(i, quadrature.point(q));
+          }
+    }
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::FEValuesVectorized(
+  const FiniteElement<dim, spacedim> &fe,
+  const Quadrature<dim>              &quadrature,
+  const UpdateFlags                   update_flags)
+  : FEValuesVectorized(
+      fe.reference_cell().template get_default_linear_mapping<dim, spacedim>(),
+      fe,
+      quadrature,
+      update_flags)
+{}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+template <typename CellIteratorType>
+inline void
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::reinit(
+  const ArrayView<const CellIteratorType> &cells)
+{
+  Assert(cells.size() > 0 && cells.size() <= n_lanes,
+         ExcIndexRange(cells.size(), 1, n_lanes + 1));
+
+  n_filled_lanes = cells.size();
+  for (unsigned int v = 0; v < n_filled_lanes; ++v)
+    fe_values[v]->reinit(cells[v]);
+
+  transpose_data();
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+template <typename CellIteratorType>
+inline void
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::reinit(
+  const ArrayView<CellIteratorType> &cells)
+{
+  reinit(ArrayView<const CellIteratorType>(cells.data(), cells.size()));
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline bool
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::
+  has_cell_independent_shape_data(const FiniteElement<dim, spacedim> &fe)
+{
+  // elements that transform their values (e.g., with a Piola transform) or
+  // evaluate them in real space need more information from the mapping than
+  // the covariant transformation of the gradients
+  return fe.is_primitive() &&
+         fe.requires_update_flags(update_values | update_gradients) ==
+           (update_values | update_gradients |
+            update_covariant_transformation);
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline void
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::transpose_data()
+{
+  const UpdateFlags flags = get_update_flags();
+
+  // unused lanes get the data of the first cell, except for the JxW values
+  // which are zero there
+  const auto lane = [this](const unsigned int v) {
+    return (v < n_filled_lanes ? v : 0);
+  };
+
+  if ((flags & update_values) && !shape_data_is_constant)
+    {
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            shape_values(i, q)[v] = fe_values[lane(v)]->shape_value(i, q);
+    }
+
+  if ((flags & update_gradients) && shape_data_is_constant)
+    {
+      // only transpose the inverse Jacobians and apply them to the
+      // reference gradients, which is what FEValues does on each cell
+      DerivativeForm<1, spacedim, dim, VectorizedArrayType> inverse_jacobian;
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        {
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const DerivativeForm<1, spacedim, dim> &jacobian =
+                fe_values[lane(v)]->inverse_jacobian(q);
+              for (unsigned int e = 0; e < dim; ++e)
+                for (unsigned int d = 0; d < spacedim; ++d)
+                  inverse_jacobian[e][d][v] = jacobian[e][d];
+            }
+
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              const auto &reference_gradient = reference_gradients(i, q);
+              Tensor<1, spacedim, VectorizedArrayType> &gradient =
+                shape_gradients(i, q);
+              for (unsigned int d = 0; d < spacedim; ++d)
+                {
+                  gradient[d] = inverse_jacobian[0][d] * reference_gradient[0];
+                  for (unsigned int e = 1; e < dim; ++e)
+                    gradient[d] +=
+                      inverse_jacobian[e][d] * reference_gradient[e];
+                }
+            }
+        }
+    }
+  else if (flags & update_gradients)
+    {
+      for (unsigned int i = 0; i < dofs_per_cell; ++i)
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            {
+              const Tensor<1, spacedim> &gradient =
+                fe_values[lane(v)]->shape_grad(i, q);
+              for (unsigned int d = 0; d < spacedim; ++d)
+                shape_gradients(i, q)[d][v] = gradient[d];
+            }
+    }
+
+  if (flags & update_JxW_values)
+    {
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        {
+          JxW_values[q] = 0.;
+          for (unsigned int v = 0; v < n_filled_lanes; ++v)
+            JxW_values[q][v] = fe_values[v]->JxW(q);
+        }
+    }
+
+  if (flags & update_quadrature_points)
+    {
+      for (unsigned int q = 0; q < n_quadrature_points; ++q)
+        for (unsigned int v = 0; v < n_lanes; ++v)
+          {
+            const Point<spacedim> &point =
+              fe_values[lane(v)]->quadrature_point(q);
+            for (unsigned int d = 0; d < spacedim; ++d)
+              quadrature_points[q][d][v] = point[d];
+          }
+    }
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline unsigned int
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::n_active_lanes() const
+{
+  return n_filled_lanes;
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const FEValues<dim, spacedim> &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::get_fe_values(
+  const unsigned int lane) const
+{
+  AssertIndexRange(lane, n_filled_lanes);
+  return *fe_values[lane];
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const VectorizedArrayType &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::shape_value(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Assert(get_update_flags() & update_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_values")));
+  Assert(n_filled_lanes > 0,
+         (typename FEValuesBase<dim, spacedim>::ExcNotReinited()));
+  return shape_values(i, q);
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const Tensor<1, spacedim, VectorizedArrayType> &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::shape_grad(
+  const unsigned int i,
+  const unsigned int q) const
+{
+  Assert(get_update_flags() & update_gradients,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_gradients")));
+  Assert(n_filled_lanes > 0,
+         (typename FEValuesBase<dim, spacedim>::ExcNotReinited()));
+  return shape_gradients(i, q);
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const VectorizedArrayType &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::JxW(
+  const unsigned int q) const
+{
+  Assert(get_update_flags() & update_JxW_values,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_JxW_values")));
+  Assert(n_filled_lanes > 0,
+         (typename FEValuesBase<dim, spacedim>::ExcNotReinited()));
+  AssertIndexRange(q, n_quadrature_points);
+  return JxW_values[q];
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const Point<spacedim, VectorizedArrayType> &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::quadrature_point(
+  const unsigned int q) const
+{
+  Assert(get_update_flags() & update_quadrature_points,
+         (typename FEValuesBase<dim, spacedim>::ExcAccessToUninitializedField(
+           "update_quadrature_points")));
+  Assert(n_filled_lanes > 0,
+         (typename FEValuesBase<dim, spacedim>::ExcNotReinited()));
+  AssertIndexRange(q, n_quadrature_points);
+  return quadrature_points[q];
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::dof_indices() const
+{
+  return {0U, dofs_per_cell};
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline std_cxx20::ranges::iota_view<unsigned int, unsigned int>
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::
+  quadrature_point_indices() const
+{
+  return {0U, n_quadrature_points};
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline const FiniteElement<dim, spacedim> &
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::get_fe() const
+{
+  return fe_values[0]->get_fe();
+}
+
+
+
+template <int dim, int spacedim, typename VectorizedArrayType>
+inline UpdateFlags
+FEValuesVectorized<dim, spacedim, VectorizedArrayType>::get_update_flags()
+  const
+{
+  return update_flags;
+}
+
+#endif // DOXYGEN
+
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
@@ -450,6 +450,21 @@ public:
      */
     mutable AlignedVector<double> volume_elements;
 
+    /**
+     * Whether the mapping is affine on the cell last passed to
+     * fill_fe_values(), i.e., whether the Jacobian is the same in all
+     * points of the cell. In that case, fill_fe_values() and transform()
+     * use the single matrix #affine_jacobian rather than evaluating the
+     * mapping in each quadrature point. Always false after a call to one of
+     * the functions computing data on faces.
+     */
+    mutable bool is_affine;
+
+    /**
+     * The Jacobian of the mapping if #is_affine is true.
+     */
+    mutable DerivativeForm<1, dim, spacedim> affine_jacobian;
+
     /**
      * Pointer to the mapping output data that holds most of the arrays,
      * including the Jacobians representing the covariant and contravariant
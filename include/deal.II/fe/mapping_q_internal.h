@@ -1234,6 +1234,132 @@ namespace internal
 
 
 
+    /**
+     * Check whether the mapping described by the support points stored in
+     * @p data is affine on the current cell, i.e., whether all support points
+     * coincide with the images of their @p unit_support_points under the
+     * affine map defined by vertex zero and its neighbors along the
+     * coordinate directions, up to a tolerance relative to the size of the
+     * cell. If so, store the Jacobian of this map in
+     * InternalData::affine_jacobian. The result is stored in
+     * InternalData::is_affine and returned.
+     */
+    template <int dim, int spacedim>
+    inline bool
+    compute_affine_jacobian(
+      const typename dealii::MappingQ<dim, spacedim>::InternalData &data,
+      const std::vector<Point<dim>> &unit_support_points)
+    {
+      const std::vector<Point<spacedim>> &support_points =
+        data.mapping_support_points;
+      AssertDimension(support_points.size(), unit_support_points.size());
+
+      // the columns of the Jacobian are spanned by the vertices next to
+      // vertex zero, which come first in the hierarchic numbering
+      DerivativeForm<1, dim, spacedim> &jacobian  = data.affine_jacobian;
+      double                            cell_size = 0;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          const Tensor<1, spacedim> column =
+            support_points[1U << d] - support_points[0];
+          for (unsigned int e = 0; e < spacedim; ++e)
+            jacobian[e][d] = column[e];
+          cell_size += column.norm();
+        }
+      const double tolerance = 1e-12 * cell_size;
+
+      // then check that all other support points are images of their unit
+      // points under this map
+      data.is_affine = true;
+      for (unsigned int i = 1; i < support_points.size(); ++i)
+        if ((support_points[0] +
+             apply_transformation(jacobian, unit_support_points[i]))
+              .distance_square(support_points[i]) > tolerance * tolerance)
+          {
+            data.is_affine = false;
+            break;
+          }
+
+      return data.is_affine;
+    }
+
+
+
+    /**
+     * On cells where the mapping is affine, this is a replacement for
+     * maybe_update_q_points_Jacobians_and_grads_tensor() and for the
+     * combination of maybe_update_q_points_Jacobians_generic() and
+     * maybe_update_jacobian_grads(): The Jacobian is the same in all
+     * quadrature points, so we only compute its determinant and inverse once
+     * and copy them to all points, and we compute the location of the
+     * quadrature points directly from the affine map.
+     */
+    template <int dim, int spacedim>
+    inline void
+    maybe_update_q_points_Jacobians_and_grads_affine(
+      const CellSimilarity::Similarity cell_similarity,
+      const typename dealii::MappingQ<dim, spacedim>::InternalData &data,
+      const ArrayView<const Point<dim>>             &unit_points,
+      std::vector<Point<spacedim>>                  &quadrature_points,
+      std::vector<DerivativeForm<1, dim, spacedim>> &jacobians,
+      std::vector<DerivativeForm<1, spacedim, dim>> &inverse_jacobians,
+      std::vector<DerivativeForm<2, dim, spacedim>> &jacobian_grads)
+    {
+      Assert(data.is_affine, ExcInternalError());
+
+      const UpdateFlags  update_flags = data.update_each;
+      const unsigned int n_q_points   = unit_points.size();
+
+      const DerivativeForm<1, dim, spacedim> &jacobian = data.affine_jacobian;
+
+      if (update_flags & update_quadrature_points)
+        {
+          AssertDimension(quadrature_points.size(), n_q_points);
+          const Point<spacedim> &origin = data.mapping_support_points[0];
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            quadrature_points[point] =
+              origin + apply_transformation(jacobian, unit_points[point]);
+        }
+
+      if (cell_similarity == CellSimilarity::translation)
+        return;
+
+      // Since MappingQ::InternalData does not have separate arrays for the
+      // covariant and contravariant transformations, but uses the arrays in
+      // the `MappingRelatedData`, it can happen that vectors do not have the
+      // right size
+      if (update_flags & update_contravariant_transformation)
+        {
+          jacobians.resize(n_q_points);
+          std::fill(jacobians.begin(), jacobians.end(), jacobian);
+        }
+
+      if (update_flags & update_volume_elements)
+        {
+          const double determinant = jacobian.determinant();
+          for (unsigned int point = 0; point < n_q_points; ++point)
+            data.volume_elements[point] = determinant;
+        }
+
+      if (update_flags & update_covariant_transformation)
+        {
+          inverse_jacobians.resize(n_q_points);
+          std::fill(inverse_jacobians.begin(),
+                    inverse_jacobians.end(),
+                    jacobian.covariant_form().transpose());
+        }
+
+      if (update_flags & update_jacobian_grads)
+        {
+          AssertDimension(jacobian_grads.size(), n_q_points);
+          std::fill(jacobian_grads.begin(),
+                    jacobian_grads.end(),
+                    DerivativeForm<2, dim, spacedim>());
+        }
+    }
+
+
+
     template <int dim, int spacedim>
     inline DEAL_II_ALWAYS_INLINE void
     store_vectorized_tensor(
@@ -2197,6 +2323,15 @@ namespace internal
                      typename FEValuesBase<dim>::ExcAccessToUninitializedField(
                        "update_contravariant_transformation"));
 
+              if (data.is_affine && output.size() > 0)
+                {
+                  const DerivativeForm<1, dim, spacedim> contravariant =
+                    data.output_data->jacobians[0];
+                  for (unsigned int i = 0; i < output.size(); ++i)
+                    output[i] = apply_transformation(contravariant, input[i]);
+                  return;
+                }
+
               for (unsigned int i = 0; i < output.size(); ++i)
                 output[i] = apply_transformation(data.output_data->jacobians[i],
                                                  input[i]);
@@ -2234,6 +2369,16 @@ namespace internal
                      typename FEValuesBase<dim>::ExcAccessToUninitializedField(
                        "update_covariant_transformation"));
 
+              // on affine cells, apply the same matrix to all inputs
+              if (data.is_affine && output.size() > 0)
+                {
+                  const DerivativeForm<1, dim, spacedim> covariant =
+                    data.output_data->inverse_jacobians[0].transpose();
+                  for (unsigned int i = 0; i < output.size(); ++i)
+                    output[i] = apply_transformation(covariant, input[i]);
+                  return;
+                }
+
               for (unsigned int i = 0; i < output.size(); ++i)
                 output[i] = apply_transformation(
                   data.output_data->inverse_jacobians[i].transpose(), input[i]);
@@ -155,7 +155,9 @@ struct CellData;
  *
  * <li> <tt>%Gmsh 2.0 mesh</tt> format: this is a variant of the above format.
  * The read_msh() function automatically determines whether an input file is
- * version 1 or version 2.
+ * version 1 or version 2. Later versions up to 4.1 are read as well; for
+ * version 4.1, both the ASCII and the (considerably faster to read) binary
+ * variant of the format are supported.
  *
  * <li> <tt>Tecplot</tt> format: this format is used by @p TECPLOT and often
  * serves as a basis for data exchange between different applications. Note,
@@ -518,6 +520,12 @@ public:
    * Read grid data from an msh file. The %Gmsh formats are documented at
    * http://www.gmsh.info/.
    *
+   * Files in the binary variant of the 4.1 format (written by %Gmsh with the
+   * option "Mesh.Binary = 1") can be read as well, provided they were written
+   * on a machine with the same byte order. In that case, the stream @p in
+   * needs to be opened in binary mode, i.e., with the flag
+   * <code>std::ios::binary</code>.
+   *
    * Also see
    * @ref simplex "Simplex support".
    */
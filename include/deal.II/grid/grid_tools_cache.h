@@ -35,6 +35,8 @@
 #include <boost/signals2.hpp>
 
 #include <cmath>
+#include <set>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -51,8 +53,14 @@ namespace GridTools
    * for faster access whenever the triangulation has not changed.
    *
    * Notice that this class only notices if the underlying Triangulation has
-   * changed due to a Triangulation::Signals::any_change() signal being
-   * triggered.
+   * changed due to one of the signals that make up
+   * Triangulation::Signals::any_change() being triggered. If the
+   * triangulation is refined or coarsened, the RTree of the cell bounding
+   * boxes returned by get_cell_bounding_boxes_rtree() is not recomputed from
+   * scratch but updated with the cells that have changed, using the
+   * Triangulation::Signals::pre_coarsening_on_cell() and
+   * Triangulation::Signals::post_refinement_on_cell() signals; all other
+   * data structures are recomputed.
    *
    * If the triangulation changes for other reasons, for example because you
    * use it in conjunction with a MappingQEulerian object that sees the
@@ -137,6 +145,10 @@ namespace GridTools
      * using the active cell iterators of the stored triangulation. For
      * parallel::distributed::Triangulation objects, this function will return
      * also the bounding boxes of ghost and artificial cells.
+     *
+     * After refinement and coarsening of the triangulation, the existing tree
+     * is updated by removing the cells that are no longer active and inserting
+     * the bounding boxes of the new active cells, rather than being rebuilt.
      */
     const RTree<
       std::pair<BoundingBox<spacedim>,
@@ -220,6 +232,15 @@ namespace GridTools
     get_covering_rtree(const unsigned int level = 0) const;
 
   private:
+    /**
+     * Remove the entry of @p cell from cell_bounding_boxes_rtree, or from the
+     * list of cells still to be inserted into it. If the entry cannot be
+     * found, the tree is marked for a complete update.
+     */
+    void
+    remove_from_cell_bounding_boxes_rtree(
+      const typename Triangulation<dim, spacedim>::cell_iterator &cell);
+
     /**
      * Keep track of what needs to be updated next.
      */
@@ -283,6 +304,16 @@ namespace GridTools
                 typename Triangulation<dim, spacedim>::active_cell_iterator>>
       cell_bounding_boxes_rtree;
 
+    /**
+     * Active cells created by refinement or coarsening since
+     * cell_bounding_boxes_rtree was last computed, whose bounding boxes still
+     * need to be inserted into the tree. The insertion is delayed to the next
+     * call of get_cell_bounding_boxes_rtree(), because the mapping might not
+     * be usable while the triangulation is being changed.
+     */
+    mutable std::set<typename Triangulation<dim, spacedim>::cell_iterator>
+      cells_to_add_to_bounding_boxes_rtree;
+
     /**
      * Store an RTree object, containing the bounding boxes of the locally owned
      * cells of the triangulation.
@@ -307,9 +338,9 @@ namespace GridTools
       vertices_with_ghost_neighbors;
 
     /**
-     * Storage for the status of the triangulation signal.
+     * Storage for the status of the triangulation signals.
      */
-    boost::signals2::connection tria_signal;
+    std::vector<boost::signals2::connection> tria_signals;
   };
 
 
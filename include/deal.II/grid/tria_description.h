@@ -650,6 +650,112 @@ namespace TriangulationDescription
       const TriangulationDescription::Settings setting =
         TriangulationDescription::Settings::default_setting);
 
+    /**
+     * Construct the TriangulationDescription::Description objects of all
+     * @p n_partitions partitions of the serial triangulation @p tria, which
+     * has been colored by functions like
+     * GridTools::partition_triangulation(), and write them to files that can
+     * be read by parallel::fullydistributed::Triangulation::load(). The file
+     * contains one packed Description per partition together with an index of
+     * their sizes, so that each process only reads its own locally relevant
+     * cells when loading the triangulation.
+     *
+     * This function is meant to be run once, in serial, to prepare the input
+     * of large parallel simulations: in contrast to
+     * create_description_from_triangulation_in_groups(), no process of the
+     * parallel run then needs to hold the whole triangulation in memory.
+     * The Description objects are created one at a time, so that the memory
+     * consumption of this function is that of the serial triangulation plus
+     * the one of a single partition.
+     *
+     * @code
+     * // once, in a serial preprocessing step
+     * Triangulation<dim, spacedim> tria_base;
+     * GridIn<dim, spacedim> grid_in;
+     * grid_in.attach_triangulation(tria_base);
+     * grid_in.read(file_name);
+     * GridTools::partition_triangulation(n_ranks, tria_base);
+     *
+     * TriangulationDescription::Utilities::save_description_from_triangulation(
+     *   tria_base, n_ranks, "mesh");
+     *
+     * // in the simulation, run on n_ranks processes
+     * parallel::fullydistributed::Triangulation<dim, spacedim> tria_pft(comm);
+     * tria_pft.load("mesh");
+     * @endcode
+     *
+     * @param tria Partitioned serial input triangulation.
+     * @param n_partitions Number of partitions, i.e., the number of MPI
+     *   processes the triangulation is going to be loaded on.
+     * @param filename Base name of the files written, to be passed to
+     *   parallel::fullydistributed::Triangulation::load().
+     * @param settings See the description of the Settings enumerator.
+     *
+     * @note If construct_multigrid_hierarchy is set in the settings, the source
+     *   triangulation has to be set up with limit_level_difference_at_vertices
+     *   and its levels need to be partitioned, e.g., by
+     *   GridTools::partition_multigrid_levels().
+     */
+    template <int dim, int spacedim>
+    void
+    save_description_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const unsigned int                          n_partitions,
+      const std::string                          &filename,
+      const TriangulationDescription::Settings    settings =
+        TriangulationDescription::Settings::default_setting);
+
+    /**
+     * Construct the TriangulationDescription::Description of the calling
+     * process for the mesh GridGenerator::subdivided_hyper_rectangle() would
+     * create with the same arguments, without ever creating that mesh as a
+     * whole.
+     *
+     * The coarse cells are enumerated lexicographically (with the
+     * x-coordinate running fastest), which is also the numbering of the
+     * serial function, and are partitioned into contiguous ranges of equal
+     * size in this enumeration: the process with rank $r$ out of $P$ owns
+     * the cells with ids in $[rN/P, (r+1)N/P)$, where $N$ is the total number
+     * of cells. Each process only computes the vertices and cells that are
+     * owned by it or are part of its ghost layer, i.e., that share a vertex
+     * with an owned cell, so that the time and memory needed to set up the
+     * triangulation only scales with the size of the local part of the mesh.
+     * Since all cells are created in the standard orientation, there is no
+     * need to reorder their vertices as GridTools::consistently_order_cells()
+     * does for unstructured input.
+     *
+     * This function is meant for setting up very large structured meshes on
+     * a parallel::fullydistributed::Triangulation:
+     * @code
+     * const auto description = TriangulationDescription::Utilities::
+     *   create_description_from_subdivided_hyper_rectangle<dim>(
+     *     repetitions, p1, p2, comm);
+     *
+     * parallel::fullydistributed::Triangulation<dim> tria(comm);
+     * tria.create_triangulation(description);
+     * @endcode
+     *
+     * @param repetitions Number of cells in each coordinate direction.
+     * @param p1 One corner of the rectangle.
+     * @param p2 The diagonally opposite corner of the rectangle.
+     * @param comm MPI communicator of the triangulation to be created.
+     * @param colorize Assign boundary and material ids in the same way as
+     *   GridGenerator::subdivided_hyper_rectangle().
+     * @param settings See the description of the Settings enumerator. Since
+     *   the mesh only consists of the coarse level, the multigrid hierarchy
+     *   is trivial.
+     */
+    template <int dim, int spacedim = dim>
+    Description<dim, spacedim>
+    create_description_from_subdivided_hyper_rectangle(
+      const std::vector<unsigned int>         &repetitions,
+      const Point<dim>                        &p1,
+      const Point<dim>                        &p2,
+      const MPI_Comm                           comm,
+      const bool                               colorize = false,
+      const TriangulationDescription::Settings settings =
+        TriangulationDescription::Settings::default_setting);
+
   } // namespace Utilities
 
 
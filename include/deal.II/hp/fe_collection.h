@@ -24,7 +24,13 @@
 
 #include <deal.II/hp/collection.h>
 
+#include <map>
 #include <memory>
+#include <set>
+#include <shared_mutex>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -358,6 +364,32 @@ namespace hp
     hp_quad_dof_identities(const std::set<unsigned int> &fes,
                            const unsigned int            face_no = 0) const;
 
+    /**
+     * Return the identities between the degrees of freedom of the two
+     * elements with indices @p fe_index_1 and @p fe_index_2 on objects of
+     * dimension @p structdim (i.e., zero for vertices, one for lines, and two
+     * for quads). Each entry of the returned vector is a pair
+     * `(dof_index_1, dof_index_2)` denoting that the `dof_index_1`th degree
+     * of freedom of the first element on such an object is identical to the
+     * `dof_index_2`th degree of freedom of the second one. The @p face_no
+     * argument is only considered for quads, see hp_quad_dof_identities().
+     *
+     * The result is the same as the one of hp_vertex_dof_identities(),
+     * hp_line_dof_identities(), or hp_quad_dof_identities() called for the
+     * set `{fe_index_1, fe_index_2}`. However, it is only computed the first
+     * time it is requested for a given pair of elements and is then stored
+     * in a table that is shared by all copies of this object until one of
+     * them is modified by push_back(). This makes the function cheap to call
+     * for every vertex, line, and quad of a mesh, as done in
+     * DoFHandler::distribute_dofs(). The function can be called concurrently
+     * from several threads.
+     */
+    const std::vector<std::pair<unsigned int, unsigned int>> &
+    hp_object_dof_identities(const unsigned int structdim,
+                             const unsigned int fe_index_1,
+                             const unsigned int fe_index_2,
+                             const unsigned int face_no = 0) const;
+
 
     /**
      * Return the indices of finite elements in this FECollection that dominate
@@ -440,6 +472,10 @@ namespace hp
      * The @p codim parameter describes the codimension of the investigated
      * subspace and specifies that it is subject to this comparison. See
      * FiniteElement::compare_for_domination() for more information.
+     *
+     * The result for each combination of @p fes and @p codim is only
+     * computed once and then stored in a table that is shared by all copies
+     * of this object until one of them is modified by push_back().
      */
     unsigned int
     find_dominating_fe(const std::set<unsigned int> &fes,
@@ -503,6 +539,9 @@ namespace hp
      * The @p codim parameter describes the codimension of the investigated
      * subspace and specifies that it is subject to this comparison. See
      * FiniteElement::compare_for_domination() for more information.
+     *
+     * Like for find_dominating_fe(), the result is only computed once for
+     * each combination of @p fes and @p codim.
      */
     unsigned int
     find_dominating_fe_extended(const std::set<unsigned int> &fes,
@@ -855,6 +894,55 @@ namespace hp
     std::shared_ptr<MappingCollection<dim, spacedim>>
       reference_cell_default_linear_mapping;
 
+    /**
+     * A structure that stores the results of queries whose answer only
+     * depends on the elements of this collection, namely the pairwise DoF
+     * identities returned by hp_object_dof_identities() and the dominating
+     * elements returned by find_dominating_fe() and
+     * find_dominating_fe_extended(). The tables are filled lazily and are
+     * protected by a reader-writer lock since they are queried from const
+     * member functions that may run concurrently: Lookups, which are by far
+     * the most frequent operation, only take a shared lock so that the
+     * threads of a parallel loop do not wait for each other, whereas
+     * inserting a newly computed result takes an exclusive lock.
+     */
+    struct QueryCache
+    {
+      /**
+       * Reader-writer lock guarding the tables below.
+       */
+      std::shared_mutex mutex;
+
+      /**
+       * DoF identities, indexed by the tuple `(structdim, fe_index_1,
+       * fe_index_2, face_no)`.
+       */
+      std::map<
+        std::tuple<unsigned int, unsigned int, unsigned int, unsigned int>,
+        std::vector<std::pair<unsigned int, unsigned int>>>
+        dof_identities;
+
+      /**
+       * Results of find_dominating_fe() (with the first entry of the key
+       * being `false`) and find_dominating_fe_extended() (with the first
+       * entry being `true`), indexed additionally by the set of elements and
+       * the codimension. The comparator is transparent so that lookups can
+       * use a key that only references the set of elements instead of
+       * copying it.
+       */
+      std::map<std::tuple<bool, std::set<unsigned int>, unsigned int>,
+               unsigned int,
+               std::less<>>
+        dominating_fes;
+    };
+
+    /**
+     * The query cache of this object. Since the cached results only depend
+     * on the elements of the collection, copies of an FECollection share
+     * the same object. push_back() creates a new one.
+     */
+    std::shared_ptr<QueryCache> query_cache;
+
     /**
      * %Function returning the index of the finite element following the given
      * one in hierarchy.
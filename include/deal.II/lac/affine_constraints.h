@@ -30,11 +30,15 @@
 #include <deal.II/lac/vector_element_access.h>
 
 #include <boost/range/iterator_range.hpp>
+#include <boost/serialization/split_member.hpp>
 
 #include <algorithm>
+#include <iterator>
+#include <memory>
 #include <set>
 #include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 DEAL_II_NAMESPACE_OPEN
@@ -403,6 +407,428 @@ namespace internal
        */
       GlobalRowsFromLocal<number> global_columns;
     };
+
+
+
+    /**
+     * The storage of the homogeneous part of closed constraints that
+     * AffineConstraints::close() sets up if the weight pool has been enabled
+     * (see AffineConstraints::enable_weight_pool()). The entries of all
+     * constraint lines are then stored here, and the lines only keep a
+     * ConstraintEntries object that refers to their part of the pool.
+     *
+     * The columns of all lines are stored contiguously as 32-bit positions
+     * in the sorted list of all degrees of freedom the constraints refer to.
+     * The weights are stored in a pool in which identical weight patterns
+     * are stored only once. Since the constraints of adaptively refined
+     * meshes typically only have a handful of different weight patterns,
+     * the latter is tiny and stays in cache.
+     *
+     * An object of this type is not changed after it has been set up, so it
+     * can be shared between copies of an AffineConstraints object.
+     */
+    template <typename number>
+    struct ConstraintWeightPool
+    {
+      /**
+       * The sorted global indices of all degrees of freedom the constraint
+       * lines refer to.
+       */
+      std::vector<types::global_dof_index> column_indices;
+
+      /**
+       * The columns of all constraint lines, given as positions in
+       * #column_indices.
+       */
+      std::vector<unsigned int> columns;
+
+      /**
+       * The unique weight patterns, stored one after the other.
+       */
+      std::vector<number> weights;
+
+      /**
+       * The number of unique weight patterns stored in #weights.
+       */
+      unsigned int n_patterns = 0;
+
+      /**
+       * Determine an estimate for the memory consumption (in bytes) of this
+       * object.
+       */
+      std::size_t
+      memory_consumption() const;
+    };
+
+
+
+    /**
+     * The entries that make up the homogeneous part of a constraint, i.e.,
+     * pairs of the global index of a degree of freedom and the weight with
+     * which it enters the constraint. This is the type of
+     * AffineConstraints::ConstraintLine::entries.
+     *
+     * An object of this class stores its entries in a std::vector, unless
+     * AffineConstraints::close() has moved them into the
+     * ConstraintWeightPool of an AffineConstraints object that uses the
+     * weight pool. In the latter case, the object only stores the position
+     * of its entries in the pool, and it remains valid only as long as the
+     * AffineConstraints object it was obtained from is neither changed nor
+     * destroyed.
+     *
+     * Read access works the same way in both cases, except that the entries
+     * are returned by value. Non-const access to an object that refers to a
+     * pool first copies its entries into a std::vector.
+     */
+    template <typename number>
+    class ConstraintEntries
+    {
+    public:
+      /**
+       * The type of a single entry.
+       */
+      using value_type = std::pair<types::global_dof_index, number>;
+
+      /**
+       * The type in which the entries are stored outside of a pool.
+       */
+      using Storage = std::vector<value_type>;
+
+      /**
+       * A random access iterator that returns the entries by value.
+       */
+      class const_iterator
+      {
+      public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type        = ConstraintEntries::value_type;
+        using difference_type   = std::ptrdiff_t;
+        using pointer           = void;
+        using reference         = value_type;
+
+        /**
+         * Constructor. If @p column_indices is a null pointer, the entries
+         * are read from @p entries, otherwise from @p columns and
+         * @p weights.
+         */
+        const_iterator(const value_type              *entries,
+                       const types::global_dof_index *column_indices,
+                       const unsigned int            *columns,
+                       const number                  *weights,
+                       const difference_type          index)
+          : entries(entries)
+          , column_indices(column_indices)
+          , columns(columns)
+          , weights(weights)
+          , index(index)
+        {}
+
+        value_type
+        operator*() const
+        {
+          if (column_indices == nullptr)
+            return entries[index];
+          else
+            return {column_indices[columns[index]], weights[index]};
+        }
+
+        value_type
+        operator[](const difference_type n) const
+        {
+          return *(*this + n);
+        }
+
+        const_iterator &
+        operator++()
+        {
+          ++index;
+          return *this;
+        }
+
+        const_iterator
+        operator++(int)
+        {
+          const const_iterator old = *this;
+          ++index;
+          return old;
+        }
+
+        const_iterator &
+        operator--()
+        {
+          --index;
+          return *this;
+        }
+
+        const_iterator &
+        operator+=(const difference_type n)
+        {
+          index += n;
+          return *this;
+        }
+
+        const_iterator
+        operator+(const difference_type n) const
+        {
+          const_iterator result = *this;
+          result.index += n;
+          return result;
+        }
+
+        difference_type
+        operator-(const const_iterator &other) const
+        {
+          return index - other.index;
+        }
+
+        bool
+        operator==(const const_iterator &other) const
+        {
+          return index == other.index;
+        }
+
+        bool
+        operator!=(const const_iterator &other) const
+        {
+          return index != other.index;
+        }
+
+        bool
+        operator<(const const_iterator &other) const
+        {
+          return index < other.index;
+        }
+
+      private:
+        const value_type              *entries;
+        const types::global_dof_index *column_indices;
+        const unsigned int            *columns;
+        const number                  *weights;
+        difference_type                index;
+      };
+
+      /**
+       * Default constructor. Creates an empty list of entries.
+       */
+      ConstraintEntries() = default;
+
+      /**
+       * Constructor. Copy the given entries.
+       */
+      ConstraintEntries(const Storage &entries);
+
+      /**
+       * Constructor. Take over the given entries.
+       */
+      ConstraintEntries(Storage &&entries);
+
+      /**
+       * Constructor. Copy the entries in the range [begin, end), converting
+       * the weights to @p number if necessary.
+       */
+      template <typename Iterator>
+      ConstraintEntries(const Iterator begin, const Iterator end);
+
+      /**
+       * Constructor. Refer to @p n_entries entries in @p pool, starting at
+       * @p first_column in ConstraintWeightPool::columns and at
+       * @p first_weight in ConstraintWeightPool::weights.
+       */
+      ConstraintEntries(const ConstraintWeightPool<number> &pool,
+                        const unsigned int                  first_column,
+                        const unsigned int                  first_weight,
+                        const unsigned int                  n_entries);
+
+      /**
+       * Return the number of entries.
+       */
+      std::size_t
+      size() const;
+
+      /**
+       * Return whether there are no entries.
+       */
+      bool
+      empty() const;
+
+      /**
+       * Return the number of entries for which memory has been allocated.
+       */
+      std::size_t
+      capacity() const;
+
+      /**
+       * Return whether this object refers to entries in a
+       * ConstraintWeightPool.
+       */
+      bool
+      is_pooled() const;
+
+      /**
+       * Return the entry with the given number.
+       */
+      value_type
+      operator[](const std::size_t i) const;
+
+      /**
+       * Return a reference to the entry with the given number.
+       */
+      value_type &
+      operator[](const std::size_t i);
+
+      /**
+       * Return the first entry.
+       */
+      value_type
+      front() const;
+
+      /**
+       * Return the last entry.
+       */
+      value_type
+      back() const;
+
+      /**
+       * Return a reference to the last entry.
+       */
+      value_type &
+      back();
+
+      /**
+       * Return an iterator to the first entry.
+       */
+      const_iterator
+      begin() const;
+
+      /**
+       * Return an iterator past the last entry.
+       */
+      const_iterator
+      end() const;
+
+      /**
+       * Return an iterator to the first entry that allows changing it.
+       */
+      typename Storage::iterator
+      begin();
+
+      /**
+       * Return an iterator past the last entry that allows changing the
+       * entries.
+       */
+      typename Storage::iterator
+      end();
+
+      /**
+       * Append an entry.
+       */
+      void
+      push_back(const value_type &entry);
+
+      /**
+       * Append an entry constructed from the given arguments.
+       */
+      template <typename... Args>
+      void
+      emplace_back(Args &&...args);
+
+      /**
+       * Allocate memory for @p n entries.
+       */
+      void
+      reserve(const std::size_t n);
+
+      /**
+       * Remove all entries.
+       */
+      void
+      clear();
+
+      /**
+       * Remove the entry at the given position.
+       */
+      typename Storage::iterator
+      erase(const typename Storage::iterator position);
+
+      /**
+       * Remove the entries in the range [begin, end).
+       */
+      typename Storage::iterator
+      erase(const typename Storage::iterator begin,
+            const typename Storage::iterator end);
+
+      /**
+       * Exchange the entries of this object and of @p other.
+       */
+      void
+      swap(ConstraintEntries &other);
+
+      /**
+       * Return whether both objects contain the same entries.
+       */
+      bool
+      operator==(const ConstraintEntries &other) const;
+
+      /**
+       * Return whether the two objects contain different entries.
+       */
+      bool
+      operator!=(const ConstraintEntries &other) const;
+
+      /**
+       * Determine an estimate for the memory consumption (in bytes) of this
+       * object. Entries that are stored in a pool are not counted.
+       */
+      std::size_t
+      memory_consumption() const;
+
+      /**
+       * Write the entries into a stream for the purpose of serialization
+       * using the [BOOST serialization
+       * library](https://www.boost.org/doc/libs/1_74_0/libs/serialization/doc/index.html).
+       */
+      template <class Archive>
+      void
+      save(Archive &ar, const unsigned int version) const;
+
+      /**
+       * Read the entries from a stream for the purpose of serialization
+       * using the [BOOST serialization
+       * library](https://www.boost.org/doc/libs/1_74_0/libs/serialization/doc/index.html).
+       * The entries are stored in a std::vector afterwards.
+       */
+      template <class Archive>
+      void
+      load(Archive &ar, const unsigned int version);
+
+      // This macro defines the serialize() method that is compatible with
+      // the templated save() and load() method that have been implemented.
+      BOOST_SERIALIZATION_SPLIT_MEMBER()
+
+    private:
+      /**
+       * The position of the entries of an object in a ConstraintWeightPool.
+       */
+      struct PoolPosition
+      {
+        const ConstraintWeightPool<number> *pool;
+        unsigned int                        first_column;
+        unsigned int                        first_weight;
+        unsigned int                        n_entries;
+      };
+
+      /**
+       * The entries, either stored in a std::vector or in a pool.
+       */
+      std::variant<Storage, PoolPosition> data;
+
+      /**
+       * Return the std::vector that stores the entries, after copying them
+       * out of the pool if necessary.
+       */
+      Storage &
+      storage();
+    };
   } // namespace AffineConstraints
 } // namespace internal
 
@@ -875,11 +1301,49 @@ public:
    * \frac{u_3}{2} + \frac{u_2}{4} + \frac{u_4}{4}$. Note, however, that
    * cycles in this graph of constraints are not allowed, i.e., for example
    * $u_4$ may not itself be constrained, directly or indirectly, to $u_{13}$
-   * again.
+   * again. Chains are resolved by sorting the constraints topologically,
+   * i.e., a constraint is only expanded once all constraints it refers to
+   * have been resolved. The constraints of each such level are independent of
+   * each other and are processed in parallel. A cycle results in an
+   * exception.
    */
   void
   close();
 
+  /**
+   * Let close() move the homogeneous part of the constraints into a pool in
+   * which the columns of all lines are stored contiguously as 32-bit indices
+   * into the sorted list of all degrees of freedom the constraints refer to,
+   * and in which the weights are stored as unique weight patterns (see
+   * internal::AffineConstraints::ConstraintWeightPool). On adaptively
+   * refined meshes, most hanging node constraints share the same few weight
+   * patterns (see n_weight_patterns()), so this reduces the memory used for
+   * a constraint entry from a global index and a weight to a 32-bit index.
+   * Since the entries of all lines are then stored contiguously, the loops
+   * over constraints in distribute(), condense() and
+   * distribute_local_to_global() also read less memory.
+   *
+   * The pool is the only storage of the entries of closed constraints:
+   * ConstraintLine::entries, as returned by get_lines() and
+   * get_constraint_entries(), then only refers to the position of the
+   * entries of a line in the pool and returns them by value. These objects
+   * remain valid as long as the current object is neither changed nor
+   * destroyed. Copies of the current object share the pool.
+   *
+   * If this object is already closed, the pool is set up (or released)
+   * immediately. The setting is kept by clear() and reinit().
+   */
+  void
+  enable_weight_pool(const bool enable = true);
+
+  /**
+   * Return the number of unique weight patterns in the pool set up by
+   * close() if enable_weight_pool() has been called, and zero otherwise.
+   * Constraints without entries are not counted.
+   */
+  unsigned int
+  n_weight_patterns() const;
+
   /**
    * Check if the function close() was called or there are no
    * constraints locally, which is normally the case if a dummy
@@ -1047,10 +1511,10 @@ public:
   has_inhomogeneities() const;
 
   /**
-   * Return a pointer to the vector of entries if a line is constrained,
-   * and a zero pointer in case the dof is not constrained.
+   * Return a pointer to the entries (see ConstraintLine::Entries) if a line
+   * is constrained, and a zero pointer in case the dof is not constrained.
    */
-  const std::vector<std::pair<size_type, number>> *
+  const internal::AffineConstraints::ConstraintEntries<number> *
   get_constraint_entries(const size_type line_n) const;
 
   /**
@@ -1723,9 +2187,12 @@ public:
   {
     /**
      * A data type in which we store the list of entries that make up the
-     * homogeneous part of a constraint.
+     * homogeneous part of a constraint. It behaves like a
+     * std::vector<std::pair<size_type, number>>, except that the entries of a
+     * closed object that uses the weight pool (see enable_weight_pool()) are
+     * stored in the pool and returned by value.
      */
-    using Entries = std::vector<std::pair<size_type, number>>;
+    using Entries = internal::AffineConstraints::ConstraintEntries<number>;
 
     /**
      * Global DoF index of this line. Since only very few lines are stored,
@@ -2062,6 +2529,30 @@ private:
    */
   bool sorted;
 
+  /**
+   * Store whether close() should set up #weight_pool.
+   */
+  bool use_weight_pool;
+
+  /**
+   * The storage of the entries of the closed constraints, see
+   * enable_weight_pool(). This is a null pointer unless the object is
+   * closed and the weight pool is enabled. The pool is shared between
+   * copies of this object, and it is held by pointer so that the
+   * ConstraintLine::entries referring to it stay valid when this object is
+   * moved.
+   */
+  std::shared_ptr<
+    const internal::AffineConstraints::ConstraintWeightPool<number>>
+    weight_pool;
+
+  /**
+   * Move the entries of the sorted and closed constraint lines into a new
+   * #weight_pool.
+   */
+  void
+  setup_weight_pool();
+
   mutable Threads::ThreadLocalStorage<
     internal::AffineConstraints::ScratchData<number>>
     scratch_data;
@@ -2139,6 +2630,309 @@ private:
 
 /* ---------------- template and inline functions ----------------- */
 
+namespace internal
+{
+  namespace AffineConstraints
+  {
+    template <typename number>
+    inline ConstraintEntries<number>::ConstraintEntries(const Storage &entries)
+      : data(entries)
+    {}
+
+
+
+    template <typename number>
+    inline ConstraintEntries<number>::ConstraintEntries(Storage &&entries)
+      : data(std::move(entries))
+    {}
+
+
+
+    template <typename number>
+    template <typename Iterator>
+    inline ConstraintEntries<number>::ConstraintEntries(const Iterator begin,
+                                                        const Iterator end)
+      : data(Storage(begin, end))
+    {}
+
+
+
+    template <typename number>
+    inline ConstraintEntries<number>::ConstraintEntries(
+      const ConstraintWeightPool<number> &pool,
+      const unsigned int                  first_column,
+      const unsigned int                  first_weight,
+      const unsigned int                  n_entries)
+      : data(PoolPosition{&pool, first_column, first_weight, n_entries})
+    {
+      AssertIndexRange(first_column + n_entries, pool.columns.size() + 1);
+      AssertIndexRange(first_weight + n_entries, pool.weights.size() + 1);
+    }
+
+
+
+    template <typename number>
+    inline std::size_t
+    ConstraintEntries<number>::size() const
+    {
+      if (const PoolPosition *position = std::get_if<PoolPosition>(&data))
+        return position->n_entries;
+      else
+        return std::get<Storage>(data).size();
+    }
+
+
+
+    template <typename number>
+    inline bool
+    ConstraintEntries<number>::empty() const
+    {
+      return size() == 0;
+    }
+
+
+
+    template <typename number>
+    inline std::size_t
+    ConstraintEntries<number>::capacity() const
+    {
+      if (const PoolPosition *position = std::get_if<PoolPosition>(&data))
+        return position->n_entries;
+      else
+        return std::get<Storage>(data).capacity();
+    }
+
+
+
+    template <typename number>
+    inline bool
+    ConstraintEntries<number>::is_pooled() const
+    {
+      return std::holds_alternative<PoolPosition>(data);
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::value_type
+    ConstraintEntries<number>::operator[](const std::size_t i) const
+    {
+      AssertIndexRange(i, size());
+      return begin()[i];
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::value_type &
+    ConstraintEntries<number>::operator[](const std::size_t i)
+    {
+      AssertIndexRange(i, size());
+      return storage()[i];
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::value_type
+    ConstraintEntries<number>::front() const
+    {
+      Assert(empty() == false, ExcEmptyObject());
+      return *begin();
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::value_type
+    ConstraintEntries<number>::back() const
+    {
+      Assert(empty() == false, ExcEmptyObject());
+      return begin()[size() - 1];
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::value_type &
+    ConstraintEntries<number>::back()
+    {
+      Assert(empty() == false, ExcEmptyObject());
+      return storage().back();
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::const_iterator
+    ConstraintEntries<number>::begin() const
+    {
+      if (const PoolPosition *position = std::get_if<PoolPosition>(&data))
+        return const_iterator(
+          nullptr,
+          position->pool->column_indices.data(),
+          position->pool->columns.data() + position->first_column,
+          position->pool->weights.data() + position->first_weight,
+          0);
+      else
+        return const_iterator(
+          std::get<Storage>(data).data(), nullptr, nullptr, nullptr, 0);
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::const_iterator
+    ConstraintEntries<number>::end() const
+    {
+      return begin() + size();
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::Storage::iterator
+    ConstraintEntries<number>::begin()
+    {
+      return storage().begin();
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::Storage::iterator
+    ConstraintEntries<number>::end()
+    {
+      return storage().end();
+    }
+
+
+
+    template <typename number>
+    inline void
+    ConstraintEntries<number>::push_back(const value_type &entry)
+    {
+      storage().push_back(entry);
+    }
+
+
+
+    template <typename number>
+    template <typename... Args>
+    inline void
+    ConstraintEntries<number>::emplace_back(Args &&...args)
+    {
+      storage().emplace_back(std::forward<Args>(args)...);
+    }
+
+
+
+    template <typename number>
+    inline void
+    ConstraintEntries<number>::reserve(const std::size_t n)
+    {
+      storage().reserve(n);
+    }
+
+
+
+    template <typename number>
+    inline void
+    ConstraintEntries<number>::clear()
+    {
+      data = Storage();
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::Storage::iterator
+    ConstraintEntries<number>::erase(
+      const typename Storage::iterator position)
+    {
+      return storage().erase(position);
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::Storage::iterator
+    ConstraintEntries<number>::erase(const typename Storage::iterator begin,
+                                     const typename Storage::iterator end)
+    {
+      return storage().erase(begin, end);
+    }
+
+
+
+    template <typename number>
+    inline void
+    ConstraintEntries<number>::swap(ConstraintEntries &other)
+    {
+      data.swap(other.data);
+    }
+
+
+
+    template <typename number>
+    inline bool
+    ConstraintEntries<number>::operator==(const ConstraintEntries &other) const
+    {
+      return (size() == other.size()) &&
+             std::equal(begin(), end(), other.begin());
+    }
+
+
+
+    template <typename number>
+    inline bool
+    ConstraintEntries<number>::operator!=(const ConstraintEntries &other) const
+    {
+      return !(*this == other);
+    }
+
+
+
+    template <typename number>
+    template <class Archive>
+    inline void
+    ConstraintEntries<number>::save(Archive &ar, const unsigned int) const
+    {
+      const Storage entries(begin(), end());
+      ar           &entries;
+    }
+
+
+
+    template <typename number>
+    template <class Archive>
+    inline void
+    ConstraintEntries<number>::load(Archive &ar, const unsigned int)
+    {
+      Storage entries;
+      ar     &entries;
+      data = std::move(entries);
+    }
+
+
+
+    template <typename number>
+    inline typename ConstraintEntries<number>::Storage &
+    ConstraintEntries<number>::storage()
+    {
+      if (is_pooled())
+        {
+          Storage entries(std::as_const(*this).begin(),
+                          std::as_const(*this).end());
+          data = std::move(entries);
+        }
+      return std::get<Storage>(data);
+    }
+  } // namespace AffineConstraints
+} // namespace internal
+
+
+
 template <typename number>
 inline AffineConstraints<number>::AffineConstraints()
   : AffineConstraints<number>(IndexSet(), IndexSet())
@@ -2163,6 +2957,7 @@ inline AffineConstraints<number>::AffineConstraints(
   , locally_owned_dofs(locally_owned_dofs)
   , local_lines(locally_stored_constraints)
   , sorted(false)
+  , use_weight_pool(false)
 {
   Assert(locally_owned_dofs.is_subset_of(locally_stored_constraints),
          ExcMessage("The set of locally stored constraints needs to be a "
@@ -2187,6 +2982,8 @@ inline AffineConstraints<number>::AffineConstraints(
   , needed_elements_for_distribute(
       affine_constraints.needed_elements_for_distribute)
   , sorted(affine_constraints.sorted)
+  , use_weight_pool(affine_constraints.use_weight_pool)
+  , weight_pool(affine_constraints.weight_pool)
 {}
 
 
@@ -2326,6 +3123,13 @@ AffineConstraints<number>::n_inhomogeneities() const
                        });
 }
 
+template <typename number>
+inline unsigned int
+AffineConstraints<number>::n_weight_patterns() const
+{
+  return (weight_pool != nullptr) ? weight_pool->n_patterns : 0;
+}
+
 template <typename number>
 inline bool
 AffineConstraints<number>::is_constrained(const size_type index) const
@@ -2357,7 +3161,7 @@ AffineConstraints<number>::is_inhomogeneously_constrained(
 }
 
 template <typename number>
-inline const std::vector<std::pair<types::global_dof_index, number>> *
+inline const internal::AffineConstraints::ConstraintEntries<number> *
 AffineConstraints<number>::get_constraint_entries(const size_type line_n) const
 {
   if (lines.empty())
@@ -2445,9 +3249,8 @@ AffineConstraints<number>::distribute_local_to_global(
     {
       const ConstraintLine &position =
         lines[lines_cache[calculate_line_index(index)]];
-      for (size_type j = 0; j < position.entries.size(); ++j)
-        global_vector(position.entries[j].first) +=
-          value * position.entries[j].second;
+      for (const std::pair<size_type, number> &entry : position.entries)
+        global_vector(entry.first) += value * entry.second;
     }
 }
 
@@ -2474,11 +3277,11 @@ AffineConstraints<number>::distribute_local_to_global(
         {
           const ConstraintLine &position =
             lines[lines_cache[calculate_line_index(*local_indices_begin)]];
-          for (size_type j = 0; j < position.entries.size(); ++j)
-            internal::ElementAccess<VectorType>::add(
-              (*local_vector_begin) * position.entries[j].second,
-              position.entries[j].first,
-              global_vector);
+          for (const std::pair<size_type, number> &entry : position.entries)
+            internal::ElementAccess<VectorType>::add((*local_vector_begin) *
+                                                       entry.second,
+                                                     entry.first,
+                                                     global_vector);
         }
     }
 }
@@ -2521,9 +3324,8 @@ AffineConstraints<number>::get_dof_values(
           const ConstraintLine &position =
             lines[lines_cache[calculate_line_index(*local_indices_begin)]];
           typename VectorType::value_type value = position.inhomogeneity;
-          for (size_type j = 0; j < position.entries.size(); ++j)
-            value += (global_vector(position.entries[j].first) *
-                      position.entries[j].second);
+          for (const std::pair<size_type, number> &entry : position.entries)
+            value += (global_vector(entry.first) * entry.second);
           *local_vector_begin = value;
         }
     }
@@ -2618,7 +3420,7 @@ AffineConstraints<number>::copy_from(
   lines.clear();
   lines.reserve(other.lines.size());
 
-  for (const auto l : other.lines)
+  for (const auto &l : other.lines)
     lines.emplace_back(l.index,
                        typename ConstraintLine::Entries(l.entries.begin(),
                                                         l.entries.end()),
@@ -2630,6 +3432,13 @@ AffineConstraints<number>::copy_from(
 
   locally_owned_dofs             = other.locally_owned_dofs;
   needed_elements_for_distribute = other.needed_elements_for_distribute;
+
+  // the lines above store their entries in vectors, so set up a pool of
+  // our own if the other object uses one
+  use_weight_pool = other.use_weight_pool;
+  weight_pool.reset();
+  if (use_weight_pool && sorted)
+    setup_weight_pool();
 }
 
 
@@ -55,6 +55,8 @@
 #include <algorithm>
 #include <complex>
 #include <iomanip>
+#include <limits>
+#include <map>
 #include <numeric>
 #include <ostream>
 #include <set>
@@ -68,12 +70,42 @@ std::size_t
 AffineConstraints<number>::ConstraintLine::memory_consumption() const
 {
   return (MemoryConsumption::memory_consumption(index) +
-          MemoryConsumption::memory_consumption(entries) +
+          entries.memory_consumption() +
           MemoryConsumption::memory_consumption(inhomogeneity));
 }
 
 
 
+namespace internal
+{
+  namespace AffineConstraints
+  {
+    template <typename number>
+    std::size_t
+    ConstraintWeightPool<number>::memory_consumption() const
+    {
+      return (MemoryConsumption::memory_consumption(column_indices) +
+              MemoryConsumption::memory_consumption(columns) +
+              MemoryConsumption::memory_consumption(weights));
+    }
+
+
+
+    template <typename number>
+    std::size_t
+    ConstraintEntries<number>::memory_consumption() const
+    {
+      if (is_pooled())
+        return sizeof(*this);
+      else
+        return sizeof(*this) - sizeof(Storage) +
+               MemoryConsumption::memory_consumption(std::get<Storage>(data));
+    }
+  } // namespace AffineConstraints
+} // namespace internal
+
+
+
 template <typename number>
 typename AffineConstraints<number>::LineRange
 AffineConstraints<number>::get_lines() const
@@ -509,7 +541,9 @@ AffineConstraints<number>::make_consistent_in_parallel(
 
       // ... entries
       if (!line.entries.empty())
-        this->add_entries(line.index, line.entries);
+        this->add_entries(line.index,
+                          std::vector<std::pair<size_type, number>>(
+                            line.entries.begin(), line.entries.end()));
     }
 
 #ifdef DEBUG
@@ -684,191 +718,167 @@ AffineConstraints<number>::close()
 
 
 
-#ifdef DEBUG
-  // In debug mode we are computing an estimate for the maximum number
-  // of constraints so that we can bail out if there is a cycle in the
-  // constraints (which is easier than searching for cycles in the graph).
+  // replace references to dofs that are themselves constrained. for example
+  // if x3=x0/2+x2/2 and x2=x0/2+x1/2, then the new list will be
+  // x3=x0/2+x0/4+x1/4. note that x0 appears twice. we will throw this
+  // duplicate out in the following step, where we sort the list so that
+  // throwing out duplicates becomes much more efficient.
   //
-  // Let us figure out the largest dof index. This is an upper bound for the
-  // number of constraints because it is an approximation for the number of dofs
-  // in our system.
-  size_type largest_idx = 0;
-  for (const ConstraintLine &line : lines)
-    for (const std::pair<size_type, number> &entry : line.entries)
-      largest_idx = std::max(largest_idx, entry.first);
-#endif
+  // rather than iterating over all lines until no chains are left, we sort
+  // the lines topologically with respect to the "is constrained to" relation:
+  // the lines on level zero only refer to unconstrained dofs, and all lines
+  // that line on level k refers to are on levels less than k. If we resolve
+  // the lines level by level, each entry needs to be expanded exactly once
+  // since the lines it refers to are already free of chains. Furthermore,
+  // all lines on one level are independent of each other, so they can be
+  // processed in parallel. A cycle in the constraints shows up as a set of
+  // lines that never ends up on any level.
+  //
+  // As a first step, record for each line the positions of the (locally
+  // stored) lines its entries refer to. This only reads data and can be
+  // done in parallel:
+  const auto find_constrained_line =
+    [this](const size_type dof_index) -> size_type {
+    if (((local_lines.size() == 0) || (local_lines.is_element(dof_index))) &&
+        is_constrained(dof_index))
+      return lines_cache[calculate_line_index(dof_index)];
+    else
+      return numbers::invalid_size_type;
+  };
 
-      // replace references to dofs that are themselves constrained. note that
-      // because we may replace references to other dofs that may themselves be
-      // constrained to third ones, we have to iterate over all this until we
-      // replace no chains of constraints any more
-      //
-      // the iteration replaces references to constrained degrees of freedom by
-      // second-order references. for example if x3=x0/2+x2/2 and x2=x0/2+x1/2,
-      // then the new list will be x3=x0/2+x0/4+x1/4. note that x0 appear
-      // twice. we will throw this duplicate out in the following step, where
-      // we sort the list so that throwing out duplicates becomes much more
-      // efficient. also, we have to do it only once, rather than in each
-      // iteration
-#ifdef DEBUG
-  size_type iteration = 0;
-#endif
-  bool                                chained_constraint_replaced = false;
-  std::vector<bool>                   line_finalized(lines.size(), false);
-  std::vector<const ConstraintLine *> sub_constraints;
-  std::vector<unsigned int>           entries_to_delete;
-  do
-    {
-      chained_constraint_replaced = false;
-      for (unsigned int line_index = 0; line_index < lines.size(); ++line_index)
-        if (line_finalized[line_index] == false)
+  std::vector<std::vector<size_type>> dependencies(lines.size());
+  parallel::apply_to_subranges(
+    size_type(0),
+    size_type(lines.size()),
+    [&](const size_type begin, const size_type end) {
+      for (size_type l = begin; l < end; ++l)
+        for (const std::pair<size_type, number> &entry : lines[l].entries)
           {
-            ConstraintLine &line = lines[line_index];
-
-#ifdef DEBUG
-            // we need to keep track of how many replacements we do in this
-            // line, because we can end up in a cycle A->B->C->A without the
-            // number of entries growing.
-            size_type n_replacements = 0;
-#endif
-
-            // loop over all entries of this line (including ones that we
-            // have appended in this go around) and see whether they are
-            // further constrained. ignore elements that we don't store on
-            // the current processor.
-            //
-            // If we find that one of the entries in the current line is indeed
-            // constrained, then store the address of the line it corresponds to
-            // for further processing; this avoids having to look it up again,
-            // which requires an IndexSet lookup. If not, store a nullptr.
-            sub_constraints.resize(line.entries.size());
-            bool has_sub_constraints = false;
-            for (unsigned int entry = 0; entry < line.entries.size(); ++entry)
-              if (((local_lines.size() == 0) ||
-                   (local_lines.is_element(line.entries[entry].first))) &&
-                  is_constrained(line.entries[entry].first))
-                {
-                  const size_type dof_index = line.entries[entry].first;
-                  sub_constraints[entry] =
-                    &lines[lines_cache[calculate_line_index(dof_index)]];
-                  has_sub_constraints = true;
-                }
-              else
-                sub_constraints[entry] = nullptr;
-
-            // If none of the entries in the current line refer to DoFs that are
-            // themselves constrained, then we can move on:
-            if (has_sub_constraints == false)
+            const size_type line_index = find_constrained_line(entry.first);
+            if (line_index != numbers::invalid_size_type)
               {
-                line_finalized[line_index] = true;
-                continue;
+                Assert(line_index != l,
+                       ExcMessage("Cycle in constraints detected!"));
+                dependencies[l].push_back(line_index);
               }
+          }
+    },
+    /* grainsize = */ 100);
 
-            // Now walk through the original entries. We may replace some of
-            // them, and we may add some, but we only walk through the original
-            // entries (and also don't touch the replacements) even though in
-            // principle we could also do the ones we have added or replaced. We
-            // don't because we don't have information for those in the
-            // sub_constraints array above. But there is no harm in doing so:
-            // we will simply treat those in the next round around of the outer
-            // iteration.
-            //
-            // Since we want to delete some entries (see below) but don't want
-            // to disturb the order of the correspondence between lines.entries
-            // and sub_constraints, we store up which entries we will later
-            // have to delete.
-            const unsigned int n_original_entries = line.entries.size();
-            entries_to_delete.clear();
-            for (unsigned int entry = 0; entry < n_original_entries; ++entry)
-              if (sub_constraints[entry] != nullptr)
-                {
-                  // ok, this entry is further constrained:
-                  chained_constraint_replaced = true;
-
-                  // look up the chain of constraints for this entry
-                  [[maybe_unused]] const size_type dof_index =
-                    line.entries[entry].first;
-                  const number weight = line.entries[entry].second;
+  // Then invert the relation, i.e., store for each line which other lines
+  // refer to it, in a compressed row format. Also count the number of lines
+  // a line waits for and put the ones without dependencies on the first
+  // level.
+  std::vector<size_type> n_unresolved_dependencies(lines.size());
+  std::vector<size_type> dependents_start(lines.size() + 1, 0);
+  std::vector<size_type> current_level;
+  for (size_type l = 0; l < lines.size(); ++l)
+    {
+      n_unresolved_dependencies[l] = dependencies[l].size();
+      for (const size_type d : dependencies[l])
+        ++dependents_start[d + 1];
+      if (dependencies[l].empty())
+        current_level.push_back(l);
+    }
 
-                  Assert(dof_index != line.index,
-                         ExcMessage("Cycle in constraints detected!"));
+  // only do the work below if there are any chains at all
+  if (current_level.size() < lines.size())
+    {
+      std::partial_sum(dependents_start.begin(),
+                       dependents_start.end(),
+                       dependents_start.begin());
+      std::vector<size_type> dependents(dependents_start.back());
+      {
+        std::vector<size_type> fill_position(dependents_start.begin(),
+                                             dependents_start.end() - 1);
+        for (size_type l = 0; l < lines.size(); ++l)
+          for (const size_type d : dependencies[l])
+            dependents[fill_position[d]++] = l;
+      }
+      dependencies.clear();
 
-                  const ConstraintLine &constrained_line =
-                    *sub_constraints[entry];
-                  Assert(constrained_line.index == dof_index,
-                         ExcInternalError());
+      size_type              n_resolved_lines = 0;
+      std::vector<size_type> next_level;
+      while (current_level.empty() == false)
+        {
+          // Now resolve the lines on the current level, all of which only
+          // refer to lines that no longer contain chains. We replace an entry
+          // that is constrained by the first entry of its expansion and add
+          // the remaining ones to the end of the list. If the constrained DoF
+          // is not constrained to a linear combination of other dofs but only
+          // to the inhomogeneity (i.e. its chain of entries is empty), we
+          // instead delete the entry.
+          parallel::apply_to_subranges(
+            current_level.begin(),
+            current_level.end(),
+            [&](const std::vector<size_type>::const_iterator begin,
+                const std::vector<size_type>::const_iterator end) {
+              std::vector<unsigned int> entries_to_delete;
+              for (const size_type line_index :
+                   boost::make_iterator_range(begin, end))
+                {
+                  ConstraintLine &line = lines[line_index];
 
-                  // now we have to replace an entry by its expansion. we do
-                  // that by overwriting the entry by the first entry of the
-                  // expansion and adding the remaining ones to the end,
-                  // where we will later process them once more
-                  //
-                  // we can of course only do that if the DoF that we are
-                  // currently handling is constrained by a linear combination
-                  // of other dofs:
-                  if (constrained_line.entries.size() > 0)
+                  const unsigned int n_original_entries = line.entries.size();
+                  entries_to_delete.clear();
+                  for (unsigned int entry = 0; entry < n_original_entries;
+                       ++entry)
                     {
-                      for (size_type i = 0; i < constrained_line.entries.size();
-                           ++i)
-                        Assert(dof_index != constrained_line.entries[i].first,
-                               ExcMessage("Cycle in constraints detected!"));
-
-                      // replace first entry, then tack the rest to the end
-                      // of the list
-                      line.entries[entry] = std::pair<size_type, number>(
-                        constrained_line.entries[0].first,
-                        constrained_line.entries[0].second * weight);
-
-                      for (size_type i = 1; i < constrained_line.entries.size();
-                           ++i)
-                        line.entries.emplace_back(
-                          constrained_line.entries[i].first,
-                          constrained_line.entries[i].second * weight);
+                      const size_type constrained_line_index =
+                        find_constrained_line(line.entries[entry].first);
+                      if (constrained_line_index == numbers::invalid_size_type)
+                        continue;
 
-#ifdef DEBUG
-                      // keep track of how many entries we replace in this
-                      // line. If we do more than there are constraints or
-                      // dofs in our system, we must have a cycle.
-                      ++n_replacements;
-                      Assert(n_replacements / 2 < largest_idx,
-                             ExcMessage("Cycle in constraints detected!"));
-#endif
-                    }
-                  else
-                    // the DoF that we encountered is not constrained by a
-                    // linear combination of other dofs but is equal to just
-                    // the inhomogeneity (i.e. its chain of entries is
-                    // empty). in that case, we can't just overwrite the
-                    // current entry, but we have to actually eliminate it
-                    {
-                      entries_to_delete.emplace_back(entry);
+                      const number weight = line.entries[entry].second;
+                      const ConstraintLine &constrained_line =
+                        lines[constrained_line_index];
+
+                      if (constrained_line.entries.size() > 0)
+                        {
+                          line.entries[entry] = std::pair<size_type, number>(
+                            constrained_line.entries[0].first,
+                            constrained_line.entries[0].second * weight);
+
+                          for (size_type i = 1;
+                               i < constrained_line.entries.size();
+                               ++i)
+                            line.entries.emplace_back(
+                              constrained_line.entries[i].first,
+                              constrained_line.entries[i].second * weight);
+                        }
+                      else
+                        entries_to_delete.emplace_back(entry);
+
+                      line.inhomogeneity +=
+                        constrained_line.inhomogeneity * weight;
                     }
 
-                  line.inhomogeneity += constrained_line.inhomogeneity * weight;
+                  // Now delete the elements we have marked for deletion. The
+                  // indices are sorted, so walk backward from the end to not
+                  // have to keep track of already erased earlier elements.
+                  for (auto it = entries_to_delete.rbegin();
+                       it != entries_to_delete.rend();
+                       ++it)
+                    line.entries.erase(line.entries.begin() + *it);
                 }
+            },
+            /* grainsize = */ 100);
+
+          // Finally find the lines whose dependencies have all been resolved
+          // and that therefore make up the next level
+          n_resolved_lines += current_level.size();
+          next_level.clear();
+          for (const size_type l : current_level)
+            for (size_type i = dependents_start[l]; i < dependents_start[l + 1];
+                 ++i)
+              if (--n_unresolved_dependencies[dependents[i]] == 0)
+                next_level.push_back(dependents[i]);
+          current_level.swap(next_level);
+        }
 
-            // Now delete the elements we have marked for deletion. Do
-            // so in reverse order so that we compress the array walking
-            // backward from the end without having to keep track that
-            // we have already erased earlier elements (as we would have to
-            // do if we walked the list of entries to delete in forward
-            // order).
-            std::sort(entries_to_delete.begin(), entries_to_delete.end());
-            for (auto it = entries_to_delete.rbegin();
-                 it != entries_to_delete.rend();
-                 ++it)
-              line.entries.erase(line.entries.begin() + *it);
-          }
-
-#ifdef DEBUG
-      // increase iteration count. note that we should not iterate more
-      // times than there are constraints, since this puts a natural upper
-      // bound on the length of constraint chains
-      ++iteration;
-      Assert(iteration <= lines.size() + 1, ExcInternalError());
-#endif
+      AssertThrow(n_resolved_lines == lines.size(),
+                  ExcMessage("Cycle in constraints detected!"));
     }
-  while (chained_constraint_replaced == true);
 
   // Finally sort the entries and re-scale them if necessary. in this step,
   // we also throw out duplicates as mentioned above. moreover, as some
@@ -1027,6 +1037,129 @@ AffineConstraints<number>::close()
     }
 
   sorted = true;
+
+  if (use_weight_pool)
+    setup_weight_pool();
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::enable_weight_pool(const bool enable)
+{
+  use_weight_pool = enable;
+
+  if (use_weight_pool && sorted)
+    setup_weight_pool();
+  else if (weight_pool != nullptr)
+    {
+      // copy the entries out of the pool before releasing it
+      for (ConstraintLine &line : lines)
+        if (line.entries.is_pooled())
+          {
+            const typename ConstraintLine::Entries &entries = line.entries;
+            line.entries =
+              typename ConstraintLine::Entries(entries.begin(), entries.end());
+          }
+      weight_pool.reset();
+    }
+}
+
+
+
+template <typename number>
+void
+AffineConstraints<number>::setup_weight_pool()
+{
+  Assert(sorted == true, ExcMatrixNotClosed());
+
+  // identical weight patterns are detected by exact comparison: the
+  // weights of hanging node constraints on different faces are computed
+  // from the same interpolation matrices, so there is no need for a
+  // tolerance here
+  struct WeightPatternComparator
+  {
+    bool
+    operator()(const std::vector<number> &a, const std::vector<number> &b) const
+    {
+      if (a.size() != b.size())
+        return a.size() < b.size();
+      for (unsigned int i = 0; i < a.size(); ++i)
+        if (std::real(a[i]) != std::real(b[i]))
+          return std::real(a[i]) < std::real(b[i]);
+        else if (std::imag(a[i]) != std::imag(b[i]))
+          return std::imag(a[i]) < std::imag(b[i]);
+      return false;
+    }
+  };
+
+  // the lines may still refer to an old pool, which is only released once
+  // the new one has been set up. we therefore only read from the lines
+  // through const references until then
+  const std::vector<ConstraintLine> &const_lines = lines;
+
+  auto pool = std::make_shared<
+    internal::AffineConstraints::ConstraintWeightPool<number>>();
+
+  std::size_t n_entries = 0;
+  for (const ConstraintLine &line : const_lines)
+    n_entries += line.entries.size();
+  AssertThrow(n_entries < std::numeric_limits<unsigned int>::max(),
+              ExcMessage("The weight pool uses 32-bit indices and cannot "
+                         "store this many constraint entries."));
+
+  // number the degrees of freedom the constraints refer to
+  pool->column_indices.reserve(n_entries);
+  for (const ConstraintLine &line : const_lines)
+    for (const std::pair<size_type, number> &entry : line.entries)
+      pool->column_indices.push_back(entry.first);
+  std::sort(pool->column_indices.begin(), pool->column_indices.end());
+  pool->column_indices.erase(std::unique(pool->column_indices.begin(),
+                                         pool->column_indices.end()),
+                             pool->column_indices.end());
+  pool->column_indices.shrink_to_fit();
+
+  // then store the columns of all lines and their unique weight patterns,
+  // and let the lines refer to them
+  pool->columns.reserve(n_entries);
+  std::map<std::vector<number>, unsigned int, WeightPatternComparator>
+                      pattern_starts;
+  std::vector<number> pattern;
+  for (ConstraintLine &line : lines)
+    {
+      const typename ConstraintLine::Entries &entries = line.entries;
+      if (entries.empty())
+        continue;
+
+      const unsigned int first_column = pool->columns.size();
+      pattern.clear();
+      for (const std::pair<size_type, number> &entry : entries)
+        {
+          pool->columns.push_back(
+            std::lower_bound(pool->column_indices.begin(),
+                             pool->column_indices.end(),
+                             entry.first) -
+            pool->column_indices.begin());
+          pattern.push_back(entry.second);
+        }
+
+      const auto position =
+        pattern_starts.emplace(pattern, pool->weights.size());
+      if (position.second)
+        pool->weights.insert(pool->weights.end(),
+                             pattern.begin(),
+                             pattern.end());
+
+      line.entries = typename ConstraintLine::Entries(*pool,
+                                                      first_column,
+                                                      position.first->second,
+                                                      pattern.size());
+    }
+  pool->weights.shrink_to_fit();
+  pool->n_patterns = pattern_starts.size();
+
+  weight_pool = std::move(pool);
 }
 
 
@@ -1070,6 +1203,12 @@ AffineConstraints<number>::shift(const size_type offset)
         entry.first += offset;
     }
 
+  // the loop above has copied the entries out of the weight pool, which
+  // may be shared with copies of this object and is therefore not changed.
+  // set up a new one for the shifted entries
+  if (weight_pool != nullptr)
+    setup_weight_pool();
+
 #ifdef DEBUG
   // make sure that lines, lines_cache and local_lines
   // are still linked correctly
@@ -1098,6 +1237,7 @@ AffineConstraints<number>::clear()
 
   locally_owned_dofs             = {};
   needed_elements_for_distribute = {};
+  weight_pool.reset();
 
   sorted = false;
 }
@@ -1289,7 +1429,8 @@ AffineConstraints<number>::memory_consumption() const
   return (MemoryConsumption::memory_consumption(lines) +
           MemoryConsumption::memory_consumption(lines_cache) +
           MemoryConsumption::memory_consumption(sorted) +
-          MemoryConsumption::memory_consumption(local_lines));
+          MemoryConsumption::memory_consumption(local_lines) +
+          (weight_pool != nullptr ? weight_pool->memory_consumption() : 0));
 }
 
 
@@ -1300,7 +1441,7 @@ AffineConstraints<number>::resolve_indices(
   std::vector<types::global_dof_index> &indices) const
 {
   const unsigned int indices_size = indices.size();
-  const std::vector<std::pair<types::global_dof_index, number>> *line_ptr;
+  const typename ConstraintLine::Entries *line_ptr;
   for (unsigned int i = 0; i < indices_size; ++i)
     {
       line_ptr = get_constraint_entries(indices[i]);
@@ -205,6 +205,11 @@ namespace SparsityTools
    * exception if starting indices are given, taking the latter as an
    * indication that the caller of the function would like to override the
    * part of the algorithm that chooses starting indices.
+   *
+   * For large graphs, the nodes of each new level are searched for in
+   * parallel, using multiple threads. Since the nodes of a level are sorted
+   * by their coordination number and index before they are numbered, the
+   * result does not depend on the number of threads.
    */
   void
   reorder_Cuthill_McKee(
@@ -239,6 +244,28 @@ namespace SparsityTools
     const DynamicSparsityPattern                   &sparsity,
     std::vector<DynamicSparsityPattern::size_type> &new_indices);
 
+  /**
+   * For a given sparsity pattern, compute a re-enumeration of row/column
+   * indices by nested dissection, using the implementation in METIS.
+   *
+   * Nested dissection recursively splits the graph represented by the
+   * sparsity pattern into two parts by a small set of separating nodes, and
+   * numbers the nodes of the two parts before the ones of the separator.
+   * Contrary to reorder_Cuthill_McKee(), the result does not have a small
+   * bandwidth, but it reduces the fill-in of direct factorizations and
+   * groups nodes that are close in the graph also in memory on every level
+   * of the recursion, which is beneficial for the cache use of operations
+   * such as sparse matrix-vector products.
+   *
+   * As for the partition() functions, the sparsity pattern needs to be
+   * symmetric. If deal.II was not configured with METIS, this function
+   * generates an error.
+   */
+  void
+  reorder_nested_dissection(
+    const DynamicSparsityPattern                   &sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices);
+
 #ifdef DEAL_II_WITH_MPI
   /**
    * Communicate rows in a dynamic sparsity pattern over MPI.
@@ -49,13 +49,14 @@ namespace internal
        * all values. It stores the (reordered) numbering of the dofs
        * (according to the ordering that matches with the function) in
        * new_indices, and returns the storage position the double array for
-       * access later on.
+       * access later on. The entries can be given in any container of pairs
+       * of global index and weight, such as the
+       * AffineConstraints::ConstraintLine::Entries returned by
+       * AffineConstraints::get_constraint_entries().
        */
-      template <typename number2>
+      template <typename EntriesType>
       unsigned short
-      insert_entries(
-        const std::vector<std::pair<types::global_dof_index, number2>>
-          &entries);
+      insert_entries(const EntriesType &entries);
 
       /**
        * Return the memory consumption of the allocated memory in this class.
@@ -192,16 +193,15 @@ namespace internal
 
 
     template <typename Number>
-    template <typename number2>
+    template <typename EntriesType>
     unsigned short
-    ConstraintValues<Number>::insert_entries(
-      const std::vector<std::pair<types::global_dof_index, number2>> &entries)
+    ConstraintValues<Number>::insert_entries(const EntriesType &entries)
     {
       next_constraint.first.resize(entries.size());
       if (entries.size() > 0)
         {
           constraint_indices.resize(entries.size());
-          // Use assign so that values for nonmatching Number / number2 are
+          // Use assign so that weights of a different type than Number are
           // converted:
           constraint_entries.assign(entries.begin(), entries.end());
           std::sort(constraint_entries.begin(),
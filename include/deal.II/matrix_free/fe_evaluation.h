@@ -1404,17 +1404,9 @@ protected:
  *     fe_eval.reinit(cell_index);
  *     for (unsigned int q=0; q<fe_eval.n_q_points; ++q)
  *       {
- *         const Point<dim,VectorizedArray<double> > p_vect =
- *           fe_eval.quadrature_point(q);
- *         // Need to evaluate function for each component in VectorizedArray
- *         VectorizedArray<double> f_value = 0.0;
- *         for (unsigned int v=0; v<VectorizedArray<double>::size(); ++v)
- *           {
- *             Point<dim> p;
- *             for (unsigned int d=0; d<dim; ++d)
- *               p[d] = p_vect[d][v];
- *             f_value[v] = function.value(p);
- *           }
+ *         // evaluate the function for each lane of the VectorizedArray
+ *         const VectorizedArray<double> f_value =
+ *           function.value_batch(fe_eval.quadrature_point(q));
  *         fe_eval.submit_value(f_value, q);
  *       }
  *     fe_eval.integrate(EvaluationFlags::values);
@@ -1429,12 +1421,11 @@ protected:
  * @p integrate() call, an integral contribution tested by each basis function
  * underlying the FEEvaluation object (e.g. the four linear shape functions of
  * FE_Q@<2@>(1) in 2d) is computed, which gives the vector entries to be
- * summed into the @p dst vector. Note that the above code needs to explicitly
- * loop over the components in the vectorized array for evaluating the
- * function, which is necessary for interfacing with a generic Function object
- * with double arguments. Simple functions can also be implemented in
- * VectorizedArray form directly as VectorizedArray provides the basic math
- * operations.
+ * summed into the @p dst vector. Note that Function::value_batch() loops over
+ * the components in the vectorized array for evaluating the function, which
+ * is necessary for interfacing with a generic Function object with double
+ * arguments. Simple functions can also be implemented in VectorizedArray form
+ * directly as VectorizedArray provides the basic math operations.
  *
  * For evaluating a bilinear form, the evaluation on a source vector is
  * combined with the integration involving test functions that get written
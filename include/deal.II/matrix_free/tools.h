@@ -18,12 +18,19 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/function.h>
+#include <deal.II/base/parallel.h>
+
 #include <deal.II/grid/tria.h>
 
+#include <deal.II/lac/vector.h>
+
 #include <deal.II/matrix_free/fe_evaluation.h>
 #include <deal.II/matrix_free/matrix_free.h>
 #include <deal.II/matrix_free/vector_access_internal.h>
 
+#include <deal.II/numerics/vector_tools_common.h>
+
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -158,6 +165,93 @@ namespace MatrixFreeTools
 
 
 
+  /**
+   * Compute the error indicator of Kelly, Gago, Zienkiewicz and Babuska for
+   * the finite element function @p solution, i.e., the square root of the
+   * integral of the squared jump of the normal derivative over the faces of
+   * each cell, scaled by the cell diameter over 24. The result is written to
+   * @p error_per_cell, indexed by the active cell index of the
+   * triangulation. The value of cells that are not locally owned is zero.
+   *
+   * This is the same quantity as computed by KellyErrorEstimator::estimate()
+   * with its default arguments, i.e., without coefficient, with the default
+   * strategy, and without Neumann boundaries, so that boundary faces do not
+   * contribute. Rather than FEFaceValues, the jumps are evaluated with
+   * FEFaceEvaluation on batches of faces, which makes use of sum
+   * factorization and vectorization and is thus considerably faster for
+   * elements of high polynomial degree.
+   *
+   * @p matrix_free must have been set up with the flags update_gradients and
+   * update_JxW_values for inner faces (see
+   * MatrixFree::AdditionalData::mapping_update_flags_inner_faces). For a
+   * parallel triangulation,
+   * MatrixFree::AdditionalData::hold_all_faces_to_owned_cells needs to be set
+   * as well, and @p solution must have its ghost values up to date.
+   *
+   * The parameters @p dof_no, @p quad_no, and @p first_selected_component are
+   * passed to the constructor of the FEFaceEvaluation that is internally set
+   * up.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType                                   &solution,
+    Vector<float>                                      &error_per_cell,
+    const unsigned int                                  dof_no  = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component = 0);
+
+
+
+  /**
+   * Compute the cellwise error of the finite element function @p solution
+   * with respect to @p exact_solution, like
+   * VectorTools::integrate_difference() does with FEValues. Here, the values
+   * and gradients of @p solution are evaluated with FEEvaluation on batches
+   * of cells, and @p exact_solution is evaluated in all quadrature points of
+   * a batch with a single call to Function::value_list() and
+   * Function::gradient_list(), or their vector-valued counterparts. The
+   * result is written to @p difference, indexed by the active cell index of
+   * the triangulation. The value of cells that are not locally owned is
+   * zero.
+   *
+   * The norms VectorTools::L2_norm, VectorTools::H1_seminorm, and
+   * VectorTools::H1_norm are supported. They are computed with the quadrature
+   * formula @p quad_no of @p matrix_free, which must have been set up with
+   * the flags update_quadrature_points and update_JxW_values, as well as
+   * update_values or update_gradients as needed by the norm. @p solution must
+   * have its ghost values up to date.
+   *
+   * The parameters @p dof_no, @p quad_no, and @p first_selected_component are
+   * passed to the constructor of the FEEvaluation that is internally set up.
+   */
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType                                   &solution,
+    const Function<dim, Number>                        &exact_solution,
+    Vector<float>                                      &difference,
+    const VectorTools::NormType                        &norm,
+    const unsigned int                                  dof_no  = 0,
+    const unsigned int                                  quad_no = 0,
+    const unsigned int first_selected_component = 0);
+
+
+
   /**
    * A wrapper around MatrixFree to help users to deal with DoFHandler
    * objects involving cells without degrees of freedom, i.e.,
@@ -1305,6 +1399,264 @@ namespace MatrixFreeTools
       first_selected_component);
   }
 
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  estimate_kelly_error(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType                                   &solution,
+    Vector<float>                                      &error_per_cell,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component)
+  {
+    const unsigned int n_inner_face_batches =
+      matrix_free.n_inner_face_batches();
+
+    // compute the integrals of the squared jumps of the normal derivatives
+    // on all inner faces, one batch of faces at a time. each batch only
+    // writes its own entry, so the batches can be processed in parallel
+    std::vector<VectorizedArrayType> face_integrals(n_inner_face_batches);
+    parallel::apply_to_subranges(
+      0U,
+      n_inner_face_batches,
+      [&](const unsigned int begin, const unsigned int end) {
+        FEFaceEvaluation<dim,
+                         fe_degree,
+                         n_q_points_1d,
+                         n_components,
+                         Number,
+                         VectorizedArrayType>
+          phi_m(matrix_free, true, dof_no, quad_no, first_selected_component);
+        FEFaceEvaluation<dim,
+                         fe_degree,
+                         n_q_points_1d,
+                         n_components,
+                         Number,
+                         VectorizedArrayType>
+          phi_p(matrix_free, false, dof_no, quad_no, first_selected_component);
+
+        for (unsigned int face = begin; face < end; ++face)
+          {
+            phi_m.reinit(face);
+            phi_m.gather_evaluate(solution, EvaluationFlags::gradients);
+            phi_p.reinit(face);
+            phi_p.gather_evaluate(solution, EvaluationFlags::gradients);
+
+            VectorizedArrayType integral = 0.;
+            for (const unsigned int q : phi_m.quadrature_point_indices())
+              {
+                const auto jump = phi_m.get_normal_derivative(q) -
+                                  phi_p.get_normal_derivative(q);
+                if constexpr (n_components == 1)
+                  integral += jump * jump * phi_m.JxW(q);
+                else
+                  integral += jump.norm_square() * phi_m.JxW(q);
+              }
+            face_integrals[face] = integral;
+          }
+      },
+      16);
+
+    // then add the contributions of the faces to the cells on both sides.
+    // at a face with hanging nodes, the coarse cell collects the
+    // contributions of all of the small faces
+    const Triangulation<dim> &tria =
+      matrix_free.get_dof_handler(dof_no).get_triangulation();
+    error_per_cell.reinit(tria.n_active_cells());
+    for (unsigned int face = 0; face < n_inner_face_batches; ++face)
+      for (unsigned int v = 0;
+           v < matrix_free.n_active_entries_per_face_batch(face);
+           ++v)
+        for (const bool interior : {true, false})
+          {
+            const auto cell_and_face_no =
+              matrix_free.get_face_iterator(face, v, interior, dof_no);
+            error_per_cell(cell_and_face_no.first->active_cell_index()) +=
+              face_integrals[face][v];
+          }
+
+    for (const auto &cell : tria.active_cell_iterators())
+      {
+        float &error = error_per_cell(cell->active_cell_index());
+        if (cell->is_locally_owned())
+          error = std::sqrt(cell->diameter() / 24 * error);
+        else
+          error = 0;
+      }
+  }
+
+  template <int dim,
+            int fe_degree,
+            int n_q_points_1d,
+            int n_components,
+            typename Number,
+            typename VectorizedArrayType,
+            typename VectorType>
+  void
+  integrate_difference(
+    const MatrixFree<dim, Number, VectorizedArrayType> &matrix_free,
+    const VectorType                                   &solution,
+    const Function<dim, Number>                        &exact_solution,
+    Vector<float>                                      &difference,
+    const VectorTools::NormType                        &norm,
+    const unsigned int                                  dof_no,
+    const unsigned int                                  quad_no,
+    const unsigned int first_selected_component)
+  {
+    AssertThrow(norm == VectorTools::L2_norm ||
+                  norm == VectorTools::H1_seminorm ||
+                  norm == VectorTools::H1_norm,
+                ExcNotImplemented());
+    AssertDimension(exact_solution.n_components, n_components);
+
+    const bool need_values    = (norm != VectorTools::H1_seminorm);
+    const bool need_gradients = (norm != VectorTools::L2_norm);
+
+    EvaluationFlags::EvaluationFlags evaluation_flags =
+      EvaluationFlags::nothing;
+    if (need_values)
+      evaluation_flags |= EvaluationFlags::values;
+    if (need_gradients)
+      evaluation_flags |= EvaluationFlags::gradients;
+
+    difference.reinit(
+      matrix_free.get_dof_handler(dof_no).get_triangulation().n_active_cells());
+
+    // every cell batch only writes the entries of its own cells, so the
+    // batches can be processed in parallel
+    parallel::apply_to_subranges(
+      0U,
+      matrix_free.n_cell_batches(),
+      [&](const unsigned int begin, const unsigned int end) {
+        FEEvaluation<dim,
+                     fe_degree,
+                     n_q_points_1d,
+                     n_components,
+                     Number,
+                     VectorizedArrayType>
+          phi(matrix_free, dof_no, quad_no, first_selected_component);
+
+        std::vector<Point<dim>>                          points;
+        std::vector<Number>                              values;
+        std::vector<Vector<Number>>                      vector_values;
+        std::vector<Tensor<1, dim, Number>>              gradients;
+        std::vector<std::vector<Tensor<1, dim, Number>>> vector_gradients;
+
+        for (unsigned int cell = begin; cell < end; ++cell)
+          {
+            phi.reinit(cell);
+            phi.gather_evaluate(solution, evaluation_flags);
+
+            // evaluate the exact solution in the quadrature points of all
+            // cells of the batch with a single call
+            const unsigned int n_lanes =
+              matrix_free.n_active_entries_per_cell_batch(cell);
+            points.resize(phi.n_q_points * n_lanes);
+            for (const unsigned int q : phi.quadrature_point_indices())
+              {
+                const auto point_batch = phi.quadrature_point(q);
+                for (unsigned int v = 0; v < n_lanes; ++v)
+                  for (unsigned int d = 0; d < dim; ++d)
+                    points[q * n_lanes + v][d] = point_batch[d][v];
+              }
+
+            if constexpr (n_components == 1)
+              {
+                if (need_values)
+                  {
+                    values.resize(points.size());
+                    exact_solution.value_list(points, values);
+                  }
+                if (need_gradients)
+                  {
+                    gradients.resize(points.size());
+                    exact_solution.gradient_list(points, gradients);
+                  }
+              }
+            else
+              {
+                if (need_values)
+                  {
+                    vector_values.resize(points.size(),
+                                         Vector<Number>(n_components));
+                    exact_solution.vector_value_list(points, vector_values);
+                  }
+                if (need_gradients)
+                  {
+                    vector_gradients.resize(
+                      points.size(),
+                      std::vector<Tensor<1, dim, Number>>(n_components));
+                    exact_solution.vector_gradient_list(points,
+                                                        vector_gradients);
+                  }
+              }
+
+            VectorizedArrayType cell_error = 0.;
+            for (const unsigned int q : phi.quadrature_point_indices())
+              {
+                VectorizedArrayType point_error = 0.;
+                if (need_values)
+                  {
+                    const auto value = phi.get_value(q);
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      {
+                        VectorizedArrayType error = 0.;
+                        if constexpr (n_components == 1)
+                          {
+                            for (unsigned int v = 0; v < n_lanes; ++v)
+                              error[v] = values[q * n_lanes + v];
+                            error -= value;
+                          }
+                        else
+                          {
+                            for (unsigned int v = 0; v < n_lanes; ++v)
+                              error[v] = vector_values[q * n_lanes + v](c);
+                            error -= value[c];
+                          }
+                        point_error += error * error;
+                      }
+                  }
+                if (need_gradients)
+                  {
+                    const auto gradient = phi.get_gradient(q);
+                    for (unsigned int c = 0; c < n_components; ++c)
+                      for (unsigned int d = 0; d < dim; ++d)
+                        {
+                          VectorizedArrayType error = 0.;
+                          if constexpr (n_components == 1)
+                            {
+                              for (unsigned int v = 0; v < n_lanes; ++v)
+                                error[v] = gradients[q * n_lanes + v][d];
+                              error -= gradient[d];
+                            }
+                          else
+                            {
+                              for (unsigned int v = 0; v < n_lanes; ++v)
+                                error[v] =
+                                  vector_gradients[q * n_lanes + v][c][d];
+                              error -= gradient[c][d];
+                            }
+                          point_error += error * error;
+                        }
+                  }
+                cell_error += point_error * phi.JxW(q);
+              }
+
+            for (unsigned int v = 0; v < n_lanes; ++v)
+              difference(
+                matrix_free.get_cell_iterator(cell, v, dof_no)
+                  ->active_cell_index()) = std::sqrt(cell_error[v]);
+          }
+      },
+      16);
+  }
+
 #endif // DOXYGEN
 
 } // namespace MatrixFreeTools
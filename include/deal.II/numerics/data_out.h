@@ -217,6 +217,11 @@ public:
    */
   DataOut();
 
+  /**
+   * Destructor.
+   */
+  virtual ~DataOut() override;
+
   /**
    * This is the central function of this class since it builds the list of
    * patches to be written by the low-level functions of the base class. A
@@ -319,6 +324,45 @@ public:
                 const unsigned int                          n_subdivisions = 0,
                 const CurvedCellRegion curved_region = curved_boundary);
 
+  /**
+   * Write the data vectors attached to this object in VTU format, using
+   * VTK's Lagrange cells of degree @p n_subdivisions (or the default number
+   * of subdivisions set via parse_parameters() if @p n_subdivisions is zero)
+   * for each of the selected cells. The result is the same file that
+   * build_patches() with @p mapping, @p n_subdivisions, and
+   * DataOut::curved_inner_cells followed by DataOutInterface::write_vtu()
+   * with DataOutBase::VtkFlags::write_higher_order_cells set would produce,
+   * but this function does not build patches: It evaluates the data vectors
+   * cell by cell while filling the arrays of the VTU file, one array at a
+   * time, and thereby avoids holding all output data in memory in the form
+   * of patches as well as in the form of the arrays written to the file.
+   * This is useful for high-order finite elements such as FE_Q and FE_DGQ,
+   * for which the output needs many subdivisions per cell. For these
+   * elements, choosing @p n_subdivisions equal to the polynomial degree
+   * represents the solution exactly on each cell.
+   *
+   * The locations of all points are computed by @p mapping. If the mapping
+   * is expensive to evaluate, consider using a MappingQCache, which computes
+   * the support points of the mapping only once.
+   *
+   * All other flags for VTU output are taken from the ones set via
+   * DataOutInterface::set_flags(). This includes the rounding of the data
+   * requested by DataOutBase::VtkFlags::n_significant_bits and
+   * DataOutBase::VtkFlags::quantization_tolerances.
+   * DataOutBase::VtkFlags::subdivision_tolerance is ignored, since all cells
+   * are written as Lagrange cells with @p n_subdivisions. This function does
+   * not build or change patches; in particular, the other output functions
+   * of this class still require a call to build_patches().
+   *
+   * @note This function supports data vectors added without a
+   *   DataPostprocessor, with real values, and on DoFHandler objects without
+   *   hp-capabilities, on meshes that consist of quadrilaterals or hexahedra.
+   */
+  void
+  write_vtu_higher_order(std::ostream                 &out,
+                         const Mapping<dim, spacedim> &mapping,
+                         const unsigned int n_subdivisions = 0) const;
+
   /**
    * A function that allows selecting for which cells output should be
    * generated. This function takes two arguments, both `std::function`
@@ -416,7 +460,82 @@ public:
   std::pair<FirstCellFunctionType, NextCellFunctionType>
   get_cell_selection() const;
 
+  /**
+   * Enable or disable the caching of the geometric part of the patches.
+   *
+   * When writing output for many time steps of a simulation on a mesh that
+   * does not change, a substantial part of the work of build_patches() goes
+   * into determining the cells to output, their neighbors, the positions of
+   * their vertices and, for curved cells, the positions of all points of
+   * the patches, and a substantial part of the work of
+   * DataOutInterface::write_vtu() goes into encoding the points and the
+   * connectivity of the patches. If caching is enabled, build_patches()
+   * stores this geometric information and reuses it in later calls (on the
+   * same object, typically after clear_data_vectors() and adding the data
+   * vectors of the next time step) as long as the triangulation has not
+   * changed and build_patches() is called with the same number of
+   * subdivisions and region of curved cells. Only the data of the patches
+   * is then computed anew. Likewise, write_vtu() and
+   * write_vtu_with_pvtu_record() reuse the encoded points and cells of their
+   * previous output.
+   *
+   * Changes of the triangulation are detected through its signals. The
+   * cache is also discarded when the cell selection is changed through
+   * set_cell_selection(). On the other hand, there is no way to find out
+   * whether the mapping passed to build_patches() describes the same
+   * geometry as in a previous call. Caching must therefore not be enabled
+   * if the mapping changes over time, as for example for MappingQEulerian
+   * with a changing displacement field.
+   *
+   * Caching is disabled by default.
+   */
+  void
+  set_geometry_caching(const bool cache_geometry);
+
 private:
+  /**
+   * Whether the geometric part of the patches is stored for later calls of
+   * build_patches(). See set_geometry_caching().
+   */
+  bool cache_geometry;
+
+  /**
+   * The cells on which the patches stored in cached_patches were built,
+   * along with their active cell indices, in the order of the patches.
+   * Empty if there is no valid cache.
+   */
+  std::vector<std::pair<cell_iterator, unsigned int>> cached_cells;
+
+  /**
+   * The geometric part of the patches built by the last call of
+   * build_patches() if caching is enabled: The data tables of these patches
+   * only hold the positions of the points if those are available, whereas
+   * all other members are the same as those of the patches.
+   */
+  std::vector<DataOutBase::Patch<dim, spacedim>> cached_patches;
+
+  /**
+   * The number of subdivisions and the region of curved cells the cached
+   * patches were built with.
+   */
+  unsigned int     cached_n_subdivisions;
+  CurvedCellRegion cached_curved_cell_region;
+
+  /**
+   * The triangulation the cached patches were built on, and the connections
+   * to its signals that we use to discard the cache whenever the
+   * triangulation changes.
+   */
+  const Triangulation<dim, spacedim> *cached_triangulation;
+  boost::signals2::connection         tria_listener_any_change;
+  boost::signals2::connection         tria_listener_repartition;
+
+  /**
+   * Discard the cached geometry of the patches.
+   */
+  void
+  clear_geometry_cache();
+
   /**
    * A function object that is used to select what the first cell is going to
    * be on which to generate graphical output. See the set_cell_selection()
@@ -441,14 +560,16 @@ private:
    * object. All following are tied to particular values when calling
    * WorkStream::run(). The function does not take a CopyData object but
    * rather allocates one on its own stack for memory access efficiency
-   * reasons.
+   * reasons. If @p use_cached_geometry is set, the geometric part of the
+   * patch is taken from cached_patches rather than computed.
    */
   void
   build_one_patch(
     const std::pair<cell_iterator, unsigned int> *cell_and_index,
     internal::DataOutImplementation::ParallelData<dim, spacedim> &scratch_data,
     const unsigned int     n_subdivisions,
-    const CurvedCellRegion curved_cell_region);
+    const CurvedCellRegion curved_cell_region,
+    const bool             use_cached_geometry);
 };
 
 
@@ -990,6 +990,13 @@ public:
   get_patches() const override;
 
 protected:
+  /**
+   * Move the patches out of this object, see
+   * DataOutInterface::release_patches().
+   */
+  virtual std::vector<Patch>
+  release_patches() override;
+
   /**
    * Virtual function through which the names of data sets are obtained by the
    * output functions of the base class.
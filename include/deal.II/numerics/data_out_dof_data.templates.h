@@ -2363,6 +2363,17 @@ DataOut_DoFData<dim, patch_dim, spacedim, patch_spacedim>::get_patches() const
 
 
 
+template <int dim, int patch_dim, int spacedim, int patch_spacedim>
+std::vector<dealii::DataOutBase::Patch<patch_dim, patch_spacedim>>
+DataOut_DoFData<dim, patch_dim, spacedim, patch_spacedim>::release_patches()
+{
+  std::vector<Patch> released_patches;
+  released_patches.swap(patches);
+  return released_patches;
+}
+
+
+
 template <int dim, int patch_dim, int spacedim, int patch_spacedim>
 std::vector<std::shared_ptr<dealii::hp::FECollection<dim, spacedim>>>
 DataOut_DoFData<dim, patch_dim, spacedim, patch_spacedim>::get_fes() const
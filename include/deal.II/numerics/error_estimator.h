@@ -128,16 +128,22 @@ namespace hp
  * elements, it is necessary to utilize higher order quadrature
  * formulae with `fe.degree+1` Gauss points.
  *
- * We store the contribution of each face in a @p map, as provided by the C++
- * standard library, with the iterator pointing to that face being the key
- * into the map. When looping the second time over all cells, we have to sum
+ * We store the contribution of each face in an array indexed by the index of
+ * the face, which the threads working on different cells can write into
+ * without synchronization since each face is treated by exactly one of its
+ * adjacent cells. When looping the second time over all cells, we have to sum
  * up the contributions of the faces and take the square root. For the Kelly
  * estimator, the multiplication with $\frac {h_K}{24}$ is done in the second
  * loop. By doing so we avoid problems to decide with which $h_K$ to multiply,
  * that of the cell on the one or that of the cell on the other side of the
- * face. Whereas for the hp-estimator the @p map stores integrals multiplied
+ * face. Whereas for the hp-estimator the array stores integrals multiplied
  * by $\frac {h_F}{2p_F}$, which are then summed in the second loop.
  *
+ * For problems solved with matrix-free methods,
+ * MatrixFreeTools::estimate_kelly_error() computes the Kelly indicator of this
+ * class with FEFaceEvaluation, which is considerably faster for high
+ * polynomial degrees.
+ *
  * $h_K$ ($h_F$) is taken to be the greatest length of the diagonals of the cell
  * (face). For more or less uniform cells (faces) without deformed angles,
  * this coincides with the diameter of the cell (face).
@@ -18,6 +18,7 @@
 
 #include <deal.II/base/config.h>
 
+#include <deal.II/base/array_view.h>
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/numbers.h>
 #include <deal.II/base/quadrature.h>
@@ -296,39 +297,59 @@ namespace internal
 
 
   /**
-   * Copy data from the local_face_integrals map of a single ParallelData
-   * object into a global such map. This is the copier stage of a WorkStream
-   * pipeline.
+   * Storage for the integrated jumps of the gradients on all faces of a
+   * triangulation, one value per face and solution vector. The values of a
+   * face are stored contiguously at the position given by the index of the
+   * face, so that looking them up does not require a search.
+   *
+   * Every face is integrated by exactly one of the cells adjacent to it (see
+   * estimate_one_cell()), so the worker functions running on several threads
+   * can write into the same object without synchronization. Entries of faces
+   * that have not been integrated are negative.
    */
-  template <int dim, int spacedim>
-  void
-  copy_local_to_global(
-    const std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-                   std::vector<double>> &local_face_integrals,
-    std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-             std::vector<double>>       &face_integrals)
+  class FaceIntegrals
   {
-    // now copy locally computed elements into the global map
-    for (typename std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-                           std::vector<double>>::const_iterator p =
-           local_face_integrals.begin();
-         p != local_face_integrals.end();
-         ++p)
-      {
-        // double check that the element does not already exists in the
-        // global map
-        Assert(face_integrals.find(p->first) == face_integrals.end(),
-               ExcInternalError());
+  public:
+    /**
+     * Constructor. Allocate storage for @p n_faces faces and mark all entries
+     * as not yet computed.
+     */
+    FaceIntegrals(const unsigned int n_faces,
+                  const unsigned int n_solution_vectors)
+      : n_solution_vectors(n_solution_vectors)
+      , values(static_cast<std::size_t>(n_faces) * n_solution_vectors, -1.)
+    {}
 
-        for (unsigned int i = 0; i < p->second.size(); ++i)
-          {
-            Assert(numbers::is_finite(p->second[i]), ExcInternalError());
-            Assert(p->second[i] >= 0, ExcInternalError());
-          }
+    /**
+     * Return the integrals on the given face, one for each solution vector.
+     */
+    template <typename FaceIterator>
+    ArrayView<double>
+    operator[](const FaceIterator &face)
+    {
+      AssertIndexRange(static_cast<std::size_t>(face->index()) *
+                         n_solution_vectors,
+                       values.size());
+      return make_array_view(values.data() +
+                               static_cast<std::size_t>(face->index()) *
+                                 n_solution_vectors,
+                             values.data() +
+                               static_cast<std::size_t>(face->index() + 1) *
+                                 n_solution_vectors);
+    }
+
+  private:
+    /**
+     * The number of solution vectors, i.e., the number of values per face.
+     */
+    const unsigned int n_solution_vectors;
+
+    /**
+     * The integrals of all faces.
+     */
+    std::vector<double> values;
+  };
 
-        face_integrals[p->first] = p->second;
-      }
-  }
 
 
   /**
@@ -336,11 +357,12 @@ namespace internal
    * ParallelData.
    */
   template <int dim, int spacedim, typename number>
-  std::vector<double>
+  void
   integrate_over_face(
     ParallelData<dim, spacedim, number>                     &parallel_data,
     const typename DoFHandler<dim, spacedim>::face_iterator &face,
-    dealii::hp::FEFaceValues<dim, spacedim> &fe_face_values_cell)
+    dealii::hp::FEFaceValues<dim, spacedim> &fe_face_values_cell,
+    const ArrayView<double>                 &face_integral)
   {
     const unsigned int n_q_points = parallel_data.psi[0].size(),
                        n_components =
@@ -468,7 +490,8 @@ namespace internal
       fe_face_values_cell.get_present_fe_values().get_JxW_values();
 
     // take the square of the phi[i] for integration, and sum up
-    std::vector<double> face_integral(n_solution_vectors, 0);
+    AssertDimension(face_integral.size(), n_solution_vectors);
+    std::fill(face_integral.begin(), face_integral.end(), 0.);
     for (unsigned int n = 0; n < n_solution_vectors; ++n)
       for (unsigned int component = 0; component < n_components; ++component)
         if (parallel_data.component_mask[component] == true)
@@ -476,8 +499,6 @@ namespace internal
             face_integral[n] += numbers::NumberTraits<number>::abs_square(
                                   parallel_data.phi[n][p][component]) *
                                 parallel_data.JxW_values[p];
-
-    return face_integral;
   }
 
   /**
@@ -656,8 +677,7 @@ namespace internal
   integrate_over_regular_face(
     const ArrayView<const ReadVector<Number> *> &solutions,
     ParallelData<dim, spacedim, Number>         &parallel_data,
-    std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-             std::vector<double>>               &local_face_integrals,
+    FaceIntegrals                               &face_integrals,
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     const unsigned int                                              face_no,
     dealii::hp::FEFaceValues<dim, spacedim> &fe_face_values_cell,
@@ -730,11 +750,14 @@ namespace internal
       }
 
     // now go to the generic function that does all the other things
-    local_face_integrals[face] =
-      integrate_over_face(parallel_data, face, fe_face_values_cell);
-
-    for (unsigned int i = 0; i < local_face_integrals[face].size(); ++i)
-      local_face_integrals[face][i] *= factor;
+    const ArrayView<double> face_integral = face_integrals[face];
+    integrate_over_face(parallel_data,
+                        face,
+                        fe_face_values_cell,
+                        face_integral);
+
+    for (double &integral : face_integral)
+      integral *= factor;
   }
 
 
@@ -749,8 +772,7 @@ namespace internal
   integrate_over_irregular_face(
     const ArrayView<const ReadVector<Number> *> &solutions,
     ParallelData<dim, spacedim, Number>         &parallel_data,
-    std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-             std::vector<double>>               &local_face_integrals,
+    FaceIntegrals                               &face_integrals,
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     const unsigned int                                              face_no,
     dealii::hp::FEFaceValues<dim, spacedim>    &fe_face_values,
@@ -822,33 +844,30 @@ namespace internal
         parallel_data.neighbor_normal_vectors =
           fe_subface_values.get_present_fe_values().get_normal_vectors();
 
-        local_face_integrals[neighbor_child->face(neighbor_neighbor)] =
-          integrate_over_face(parallel_data, face, fe_face_values);
-        for (unsigned int i = 0;
-             i < local_face_integrals[neighbor_child->face(neighbor_neighbor)]
-                   .size();
-             i++)
-          local_face_integrals[neighbor_child->face(neighbor_neighbor)][i] *=
-            factor;
+        const ArrayView<double> subface_integral =
+          face_integrals[neighbor_child->face(neighbor_neighbor)];
+        integrate_over_face(parallel_data,
+                            face,
+                            fe_face_values,
+                            subface_integral);
+        for (double &integral : subface_integral)
+          integral *= factor;
       }
 
     // finally loop over all subfaces to collect the contributions of the
     // subfaces and store them with the mother face
-    std::vector<double> sum(n_solution_vectors, 0);
+    const ArrayView<double> sum = face_integrals[face];
+    std::fill(sum.begin(), sum.end(), 0.);
     for (unsigned int subface_no = 0; subface_no < face->n_children();
          ++subface_no)
       {
-        Assert(local_face_integrals.find(face->child(subface_no)) !=
-                 local_face_integrals.end(),
-               ExcInternalError());
-        Assert(local_face_integrals[face->child(subface_no)][0] >= 0,
-               ExcInternalError());
+        const ArrayView<double> subface_integral =
+          face_integrals[face->child(subface_no)];
+        Assert(subface_integral[0] >= 0, ExcInternalError());
 
         for (unsigned int n = 0; n < n_solution_vectors; ++n)
-          sum[n] += local_face_integrals[face->child(subface_no)][n];
+          sum[n] += subface_integral[n];
       }
-
-    local_face_integrals[face] = sum;
   }
 
 
@@ -863,19 +882,13 @@ namespace internal
   estimate_one_cell(
     const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
     ParallelData<dim, spacedim, Number>         &parallel_data,
-    std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-             std::vector<double>>               &local_face_integrals,
+    FaceIntegrals                               &face_integrals,
     const ArrayView<const ReadVector<Number> *> &solutions,
     const typename KellyErrorEstimator<dim, spacedim>::Strategy strategy)
   {
-    const unsigned int n_solution_vectors = solutions.size();
-
     const types::subdomain_id subdomain_id = parallel_data.subdomain_id;
     const unsigned int        material_id  = parallel_data.material_id;
 
-    // empty our own copy of the local face integrals
-    local_face_integrals.clear();
-
     // loop over all faces of this cell
     for (const unsigned int face_no : cell->face_indices())
       {
@@ -903,14 +916,14 @@ namespace internal
 
         // if this face is part of the boundary but not of the neumann
         // boundary -> nothing to do. However, to make things easier when
-        // summing up the contributions of the faces of cells, we enter this
-        // face into the list of faces with contribution zero.
+        // summing up the contributions of the faces of cells, we set the
+        // contribution of this face to zero.
         if (face->at_boundary() &&
             (parallel_data.neumann_bc->find(face->boundary_id()) ==
              parallel_data.neumann_bc->end()))
           {
-            local_face_integrals[face] =
-              std::vector<double>(n_solution_vectors, 0.);
+            const ArrayView<double> face_integral = face_integrals[face];
+            std::fill(face_integral.begin(), face_integral.end(), 0.);
             continue;
           }
 
@@ -970,7 +983,7 @@ namespace internal
           // the integration of these both cases together
           integrate_over_regular_face(solutions,
                                       parallel_data,
-                                      local_face_integrals,
+                                      face_integrals,
                                       cell,
                                       face_no,
                                       parallel_data.fe_face_values_cell,
@@ -982,7 +995,7 @@ namespace internal
           // fit into the framework of the above function
           integrate_over_irregular_face(solutions,
                                         parallel_data,
-                                        local_face_integrals,
+                                        face_integrals,
                                         cell,
                                         face_no,
                                         parallel_data.fe_face_values_cell,
@@ -1204,13 +1217,12 @@ KellyErrorEstimator<dim, spacedim>::estimate(
 
   const unsigned int n_solution_vectors = solutions.size();
 
-  // Map of integrals indexed by the corresponding face. In this map we store
-  // the integrated jump of the gradient for each face.  At the end of the
-  // function, we again loop over the cells and collect the contributions of
-  // the different faces of the cell.
-  std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-           std::vector<double>>
-    face_integrals;
+  // Integrals indexed by the corresponding face. Here we store the integrated
+  // jump of the gradient for each face. At the end of the function, we again
+  // loop over the cells and collect the contributions of the different faces
+  // of the cell.
+  internal::FaceIntegrals face_integrals(
+    dof_handler.get_triangulation().n_raw_faces(), n_solution_vectors);
 
   // all the data needed in the error estimator by each of the threads is
   // gathered in the following structures
@@ -1226,31 +1238,24 @@ KellyErrorEstimator<dim, spacedim>::estimate(
     &neumann_bc,
     component_mask,
     coefficients);
-  std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-           std::vector<double>>
-    sample_local_face_integrals;
 
-  // now let's work on all those cells:
+  // now let's work on all those cells. every face is integrated by exactly
+  // one of the adjacent cells, so the workers can write their results
+  // directly into face_integrals and there is no need for a copier
   WorkStream::run(
     dof_handler.begin_active(),
     static_cast<typename DoFHandler<dim, spacedim>::active_cell_iterator>(
       dof_handler.end()),
-    [&solutions, strategy](
+    [&solutions, &face_integrals, strategy](
       const typename DoFHandler<dim, spacedim>::active_cell_iterator &cell,
       internal::ParallelData<dim, spacedim, Number> &parallel_data,
-      std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-               std::vector<double>>                 &local_face_integrals) {
+      int) {
       internal::estimate_one_cell(
-        cell, parallel_data, local_face_integrals, solutions, strategy);
-    },
-    [&face_integrals](
-      const std::map<typename DoFHandler<dim, spacedim>::face_iterator,
-                     std::vector<double>> &local_face_integrals) {
-      internal::copy_local_to_global<dim, spacedim>(local_face_integrals,
-                                                    face_integrals);
+        cell, parallel_data, face_integrals, solutions, strategy);
     },
+    std::function<void(const int)>(),
     parallel_data,
-    sample_local_face_integrals);
+    /* dummy CopyData object = */ 0);
 
   // finally add up the contributions of the faces for each cell
 
@@ -1277,9 +1282,8 @@ KellyErrorEstimator<dim, spacedim>::estimate(
         // loop over all faces of this cell
         for (const unsigned int face_no : cell->face_indices())
           {
-            Assert(face_integrals.find(cell->face(face_no)) !=
-                     face_integrals.end(),
-                   ExcInternalError());
+            const ArrayView<double> face_integral =
+              face_integrals[cell->face(face_no)];
             const double factor = internal::cell_factor<dim, spacedim>(
               cell, face_no, dof_handler, strategy);
 
@@ -1287,11 +1291,9 @@ KellyErrorEstimator<dim, spacedim>::estimate(
               {
                 // make sure that we have written a meaningful value into this
                 // slot
-                Assert(face_integrals[cell->face(face_no)][n] >= 0,
-                       ExcInternalError());
+                Assert(face_integral[n] >= 0, ExcInternalError());
 
-                (*errors[n])(present_cell) +=
-                  (face_integrals[cell->face(face_no)][n] * factor);
+                (*errors[n])(present_cell) += (face_integral[n] * factor);
               }
           }
 
@@ -0,0 +1,304 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#ifndef dealii_numerics_packed_rtree_h
+#define dealii_numerics_packed_rtree_h
+
+#include <deal.II/base/config.h>
+
+#include <deal.II/base/aligned_vector.h>
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/vectorization.h>
+
+#include <boost/container/small_vector.hpp>
+
+#include <array>
+#include <vector>
+
+
+DEAL_II_NAMESPACE_OPEN
+
+/**
+ * A static bounding volume hierarchy over a fixed set of BoundingBox
+ * objects, intended as a light-weight alternative to the R-tree returned by
+ * pack_rtree_of_indices() when the only queries of interest are of the kind
+ * "which boxes contain this point" or "which boxes intersect this box".
+ *
+ * The boxes are ordered by the sort-tile-recursive (STR) algorithm applied
+ * to their centers, and grouped into nodes of `fanout` consecutive entries,
+ * similar to the bulk loading used by pack_rtree(). Each level
+ * of the hierarchy is stored as a flat array in structure-of-arrays layout,
+ * i.e., the lower and upper corners of VectorizedArray::size() boxes are
+ * stored in one VectorizedArray per coordinate direction. A query therefore
+ * tests all children of a node with a handful of vectorized comparisons,
+ * instead of following one pointer per child as the boost::geometry
+ * implementation does. Unused lanes at the end of a node are filled with
+ * empty boxes that never intersect anything.
+ *
+ * The class does not allow modification of the set of boxes after
+ * construction; call reinit() to build a new hierarchy.
+ *
+ * The query functions write the indices of the matching boxes, i.e., their
+ * positions in the vector passed to the constructor, to an output iterator,
+ * in the same way as
+ * @code
+ * const auto tree = pack_rtree_of_indices(boxes);
+ * std::vector<unsigned int> indices;
+ * tree.query(boost::geometry::index::intersects(point),
+ *            std::back_inserter(indices));
+ * @endcode
+ * does for a boost R-tree. The order of the returned indices is unspecified.
+ * Using the present class, the same result is obtained by
+ * @code
+ * const PackedRTree<spacedim> tree(boxes);
+ * std::vector<unsigned int> indices;
+ * tree.query(point, std::back_inserter(indices));
+ * @endcode
+ *
+ * @ingroup data
+ */
+template <int spacedim>
+class PackedRTree
+{
+public:
+  /**
+   * The number of children of each node of the hierarchy. This is a
+   * multiple of the number of lanes of VectorizedArray<double>.
+   */
+  static constexpr unsigned int fanout = 8;
+
+  static_assert(fanout % VectorizedArray<double>::size() == 0,
+                "The fanout must be a multiple of the SIMD width.");
+
+  /**
+   * Default constructor. Creates an empty hierarchy.
+   */
+  PackedRTree() = default;
+
+  /**
+   * Constructor. Builds the hierarchy for the given @p boxes.
+   */
+  PackedRTree(const std::vector<BoundingBox<spacedim>> &boxes);
+
+  /**
+   * Discard the present hierarchy and build a new one for the given
+   * @p boxes.
+   */
+  void
+  reinit(const std::vector<BoundingBox<spacedim>> &boxes);
+
+  /**
+   * Return the number of boxes stored in the hierarchy.
+   */
+  unsigned int
+  size() const;
+
+  /**
+   * Return whether the hierarchy contains no boxes.
+   */
+  bool
+  empty() const;
+
+  /**
+   * Write the indices of all boxes that contain the point @p p (including
+   * the boundary of the box) to @p out.
+   */
+  template <typename OutputIterator>
+  void
+  query(const Point<spacedim> &p, OutputIterator out) const;
+
+  /**
+   * Write the indices of all boxes that intersect the box @p box (including
+   * boxes that merely touch it) to @p out.
+   */
+  template <typename OutputIterator>
+  void
+  query(const BoundingBox<spacedim> &box, OutputIterator out) const;
+
+  /**
+   * Return an estimate for the memory consumption, in bytes, of this
+   * object.
+   */
+  std::size_t
+  memory_consumption() const;
+
+private:
+  /**
+   * The corners of VectorizedArray<double>::size() boxes in
+   * structure-of-arrays layout.
+   */
+  struct BoxBatch
+  {
+    std::array<VectorizedArray<double>, spacedim> lower;
+    std::array<VectorizedArray<double>, spacedim> upper;
+  };
+
+  /**
+   * Walk the hierarchy from the root and write the indices of all leaves
+   * for which @p intersects returns a nonzero lane to @p out. The functor
+   * is called with one BoxBatch at a time and returns a VectorizedArray
+   * with value one in the lanes that intersect the query geometry and zero
+   * otherwise.
+   */
+  template <typename IntersectFunction, typename OutputIterator>
+  void
+  traverse(const IntersectFunction &intersects, OutputIterator out) const;
+
+  /**
+   * The levels of the hierarchy, starting with the leaves. Each level is
+   * padded to a multiple of `fanout` entries.
+   */
+  std::vector<AlignedVector<BoxBatch>> levels;
+
+  /**
+   * The index of the box, in the vector passed to reinit(), that is stored
+   * at the given position of the leaf level.
+   */
+  std::vector<unsigned int> leaf_indices;
+};
+
+
+
+#ifndef DOXYGEN
+
+template <int spacedim>
+inline unsigned int
+PackedRTree<spacedim>::size() const
+{
+  return leaf_indices.size();
+}
+
+
+
+template <int spacedim>
+inline bool
+PackedRTree<spacedim>::empty() const
+{
+  return leaf_indices.empty();
+}
+
+
+
+template <int spacedim>
+template <typename IntersectFunction, typename OutputIterator>
+inline void
+PackedRTree<spacedim>::traverse(const IntersectFunction &intersects,
+                                OutputIterator           out) const
+{
+  if (levels.empty())
+    return;
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+
+  // Stack of nodes still to be visited, each given by its level and the
+  // position of its first child on that level. The depth-first traversal
+  // keeps at most (fanout - 1) entries per level on the stack.
+  boost::container::small_vector<std::pair<unsigned int, unsigned int>, 64>
+    stack;
+  stack.emplace_back(levels.size() - 1, 0);
+
+  while (!stack.empty())
+    {
+      const auto [level, first_entry] = stack.back();
+      stack.pop_back();
+
+      const AlignedVector<BoxBatch> &batches = levels[level];
+      for (unsigned int b = first_entry / n_lanes;
+           b < (first_entry + fanout) / n_lanes;
+           ++b)
+        {
+          const VectorizedArray<double> hit = intersects(batches[b]);
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            if (hit[v] != 0.)
+              {
+                const unsigned int entry = b * n_lanes + v;
+                if (level == 0)
+                  *out++ = leaf_indices[entry];
+                else
+                  stack.emplace_back(level - 1, entry * fanout);
+              }
+        }
+    }
+}
+
+
+
+template <int spacedim>
+template <typename OutputIterator>
+inline void
+PackedRTree<spacedim>::query(const Point<spacedim> &p,
+                             OutputIterator         out) const
+{
+  std::array<VectorizedArray<double>, spacedim> point;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    point[d] = p[d];
+
+  const VectorizedArray<double> one  = 1.;
+  const VectorizedArray<double> zero = 0.;
+
+  traverse(
+    [&](const BoxBatch &batch) {
+      VectorizedArray<double> hit = one;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+            batch.lower[d], point[d], hit, zero);
+          hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+            point[d], batch.upper[d], hit, zero);
+        }
+      return hit;
+    },
+    out);
+}
+
+
+
+template <int spacedim>
+template <typename OutputIterator>
+inline void
+PackedRTree<spacedim>::query(const BoundingBox<spacedim> &box,
+                             OutputIterator               out) const
+{
+  std::array<VectorizedArray<double>, spacedim> lower, upper;
+  for (unsigned int d = 0; d < spacedim; ++d)
+    {
+      lower[d] = box.get_boundary_points().first[d];
+      upper[d] = box.get_boundary_points().second[d];
+    }
+
+  const VectorizedArray<double> one  = 1.;
+  const VectorizedArray<double> zero = 0.;
+
+  traverse(
+    [&](const BoxBatch &batch) {
+      VectorizedArray<double> hit = one;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+            batch.lower[d], upper[d], hit, zero);
+          hit = compare_and_apply_mask<SIMDComparison::less_than_or_equal>(
+            lower[d], batch.upper[d], hit, zero);
+        }
+      return hit;
+    },
+    out);
+}
+
+#endif // DOXYGEN
+
+DEAL_II_NAMESPACE_CLOSE
+
+#endif
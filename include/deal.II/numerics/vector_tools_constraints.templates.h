@@ -1479,8 +1479,8 @@ namespace VectorTools
                   normal[d]         = 1.;
                 }
             AssertIndexRange(constrained_index, dim);
-            const std::vector<std::pair<types::global_dof_index, double>>
-              *constrained = no_normal_flux_constraints.get_constraint_entries(
+            const auto *constrained =
+              no_normal_flux_constraints.get_constraint_entries(
                 dofs[constrained_index]);
             // find components to which this index is constrained to
             Assert(constrained != nullptr, ExcInternalError());
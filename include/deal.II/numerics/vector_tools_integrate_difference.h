@@ -73,6 +73,12 @@ namespace VectorTools
    * VectorTools::compute_global_error() with the output vector computed with
    * this function.
    *
+   * The cells are processed in parallel on several threads using the
+   * WorkStream framework. The functions @p exact_solution and @p weight must
+   * therefore allow being evaluated concurrently from different threads. For
+   * matrix-free solvers, MatrixFreeTools::integrate_difference() computes the
+   * $L_2$ and $H^1$ errors with FEEvaluation instead.
+   *
    * @param[in] mapping The mapping that is used when integrating the
    * difference $u-u_h$.
    * @param[in] dof The DoFHandler object that describes the finite element
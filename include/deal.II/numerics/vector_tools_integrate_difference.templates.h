@@ -18,6 +18,8 @@
 #define dealii_vector_tools_integrate_difference_templates_h
 
 
+#include <deal.II/base/work_stream.h>
+
 #include <deal.II/hp/fe_values.h>
 
 #include <deal.II/lac/block_vector.h>
@@ -512,37 +514,52 @@ namespace VectorTools
                                                 q,
                                                 update_flags);
 
-      // loop over all cells
-      for (const auto &cell : dof.active_cell_iterators())
-        if (cell->is_locally_owned())
-          {
-            // initialize for this cell
-            data.x_fe_values.reinit(cell);
-
-            const dealii::FEValues<dim, spacedim> &fe_values =
-              data.x_fe_values.get_present_fe_values();
-            const unsigned int n_q_points = fe_values.n_quadrature_points;
-            data.resize_vectors(n_q_points, n_components);
-
-            if (update_flags & update_values)
-              fe_values.get_function_values(fe_function, data.function_values);
-            if (update_flags & update_gradients)
-              fe_values.get_function_gradients(fe_function,
-                                               data.function_grads);
-
-            difference(cell->active_cell_index()) =
-              integrate_difference_inner<dim, spacedim, Number>(exact_solution,
-                                                                norm,
-                                                                weight,
-                                                                update_flags,
-                                                                exponent,
-                                                                n_components,
-                                                                data);
-          }
-        else
-          // the cell is a ghost cell or is artificial. write a zero into the
-          // corresponding value of the returned vector
-          difference(cell->active_cell_index()) = 0;
+      // loop over all cells in parallel. every cell only writes its own entry
+      // of the output vector, so there is nothing to copy into a global
+      // object and we do not need a copier
+      using CellIterator =
+        typename DoFHandler<dim, spacedim>::active_cell_iterator;
+      WorkStream::run(
+        dof.begin_active(),
+        static_cast<CellIterator>(dof.end()),
+        [&](const CellIterator                   &cell,
+            IDScratchData<dim, spacedim, Number> &scratch_data,
+            int) {
+          if (cell->is_locally_owned())
+            {
+              // initialize for this cell
+              scratch_data.x_fe_values.reinit(cell);
+
+              const dealii::FEValues<dim, spacedim> &fe_values =
+                scratch_data.x_fe_values.get_present_fe_values();
+              const unsigned int n_q_points = fe_values.n_quadrature_points;
+              scratch_data.resize_vectors(n_q_points, n_components);
+
+              if (update_flags & update_values)
+                fe_values.get_function_values(fe_function,
+                                              scratch_data.function_values);
+              if (update_flags & update_gradients)
+                fe_values.get_function_gradients(fe_function,
+                                                 scratch_data.function_grads);
+
+              difference(cell->active_cell_index()) =
+                integrate_difference_inner<dim, spacedim, Number>(
+                  exact_solution,
+                  norm,
+                  weight,
+                  update_flags,
+                  exponent,
+                  n_components,
+                  scratch_data);
+            }
+          else
+            // the cell is a ghost cell or is artificial. write a zero into
+            // the corresponding value of the returned vector
+            difference(cell->active_cell_index()) = 0;
+        },
+        std::function<void(const int)>(),
+        data,
+        /* dummy CopyData object = */ 0);
     }
 
   } // namespace internal
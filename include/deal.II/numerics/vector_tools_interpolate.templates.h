@@ -208,6 +208,28 @@ namespace VectorTools
     }
 
 
+    // Return whether apply_transform() needs the Jacobians of the mapping
+    // to transform function values for the given finite element, i.e.,
+    // whether the element or one of its base elements is Hcurl or Hdiv
+    // conforming.
+    template <int dim, int spacedim>
+    bool
+    transform_needs_jacobians(const FiniteElement<dim, spacedim> &fe)
+    {
+      if (const auto *system =
+            dynamic_cast<const FESystem<dim, spacedim> *>(&fe))
+        {
+          for (unsigned int i = 0; i < system->n_base_elements(); ++i)
+            if (transform_needs_jacobians(system->base_element(i)))
+              return true;
+          return false;
+        }
+      else
+        return (fe.conforming_space == FiniteElementData<dim>::Hcurl) ||
+               (fe.conforming_space == FiniteElementData<dim>::Hdiv);
+    }
+
+
     // Internal implementation of interpolate that takes a generic functor
     // function such that function(cell) is of type
     // Function<spacedim, typename VectorType::value_type>*
@@ -311,13 +333,15 @@ namespace VectorTools
       // An FEValues object to evaluate (generalized) support point
       // locations as well as Jacobians and their inverses.
       // The latter are only needed for Hcurl or Hdiv conforming elements,
-      // but we'll just always include them.
+      // so we skip computing them for the common case of Lagrange elements.
+      UpdateFlags update_flags = update_quadrature_points;
+      for (unsigned int fe_index = 0; fe_index < fe.size(); ++fe_index)
+        if (transform_needs_jacobians(fe[fe_index]))
+          update_flags |= update_jacobians | update_inverse_jacobians;
       hp::FEValues<dim, spacedim> fe_values(mapping_collection,
                                             fe,
                                             support_quadrature,
-                                            update_quadrature_points |
-                                              update_jacobians |
-                                              update_inverse_jacobians);
+                                            update_flags);
 
       //
       // Now loop over all locally owned, active cells.
@@ -103,7 +103,14 @@ namespace VectorTools
    * for the mass operator. In the case of hypercube cells, a
    * QGauss(fe_degree+2) object is used for the mass operator. You should
    * therefore make sure that the given quadrature formula is sufficiently
-   * accurate for creating the right-hand side.
+   * accurate for creating the right-hand side. If the given quadrature
+   * formula is the tensor product of a single one-dimensional formula (as,
+   * e.g., QGauss), the right-hand side is also evaluated with sum
+   * factorization, and the function is evaluated for all points of a batch of
+   * cells with a single call to Function::value_list() or
+   * Function::vector_value_list(). For discontinuous elements such as FE_DGQ,
+   * the inverses of the cell mass matrices are used as preconditioner, so
+   * that the linear system is solved in a single iteration on affine meshes.
    *
    * Otherwise, only serial Triangulations are supported and the @ref GlossMassMatrix "mass matrix"
    * is assembled using MatrixTools::create_mass_matrix. The given
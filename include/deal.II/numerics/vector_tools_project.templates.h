@@ -152,6 +152,65 @@ namespace VectorTools
 
 
 
+    /**
+     * Preconditioner for the mass matrix of discontinuous tensor-product
+     * elements that applies the inverse of the cell mass matrices with
+     * MatrixFreeOperators::CellwiseInverseMassMatrix. The quadrature formula
+     * with index @p quad_index needs to be a Gauss formula with as many
+     * points per direction as the element has degrees of freedom. On affine
+     * cells, this is the exact inverse of the mass matrix.
+     */
+    template <int dim, int components, typename Number>
+    class CellwiseInverseMassPreconditioner
+    {
+    public:
+      CellwiseInverseMassPreconditioner(
+        const MatrixFree<dim, Number> &matrix_free,
+        const unsigned int             quad_index)
+        : matrix_free(matrix_free)
+        , quad_index(quad_index)
+      {}
+
+      void
+      vmult(LinearAlgebra::distributed::Vector<Number>       &dst,
+            const LinearAlgebra::distributed::Vector<Number> &src) const
+      {
+        matrix_free.cell_loop(
+          &CellwiseInverseMassPreconditioner::local_apply, this, dst, src);
+      }
+
+    private:
+      void
+      local_apply(const MatrixFree<dim, Number>                    &data,
+                  LinearAlgebra::distributed::Vector<Number>       &dst,
+                  const LinearAlgebra::distributed::Vector<Number> &src,
+                  const std::pair<unsigned int, unsigned int> &cell_range) const
+      {
+        FEEvaluation<dim, -1, 0, components, Number> phi(data,
+                                                          cell_range,
+                                                          0,
+                                                          quad_index);
+        MatrixFreeOperators::CellwiseInverseMassMatrix<dim,
+                                                       -1,
+                                                       components,
+                                                       Number>
+          inverse_mass(phi);
+        for (unsigned int cell = cell_range.first; cell < cell_range.second;
+             ++cell)
+          {
+            phi.reinit(cell);
+            phi.read_dof_values(src);
+            inverse_mass.apply(phi.begin_dof_values(), phi.begin_dof_values());
+            phi.set_dof_values(dst);
+          }
+      }
+
+      const MatrixFree<dim, Number> &matrix_free;
+      const unsigned int             quad_index;
+    };
+
+
+
     /*
      * MatrixFree implementation of project() for an arbitrary number of
      * components of the FiniteElement.
@@ -194,16 +253,53 @@ namespace VectorTools
         // quadrature rule (which is guaranteed to be tabulated).
         quadrature_mf = quadrature;
 
+      // the right hand side is integrated with the quadrature formula given
+      // by the user. if that formula is the tensor product of a single
+      // one-dimensional formula, we can also evaluate it with sum
+      // factorization by giving it to MatrixFree as a second quadrature
+      // formula. otherwise, fall back to create_right_hand_side()
+      bool use_matrix_free_rhs =
+        (dof.get_fe(0).reference_cell() ==
+         ReferenceCells::get_hypercube<dim>()) &&
+        quadrature.is_tensor_product();
+      if (use_matrix_free_rhs)
+        for (unsigned int d = 1; d < dim; ++d)
+          if (!(quadrature.get_tensor_basis()[d] ==
+                quadrature.get_tensor_basis()[0]))
+            use_matrix_free_rhs = false;
+
+      std::vector<Quadrature<dim>> quadratures(1, quadrature_mf);
+      if (use_matrix_free_rhs)
+        quadratures.push_back(quadrature);
+
+      // for discontinuous elements on hypercubes, the mass matrix is block
+      // diagonal and the blocks can be inverted with sum factorization.
+      // this needs a Gauss formula with degree+1 points per direction
+      const FiniteElement<dim, spacedim> &fe = dof.get_fe(0);
+      const bool                          is_discontinuous =
+        (fe.reference_cell() == ReferenceCells::get_hypercube<dim>()) &&
+        (fe.n_dofs_per_cell() == fe.template n_dofs_per_object<dim>()) &&
+        (fe.n_base_elements() == 1);
+      const unsigned int inverse_mass_quad_index = quadratures.size();
+      if (is_discontinuous)
+        quadratures.push_back(QGauss<dim>(fe.degree + 1));
+
       // set up mass matrix and right hand side
       typename MatrixFree<dim, Number>::AdditionalData additional_data;
       additional_data.tasks_parallel_scheme =
         MatrixFree<dim, Number>::AdditionalData::partition_color;
       additional_data.mapping_update_flags =
         (update_values | update_JxW_values);
+      if (use_matrix_free_rhs)
+        additional_data.mapping_update_flags |= update_quadrature_points;
       std::shared_ptr<MatrixFree<dim, Number>> matrix_free(
         new MatrixFree<dim, Number>());
-      matrix_free->reinit(
-        mapping, dof, constraints, quadrature_mf, additional_data);
+      matrix_free->reinit(mapping,
+                          std::vector<const DoFHandler<dim, spacedim> *>{&dof},
+                          std::vector<const AffineConstraints<Number> *>{
+                            &constraints},
+                          quadratures,
+                          additional_data);
       using MatrixType = MatrixFreeOperators::MassOperator<
         dim,
         -1,
@@ -213,6 +309,25 @@ namespace VectorTools
       MatrixType mass_matrix;
       mass_matrix.initialize(matrix_free);
 
+      // the cell-wise inverse only works for elements with a tensor-product
+      // basis of the full degree and without constraints between the cells
+      bool use_cellwise_inverse = false;
+      if (is_discontinuous)
+        {
+          const auto &shape_info =
+            matrix_free->get_shape_info(0, inverse_mass_quad_index);
+          use_cellwise_inverse =
+            (shape_info.element_type <=
+             ::dealii::internal::MatrixFreeFunctions::
+               tensor_symmetric_no_collocation) &&
+            (shape_info.dofs_per_component_on_cell ==
+             Utilities::pow(fe.degree + 1, dim)) &&
+            (constraints.n_constraints() == 0);
+        }
+      use_cellwise_inverse =
+        bool(Utilities::MPI::min(int(use_cellwise_inverse),
+                                 work_result.get_mpi_communicator()));
+
       // For most elements we want to use the lumped mass matrix as the
       // preconditioner. However, this isn't going to work with a lot of
       // elements, like almost everything not defined on hypercubes: in that
@@ -266,10 +381,13 @@ namespace VectorTools
         bool(Utilities::MPI::min(int(use_lumped),
                                  work_result.get_mpi_communicator()));
 
-      if (use_lumped)
-        mass_matrix.compute_lumped_diagonal();
-      else
-        mass_matrix.compute_diagonal();
+      if (use_cellwise_inverse == false)
+        {
+          if (use_lumped)
+            mass_matrix.compute_lumped_diagonal();
+          else
+            mass_matrix.compute_diagonal();
+        }
 
       LinearAlgebra::distributed::Vector<Number> rhs, inhomogeneities;
       matrix_free->initialize_dof_vector(work_result);
@@ -278,10 +396,66 @@ namespace VectorTools
       constraints.distribute(inhomogeneities);
       inhomogeneities *= -1.;
 
-      {
+      if (use_matrix_free_rhs)
+        {
+          // evaluate the function in the quadrature points of all the cells
+          // of a batch with one call, then integrate with sum factorization
+          FEEvaluation<dim, -1, 0, components, Number> phi(*matrix_free, 0, 1);
+          std::vector<Point<spacedim>> points;
+          std::vector<Number>          values;
+          std::vector<Vector<Number>>  vector_values;
+          for (unsigned int cell = 0; cell < matrix_free->n_cell_batches();
+               ++cell)
+            {
+              phi.reinit(cell);
+              const unsigned int n_lanes =
+                matrix_free->n_active_entries_per_cell_batch(cell);
+              points.resize(phi.n_q_points * n_lanes);
+              for (const unsigned int q : phi.quadrature_point_indices())
+                {
+                  const auto point_batch = phi.quadrature_point(q);
+                  for (unsigned int v = 0; v < n_lanes; ++v)
+                    for (unsigned int d = 0; d < dim; ++d)
+                      points[q * n_lanes + v][d] = point_batch[d][v];
+                }
+
+              if constexpr (components == 1)
+                {
+                  values.resize(points.size());
+                  function.value_list(points, values);
+                  for (const unsigned int q : phi.quadrature_point_indices())
+                    {
+                      VectorizedArray<Number> value = 0.;
+                      for (unsigned int v = 0; v < n_lanes; ++v)
+                        value[v] = values[q * n_lanes + v];
+                      phi.submit_value(value, q);
+                    }
+                }
+              else
+                {
+                  vector_values.resize(points.size(),
+                                       Vector<Number>(components));
+                  function.vector_value_list(points, vector_values);
+                  for (const unsigned int q : phi.quadrature_point_indices())
+                    {
+                      Tensor<1, components, VectorizedArray<Number>> value;
+                      for (unsigned int v = 0; v < n_lanes; ++v)
+                        for (unsigned int c = 0; c < components; ++c)
+                          value[c][v] = vector_values[q * n_lanes + v](c);
+                      phi.submit_value(value, q);
+                    }
+                }
+
+              phi.integrate(::dealii::EvaluationFlags::values);
+              phi.distribute_local_to_global(rhs);
+            }
+          rhs.compress(VectorOperation::add);
+        }
+      else
         create_right_hand_side(
           mapping, dof, quadrature, function, rhs, constraints);
 
+      {
         // account for inhomogeneous constraints
         inhomogeneities.update_ghost_values();
         FEEvaluation<dim, -1, 0, components, Number> phi(*matrix_free);
@@ -307,16 +481,29 @@ namespace VectorTools
       // FE_Q_Hierarchical for degree higher than three.
       ReductionControl        control(6 * rhs.size(), 0., 1e-12, false, false);
       SolverCG<decltype(rhs)> cg(control);
-      const DiagonalMatrix<decltype(rhs)> &preconditioner =
-        use_lumped ? *mass_matrix.get_matrix_lumped_diagonal_inverse() :
-                     *mass_matrix.get_matrix_diagonal_inverse();
+      if (use_cellwise_inverse)
+        {
+          // on affine cells, the preconditioner is the exact inverse of the
+          // mass matrix and CG converges in one iteration. on other cells,
+          // the Gauss formula with degree+1 points only approximates the
+          // mass matrix, so we still solve with the full mass operator
+          const CellwiseInverseMassPreconditioner<dim, components, Number>
+            preconditioner(*matrix_free, inverse_mass_quad_index);
+          cg.solve(mass_matrix, work_result, rhs, preconditioner);
+        }
+      else
+        {
+          const DiagonalMatrix<decltype(rhs)> &preconditioner =
+            use_lumped ? *mass_matrix.get_matrix_lumped_diagonal_inverse() :
+                         *mass_matrix.get_matrix_diagonal_inverse();
 #ifdef DEBUG
-      // Make sure we picked a valid preconditioner
-      const auto &diagonal = preconditioner.get_vector();
-      for (const Number &v : diagonal)
-        Assert(v > 0.0, ExcInternalError());
+          // Make sure we picked a valid preconditioner
+          const auto &diagonal = preconditioner.get_vector();
+          for (const Number &v : diagonal)
+            Assert(v > 0.0, ExcInternalError());
 #endif
-      cg.solve(mass_matrix, work_result, rhs, preconditioner);
+          cg.solve(mass_matrix, work_result, rhs, preconditioner);
+        }
       work_result += inhomogeneities;
 
       constraints.distribute(work_result);
@@ -435,11 +622,18 @@ namespace VectorTools
                                     q_boundary,
                                     project_to_boundary_first);
 
-      for (const auto i : dof.locally_owned_dofs())
-        ::dealii::internal::ElementAccess<VectorType>::set(work_result(i),
-                                                           i,
-                                                           vec_result);
-      vec_result.compress(VectorOperation::insert);
+      // copy the result. for a vector of the same type, we can copy the
+      // locally owned range as a whole rather than element by element
+      if constexpr (std::is_same_v<VectorType, decltype(work_result)>)
+        vec_result.copy_locally_owned_data_from(work_result);
+      else
+        {
+          for (const auto i : dof.locally_owned_dofs())
+            ::dealii::internal::ElementAccess<VectorType>::set(work_result(i),
+                                                               i,
+                                                               vec_result);
+          vec_result.compress(VectorOperation::insert);
+        }
     }
 
 
@@ -18,6 +18,7 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
 #include <deal.II/base/mpi_large_count.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/parameter_handler.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/utilities.h>
@@ -25,16 +26,20 @@
 #include <deal.II/numerics/data_component_interpretation.h>
 
 #include <algorithm>
+#include <array>
 #include <cmath>
 #include <cstdint>
 #include <cstring>
 #include <ctime>
 #include <fstream>
+#include <future>
 #include <iomanip>
 #include <limits>
 #include <memory>
+#include <numeric>
 #include <set>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #ifdef DEAL_II_WITH_ZLIB
@@ -127,9 +132,22 @@ namespace
 #  endif
 #endif
 
+  /**
+   * The size in bytes of the blocks into which compress_array() splits the
+   * data. This is the block structure the VTK compression header describes:
+   * each block is compressed independently of the others, which allows us to
+   * compress them concurrently.
+   */
+  constexpr std::size_t vtu_compression_block_size = 1 << 20;
+
+
+
   /**
    * Do a zlib compression followed by a base64 encoding of the given data. The
    * result is then returned as a string object.
+   *
+   * The data is split into blocks of vtu_compression_block_size bytes that are
+   * compressed in parallel, as long as there are several of them.
    */
   template <typename T>
   std::string
@@ -140,49 +158,88 @@ namespace
     if (data.size() != 0)
       {
         const std::size_t uncompressed_size = (data.size() * sizeof(T));
-
-        // While zlib's compress2 uses unsigned long (which is 64bits
-        // on Linux), the vtu compression header stores the block size
-        // as an std::uint32_t (see below). While we could implement
-        // writing several smaller blocks, we haven't done that. Let's
-        // trigger an error for the user instead:
-        AssertThrow(uncompressed_size <=
-                      std::numeric_limits<std::uint32_t>::max(),
+        const std::size_t n_blocks =
+          (uncompressed_size + vtu_compression_block_size - 1) /
+          vtu_compression_block_size;
+        const std::size_t last_block_size =
+          uncompressed_size - (n_blocks - 1) * vtu_compression_block_size;
+
+        // The vtu compression header stores the number of blocks and their
+        // sizes as std::uint32_t (see below). The sizes of the blocks are
+        // small enough by construction, but let us make sure that there are
+        // not too many of them:
+        AssertThrow(n_blocks <= std::numeric_limits<std::uint32_t>::max(),
                     ExcNotImplemented());
 
-        // allocate a buffer for compressing data and do so
-        auto compressed_data_length = compressBound(uncompressed_size);
-        AssertThrow(compressed_data_length <=
-                      std::numeric_limits<std::uint32_t>::max(),
-                    ExcNotImplemented());
-
-        std::vector<unsigned char> compressed_data(compressed_data_length);
-
-        int err = compress2(&compressed_data[0],
-                            &compressed_data_length,
-                            reinterpret_cast<const Bytef *>(data.data()),
-                            uncompressed_size,
-                            get_zlib_compression_level(compression_level));
-        (void)err;
-        Assert(err == Z_OK, ExcInternalError());
-
-        // Discard the unnecessary bytes
-        compressed_data.resize(compressed_data_length);
+        // allocate a buffer for each block and compress the blocks into them
+        std::vector<std::vector<unsigned char>> compressed_blocks(n_blocks);
+        const auto compress_block = [&](const std::size_t block) {
+          const std::size_t block_size =
+            (block == n_blocks - 1 ? last_block_size :
+                                     vtu_compression_block_size);
+          auto compressed_block_length = compressBound(block_size);
+          compressed_blocks[block].resize(compressed_block_length);
+
+          int err =
+            compress2(compressed_blocks[block].data(),
+                      &compressed_block_length,
+                      reinterpret_cast<const Bytef *>(data.data()) +
+                        block * vtu_compression_block_size,
+                      block_size,
+                      get_zlib_compression_level(compression_level));
+          (void)err;
+          Assert(err == Z_OK, ExcInternalError());
+
+          // Discard the unnecessary bytes
+          compressed_blocks[block].resize(compressed_block_length);
+        };
+
+        if (n_blocks == 1)
+          compress_block(0);
+        else
+          {
+            Threads::TaskGroup<> tasks;
+            for (std::size_t block = 0; block < n_blocks; ++block)
+              tasks += Threads::new_task(
+                [&compress_block, block]() { compress_block(block); });
+            tasks.join_all();
+          }
 
-        // now encode the compression header
-        const std::uint32_t compression_header[4] = {
-          1,                                             /* number of blocks */
-          static_cast<std::uint32_t>(uncompressed_size), /* size of block */
-          static_cast<std::uint32_t>(
-            uncompressed_size), /* size of last block */
-          static_cast<std::uint32_t>(
-            compressed_data_length)}; /* list of compressed sizes of blocks */
+        // now encode the compression header: the number of blocks, the size
+        // of all but the last block, the size of the last block, and the
+        // compressed sizes of all blocks
+        std::vector<std::uint32_t> compression_header;
+        compression_header.reserve(3 + n_blocks);
+        compression_header.push_back(static_cast<std::uint32_t>(n_blocks));
+        compression_header.push_back(static_cast<std::uint32_t>(
+          std::min(uncompressed_size, vtu_compression_block_size)));
+        compression_header.push_back(
+          static_cast<std::uint32_t>(last_block_size));
+        for (const auto &compressed_block : compressed_blocks)
+          compression_header.push_back(
+            static_cast<std::uint32_t>(compressed_block.size()));
 
         const auto *const header_start =
-          reinterpret_cast<const unsigned char *>(&compression_header[0]);
+          reinterpret_cast<const unsigned char *>(compression_header.data());
+
+        std::vector<unsigned char> compressed_data;
+        compressed_data.reserve(
+          std::accumulate(compressed_blocks.begin(),
+                          compressed_blocks.end(),
+                          std::size_t(0),
+                          [](const std::size_t                 size,
+                             const std::vector<unsigned char> &block) {
+                            return size + block.size();
+                          }));
+        for (const auto &compressed_block : compressed_blocks)
+          compressed_data.insert(compressed_data.end(),
+                                 compressed_block.begin(),
+                                 compressed_block.end());
 
         return (Utilities::encode_base64(
-                  {header_start, header_start + 4 * sizeof(std::uint32_t)}) +
+                  {header_start,
+                   header_start +
+                     compression_header.size() * sizeof(std::uint32_t)}) +
                 Utilities::encode_base64(compressed_data));
       }
     else
@@ -230,6 +287,130 @@ namespace
   }
 
 
+
+  /**
+   * Return whether the data and the points of the given patch of hypercube
+   * shape are represented within the given @p tolerance by multilinear
+   * interpolation on a patch with @p n_coarse_subdivisions subdivisions,
+   * which must divide the number of subdivisions of the patch.
+   */
+  template <int dim, int spacedim>
+  bool
+  patch_can_be_coarsened(const DataOutBase::Patch<dim, spacedim> &patch,
+                         const unsigned int n_coarse_subdivisions,
+                         const double       tolerance)
+  {
+    const unsigned int n_subdivisions = patch.n_subdivisions;
+    const unsigned int ratio          = n_subdivisions / n_coarse_subdivisions;
+    const unsigned int n_points_1d    = n_subdivisions + 1;
+    Assert(ratio * n_coarse_subdivisions == n_subdivisions,
+           ExcInternalError());
+
+    const unsigned int n_points = patch.data.n_cols();
+    for (unsigned int point = 0; point < n_points; ++point)
+      {
+        // find the coarse cell the point lies in, and the indices of its
+        // first vertex and the coordinates of the point within that cell
+        unsigned int                  first_vertex = 0;
+        unsigned int                  stride       = 1;
+        std::array<double, dim>       local_coordinates;
+        std::array<unsigned int, dim> strides;
+        for (unsigned int d = 0, i = point; d < dim; ++d, i /= n_points_1d)
+          {
+            const unsigned int index = i % n_points_1d;
+            const unsigned int cell =
+              std::min(index / ratio, n_coarse_subdivisions - 1);
+            local_coordinates[d] = double(index - cell * ratio) / ratio;
+            first_vertex += cell * ratio * stride;
+            strides[d] = ratio * stride;
+            stride *= n_points_1d;
+          }
+
+        for (unsigned int row = 0; row < patch.data.n_rows(); ++row)
+          {
+            double interpolated = 0;
+            for (unsigned int v = 0; v < (1u << dim); ++v)
+              {
+                double       weight = 1;
+                unsigned int vertex = first_vertex;
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (v & (1u << d))
+                    {
+                      weight *= local_coordinates[d];
+                      vertex += strides[d];
+                    }
+                  else
+                    weight *= 1 - local_coordinates[d];
+                interpolated += weight * patch.data(row, vertex);
+              }
+            if (std::abs(interpolated - patch.data(row, point)) > tolerance)
+              return false;
+          }
+      }
+    return true;
+  }
+
+
+
+  /**
+   * Reduce the number of subdivisions of the given patch as described for
+   * DataOutBase::VtkFlags::subdivision_tolerance.
+   */
+  template <int dim, int spacedim>
+  void
+  coarsen_patch_subdivisions(DataOutBase::Patch<dim, spacedim> &patch,
+                             const double                       tolerance)
+  {
+    // patches for points have no subdivisions
+    if constexpr (dim > 0)
+      {
+        if ((patch.n_subdivisions < 2) ||
+            (patch.reference_cell != ReferenceCells::get_hypercube<dim>()))
+          return;
+
+        const unsigned int n_subdivisions = patch.n_subdivisions;
+        for (unsigned int n_coarse_subdivisions = 1;
+             n_coarse_subdivisions < n_subdivisions;
+             ++n_coarse_subdivisions)
+          if ((n_subdivisions % n_coarse_subdivisions == 0) &&
+              patch_can_be_coarsened(patch, n_coarse_subdivisions, tolerance))
+            {
+              const unsigned int ratio =
+                n_subdivisions / n_coarse_subdivisions;
+              const unsigned int n_points_1d        = n_subdivisions + 1;
+              const unsigned int n_coarse_points_1d = n_coarse_subdivisions + 1;
+              const unsigned int n_coarse_points =
+                Utilities::fixed_power<dim>(n_coarse_points_1d);
+
+              Table<2, float> coarse_data(patch.data.n_rows(),
+                                          n_coarse_points);
+              for (unsigned int point = 0; point < n_coarse_points; ++point)
+                {
+                  unsigned int fine_point = 0;
+                  unsigned int stride     = 1;
+                  for (unsigned int d = 0, i = point; d < dim;
+                       ++d, i /= n_coarse_points_1d)
+                    {
+                      fine_point += (i % n_coarse_points_1d) * ratio * stride;
+                      stride *= n_points_1d;
+                    }
+                  for (unsigned int row = 0; row < patch.data.n_rows(); ++row)
+                    coarse_data(row, point) = patch.data(row, fine_point);
+                }
+
+              patch.data.swap(coarse_data);
+              patch.n_subdivisions = n_coarse_subdivisions;
+              return;
+            }
+      }
+    else
+      {
+        (void)patch;
+        (void)tolerance;
+      }
+  }
+
+
   /**
    * The header in binary format that the parallel intermediate files
    * start with.
@@ -2432,6 +2613,8 @@ namespace DataOutBase
     , compression_level(compression_level)
     , write_higher_order_cells(write_higher_order_cells)
     , physical_units(physical_units)
+    , n_significant_bits(24)
+    , subdivision_tolerance(0)
   {}
 
 
@@ -5260,9 +5443,64 @@ namespace DataOutBase
                    &nonscalar_data_ranges,
     const VtkFlags &flags,
     std::ostream   &out)
+  {
+    std::string mesh_output;
+    write_vtu_main(
+      patches, data_names, nonscalar_data_ranges, flags, mesh_output, out);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  write_vtu_main(
+    const std::vector<Patch<dim, spacedim>> &patches,
+    const std::vector<std::string>          &data_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+                   &nonscalar_data_ranges,
+    const VtkFlags &flags,
+    std::string    &mesh_output,
+    std::ostream   &out)
   {
     AssertThrow(out.fail() == false, ExcIO());
 
+    // If requested, first reduce the number of subdivisions of the patches
+    // as far as their data allows, and write the resulting patches instead.
+    // Their geometry then depends on the data, so there is no point in
+    // keeping the mesh part of the output.
+    if ((flags.subdivision_tolerance > 0) &&
+        (flags.write_higher_order_cells == false))
+      {
+        std::vector<Patch<dim, spacedim>> coarsened_patches(patches);
+        parallel::apply_to_subranges(
+          0u,
+          static_cast<unsigned int>(coarsened_patches.size()),
+          [&coarsened_patches, &flags](const unsigned int begin,
+                                       const unsigned int end) {
+            for (unsigned int i = begin; i < end; ++i)
+              coarsen_patch_subdivisions(coarsened_patches[i],
+                                         flags.subdivision_tolerance);
+          },
+          16);
+
+        VtkFlags coarsened_flags              = flags;
+        coarsened_flags.subdivision_tolerance = 0;
+
+        mesh_output.clear();
+        write_vtu_main(coarsened_patches,
+                       data_names,
+                       nonscalar_data_ranges,
+                       coarsened_flags,
+                       mesh_output,
+                       out);
+        mesh_output.clear();
+        return;
+      }
+
     // If the user provided physical units, make sure that they don't contain
     // quote characters as this would make the VTU file invalid XML and
     // probably lead to all sorts of difficult error messages. Other than that,
@@ -5985,6 +6223,9 @@ namespace DataOutBase
               }
           } // loop over nodes
 
+        quantize_vtu_data(data,
+                          (!name.empty() ? name : data_names[first_component]),
+                          flags);
         o << vtu_stringize_array(data,
                                  flags.compression_level,
                                  output_precision);
@@ -6012,8 +6253,9 @@ namespace DataOutBase
 
         o << ">\n";
 
-        const std::vector<float> data(data_vectors[data_set].begin(),
-                                      data_vectors[data_set].end());
+        std::vector<float> data(data_vectors[data_set].begin(),
+                                data_vectors[data_set].end());
+        quantize_vtu_data(data, data_names[data_set], flags);
         o << vtu_stringize_array(data,
                                  flags.compression_level,
                                  output_precision);
@@ -6042,11 +6284,16 @@ namespace DataOutBase
 
     // -----------------------------
     // Now finally get around to actually doing anything. Let's start with
-    // running the first three tasks generating the vertex and cell information:
+    // running the first three tasks generating the vertex and cell
+    // information, unless the caller already has it from a previous call:
     Threads::TaskGroup<std::string> mesh_tasks;
-    mesh_tasks += Threads::new_task(stringize_vertex_information);
-    mesh_tasks += Threads::new_task(stringize_cell_to_vertex_information);
-    mesh_tasks += Threads::new_task(stringize_cell_offset_and_type_information);
+    if (mesh_output.empty())
+      {
+        mesh_tasks += Threads::new_task(stringize_vertex_information);
+        mesh_tasks += Threads::new_task(stringize_cell_to_vertex_information);
+        mesh_tasks +=
+          Threads::new_task(stringize_cell_offset_and_type_information);
+      }
 
     // For what follows, we have to have the reordered data available. So wait
     // for that task to conclude and get the resulting data table:
@@ -6084,8 +6331,10 @@ namespace DataOutBase
     // all of the data they have produced:
     out << "<Piece NumberOfPoints=\"" << n_nodes << "\" NumberOfCells=\""
         << n_cells << "\" >\n";
-    for (const auto &s : mesh_tasks.return_values())
-      out << s;
+    if (mesh_output.empty())
+      for (const auto &s : mesh_tasks.return_values())
+        mesh_output += s;
+    out << mesh_output;
     out << "  <PointData Scalars=\"scalars\">\n";
     for (const auto &s : data_tasks.return_values())
       out << s;
@@ -6101,6 +6350,104 @@ namespace DataOutBase
 
 
 
+  template <typename T>
+  void
+  write_vtu_data_array(const std::vector<T> &data,
+                       const std::string    &attributes,
+                       const VtkFlags       &flags,
+                       std::ostream         &out)
+  {
+    AssertThrow(out.fail() == false, ExcIO());
+
+    const bool binary =
+      (deal_ii_with_zlib &&
+       (flags.compression_level != CompressionLevel::plain_text));
+
+    out << "    <DataArray " << attributes << " format=\""
+        << (binary ? "binary" : "ascii") << "\">\n";
+
+    // std::uint8_t might be an alias to unsigned char which is then not
+    // printed as ascii integers
+    if (std::is_same_v<T, std::uint8_t> && !binary)
+      out << vtu_stringize_array(std::vector<unsigned int>(data.begin(),
+                                                           data.end()),
+                                 flags.compression_level,
+                                 out.precision());
+    else
+      out << vtu_stringize_array(data,
+                                 flags.compression_level,
+                                 out.precision());
+    out << '\n';
+    out << "    </DataArray>\n";
+  }
+
+
+
+  template void
+  write_vtu_data_array(const std::vector<float> &,
+                       const std::string &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<std::int32_t> &,
+                       const std::string &,
+                       const VtkFlags &,
+                       std::ostream &);
+  template void
+  write_vtu_data_array(const std::vector<std::uint8_t> &,
+                       const std::string &,
+                       const VtkFlags &,
+                       std::ostream &);
+
+
+
+  void
+  quantize_vtu_data(std::vector<float> &data,
+                    const std::string  &name,
+                    const VtkFlags     &flags)
+  {
+    AssertIndexRange(flags.n_significant_bits - 1, 24);
+
+    const auto tolerance = flags.quantization_tolerances.find(name);
+    if (tolerance != flags.quantization_tolerances.end())
+      {
+        Assert(tolerance->second > 0,
+               ExcMessage("Quantization tolerances must be positive."));
+        // rounding to multiples of a power of two is exact in floating point
+        // arithmetic and leaves the lower bits of the values zero
+        const float step =
+          std::exp2(std::floor(std::log2(2. * tolerance->second)));
+        for (float &value : data)
+          value = std::round(value / step) * step;
+      }
+
+    if (flags.n_significant_bits < 24)
+      {
+        const unsigned int  n_dropped_bits = 24 - flags.n_significant_bits;
+        const std::uint32_t exponent_mask  = 0x7f800000u;
+        const std::uint32_t dropped_mask   = (1u << n_dropped_bits) - 1;
+        for (float &value : data)
+          {
+            std::uint32_t bits;
+            std::memcpy(&bits, &value, sizeof(float));
+
+            // leave infinities and NaNs alone, and round to the nearest
+            // value with the requested number of significant bits unless
+            // that overflows to infinity
+            if ((bits & exponent_mask) != exponent_mask)
+              {
+                std::uint32_t rounded =
+                  (bits + (1u << (n_dropped_bits - 1))) & ~dropped_mask;
+                if ((rounded & exponent_mask) == exponent_mask)
+                  rounded = bits & ~dropped_mask;
+                std::memcpy(&value, &rounded, sizeof(float));
+              }
+          }
+      }
+  }
+
+
+
   void
   write_pvtu_record(
     std::ostream                   &out,
@@ -7581,7 +7928,8 @@ namespace DataOutBase
 
 template <int dim, int spacedim>
 DataOutInterface<dim, spacedim>::DataOutInterface()
-  : default_subdivisions(1)
+  : patch_geometry_id(0)
+  , default_subdivisions(1)
   , default_fmt(DataOutBase::default_format)
 {}
 
@@ -7693,11 +8041,25 @@ template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_vtu(std::ostream &out) const
 {
-  DataOutBase::write_vtu(get_patches(),
-                         get_dataset_names(),
-                         get_nonscalar_data_ranges(),
-                         vtk_flags,
-                         out);
+  if (patch_geometry_id == 0)
+    DataOutBase::write_vtu(get_patches(),
+                           get_dataset_names(),
+                           get_nonscalar_data_ranges(),
+                           vtk_flags,
+                           out);
+  else
+    {
+      DataOutBase::write_vtu_header(out, vtk_flags);
+      DataOutBase::write_vtu_main(get_patches(),
+                                  get_dataset_names(),
+                                  get_nonscalar_data_ranges(),
+                                  vtk_flags,
+                                  get_vtu_mesh_cache(out.precision()),
+                                  out);
+      DataOutBase::write_vtu_footer(out);
+
+      out << std::flush;
+    }
 }
 
 template <int dim, int spacedim>
@@ -7777,11 +8139,21 @@ DataOutInterface<dim, spacedim>::write_vtu_in_parallel(
     // invalid.
     std::stringstream ss;
     if (my_n_patches > 0 || (global_n_patches == 0 && myrank == 0))
-      DataOutBase::write_vtu_main(patches,
-                                  get_dataset_names(),
-                                  get_nonscalar_data_ranges(),
-                                  vtk_flags,
-                                  ss);
+      {
+        if (patch_geometry_id == 0)
+          DataOutBase::write_vtu_main(patches,
+                                      get_dataset_names(),
+                                      get_nonscalar_data_ranges(),
+                                      vtk_flags,
+                                      ss);
+        else
+          DataOutBase::write_vtu_main(patches,
+                                      get_dataset_names(),
+                                      get_nonscalar_data_ranges(),
+                                      vtk_flags,
+                                      get_vtu_mesh_cache(ss.precision()),
+                                      ss);
+      }
 
     // Use prefix sum to find specific offset to write at.
     const std::uint64_t size_on_proc = ss.str().size();
@@ -7932,6 +8304,34 @@ DataOutInterface<dim, spacedim>::write_vtu_with_pvtu_record(
 
 
 
+template <int dim, int spacedim>
+const DataOutBase::VtkFlags &
+DataOutInterface<dim, spacedim>::get_vtk_flags() const
+{
+  return vtk_flags;
+}
+
+
+
+template <int dim, int spacedim>
+std::string &
+DataOutInterface<dim, spacedim>::get_vtu_mesh_cache(
+  const std::streamsize precision) const
+{
+  const auto key = std::make_tuple(patch_geometry_id,
+                                   vtk_flags.compression_level,
+                                   vtk_flags.write_higher_order_cells,
+                                   precision);
+  if ((patch_geometry_id == 0) || (key != vtu_mesh_cache_key))
+    {
+      vtu_mesh_cache.clear();
+      vtu_mesh_cache_key = key;
+    }
+  return vtu_mesh_cache;
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::write_deal_II_intermediate(
@@ -9054,6 +9454,15 @@ DataOutInterface<dim, spacedim>::get_nonscalar_data_ranges() const
 }
 
 
+
+template <int dim, int spacedim>
+std::vector<DataOutBase::Patch<dim, spacedim>>
+DataOutInterface<dim, spacedim>::release_patches()
+{
+  return get_patches();
+}
+
+
 template <int dim, int spacedim>
 void
 DataOutInterface<dim, spacedim>::validate_dataset_names() const
@@ -9382,6 +9791,739 @@ DataOutReader<dim, spacedim>::get_nonscalar_data_ranges() const
 
 
 
+// ---------------------------------------------- DataOutBackgroundWriter ---
+
+template <int dim, int spacedim>
+class DataOutBackgroundWriter<dim, spacedim>::OutputData
+  : public DataOutInterface<dim, spacedim>
+{
+public:
+  OutputData(
+    std::vector<DataOutBase::Patch<dim, spacedim>> &&patches,
+    const std::vector<std::string>                  &dataset_names,
+    const std::vector<
+      std::tuple<unsigned int,
+                 unsigned int,
+                 std::string,
+                 DataComponentInterpretation::DataComponentInterpretation>>
+                                &nonscalar_data_ranges,
+    const DataOutBase::VtkFlags &vtk_flags)
+    : patches(std::move(patches))
+    , dataset_names(dataset_names)
+    , nonscalar_data_ranges(nonscalar_data_ranges)
+  {
+    this->set_flags(vtk_flags);
+  }
+
+protected:
+  virtual const std::vector<DataOutBase::Patch<dim, spacedim>> &
+  get_patches() const override
+  {
+    return patches;
+  }
+
+  virtual std::vector<std::string>
+  get_dataset_names() const override
+  {
+    return dataset_names;
+  }
+
+  virtual std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+  get_nonscalar_data_ranges() const override
+  {
+    return nonscalar_data_ranges;
+  }
+
+private:
+  const std::vector<DataOutBase::Patch<dim, spacedim>> patches;
+  const std::vector<std::string>                       dataset_names;
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    nonscalar_data_ranges;
+};
+
+
+
+template <int dim, int spacedim>
+struct DataOutBackgroundWriter<dim, spacedim>::PendingWrite
+{
+  std::shared_ptr<const OutputData> data;
+  std::future<void>                 result;
+  MPI_Comm                          communicator;
+};
+
+
+
+template <int dim, int spacedim>
+DataOutBackgroundWriter<dim, spacedim>::DataOutBackgroundWriter(
+  const unsigned int max_n_pending_writes)
+  : max_n_pending_writes(max_n_pending_writes)
+{
+  Assert(max_n_pending_writes > 0,
+         ExcMessage("At least one write must be allowed to be pending."));
+}
+
+
+
+template <int dim, int spacedim>
+DataOutBackgroundWriter<dim, spacedim>::~DataOutBackgroundWriter()
+{
+  // a destructor must not throw, so ignore errors that happened while
+  // writing. users who want to see them need to call wait()
+  while (pending_writes.size() > 0)
+    {
+      try
+        {
+          finish_oldest_write();
+        }
+      catch (...)
+        {}
+    }
+}
+
+
+
+template <int dim, int spacedim>
+std::string
+DataOutBackgroundWriter<dim, spacedim>::write_vtu_with_pvtu_record(
+  DataOutInterface<dim, spacedim> &data_out,
+  const std::string               &directory,
+  const std::string               &filename_without_extension,
+  const unsigned int               counter,
+  const MPI_Comm                   mpi_communicator,
+  const unsigned int               n_digits_for_counter,
+  const unsigned int               n_groups)
+{
+  const unsigned int rank = Utilities::MPI::this_mpi_process(mpi_communicator);
+  const unsigned int n_ranks =
+    Utilities::MPI::n_mpi_processes(mpi_communicator);
+  const bool every_rank_writes = (n_groups == 0 || n_groups > n_ranks);
+
+  // writing fewer files than there are ranks requires collective
+  // communication, which can only happen on a separate thread if MPI
+  // supports it. otherwise fall back to writing the files right away, with
+  // all ranks taking part in the collective MPI-IO operations on the calling
+  // thread. data_out keeps its patches in that case, and nothing is added to
+  // the list of pending writes
+  bool write_collectively_in_background = false;
+#ifdef DEAL_II_WITH_MPI
+  if (!every_rank_writes && Utilities::MPI::job_supports_mpi())
+    {
+      int       provided;
+      const int ierr = MPI_Query_thread(&provided);
+      AssertThrowMPI(ierr);
+      write_collectively_in_background = (provided == MPI_THREAD_MULTIPLE);
+    }
+#endif
+  if (!every_rank_writes && !write_collectively_in_background)
+    return data_out.write_vtu_with_pvtu_record(directory,
+                                               filename_without_extension,
+                                               counter,
+                                               mpi_communicator,
+                                               n_digits_for_counter,
+                                               n_groups);
+
+  // bound the memory held by pending writes
+  while (pending_writes.size() >= max_n_pending_writes)
+    finish_oldest_write();
+
+  PendingWrite write;
+  write.data = std::make_shared<const OutputData>(
+    data_out.release_patches(),
+    data_out.get_dataset_names(),
+    data_out.get_nonscalar_data_ranges(),
+    data_out.vtk_flags);
+  write.communicator = MPI_COMM_NULL;
+
+  const std::shared_ptr<const OutputData> data = write.data;
+  if (every_rank_writes)
+    {
+      // every rank writes its own file, so the task does not need to
+      // communicate. determine the file names the same way as
+      // DataOutInterface::write_vtu_with_pvtu_record() here, and only do the
+      // writing in the background
+      const unsigned int n_digits =
+        Utilities::needed_digits(std::max(0, int(n_ranks) - 1));
+      std::vector<std::string> vtu_filenames;
+      for (unsigned int i = 0; i < n_ranks; ++i)
+        vtu_filenames.emplace_back(
+          filename_without_extension + "_" +
+          Utilities::int_to_string(counter, n_digits_for_counter) + "." +
+          Utilities::int_to_string(i, n_digits) + ".vtu");
+
+      const std::string vtu_filename = directory + vtu_filenames[rank];
+      const std::string pvtu_filename =
+        directory + filename_without_extension + "_" +
+        Utilities::int_to_string(counter, n_digits_for_counter) + ".pvtu";
+      if (rank != 0)
+        vtu_filenames.clear();
+
+      // use a thread of its own rather than a task: tasks share the thread
+      // pool with the parallel loops of the main program, and may not start
+      // before the write is waited for if those keep the pool busy
+      write.result = std::async(
+        std::launch::async,
+        [data, vtu_filename, pvtu_filename, vtu_filenames]() {
+          std::ofstream output(vtu_filename);
+          AssertThrow(output, ExcFileNotOpen(vtu_filename));
+          data->write_vtu(output);
+
+          if (vtu_filenames.size() > 0)
+            {
+              std::ofstream pvtu_output(pvtu_filename);
+              AssertThrow(pvtu_output, ExcFileNotOpen(pvtu_filename));
+              data->write_pvtu_record(pvtu_output, vtu_filenames);
+            }
+        });
+    }
+  else
+    {
+      // give the task its own communicator so that its messages can not be
+      // confused with those of the main program
+      write.communicator =
+        Utilities::MPI::duplicate_communicator(mpi_communicator);
+      const MPI_Comm communicator = write.communicator;
+      write.result                = std::async(std::launch::async, [=]() {
+        data->write_vtu_with_pvtu_record(directory,
+                                         filename_without_extension,
+                                         counter,
+                                         communicator,
+                                         n_digits_for_counter,
+                                         n_groups);
+      });
+    }
+
+  pending_writes.emplace_back(std::move(write));
+
+  return filename_without_extension + "_" +
+         Utilities::int_to_string(counter, n_digits_for_counter) + ".pvtu";
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBackgroundWriter<dim, spacedim>::wait()
+{
+  while (pending_writes.size() > 0)
+    finish_oldest_write();
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutBackgroundWriter<dim, spacedim>::n_pending_writes() const
+{
+  return pending_writes.size();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutBackgroundWriter<dim, spacedim>::finish_oldest_write()
+{
+  Assert(pending_writes.size() > 0, ExcInternalError());
+
+  // remove the write from the list before waiting for its thread, so that
+  // it is gone also if the thread threw an exception. get() rethrows it
+  PendingWrite write = std::move(pending_writes.front());
+  pending_writes.erase(pending_writes.begin());
+
+  try
+    {
+      write.result.get();
+    }
+  catch (...)
+    {
+      if (write.communicator != MPI_COMM_NULL)
+        Utilities::MPI::free_communicator(write.communicator);
+      throw;
+    }
+
+  if (write.communicator != MPI_COMM_NULL)
+    Utilities::MPI::free_communicator(write.communicator);
+}
+
+
+
+// ---------------------------------------------- DataOutHDF5TimeSeries ---
+
+namespace
+{
+#ifdef DEAL_II_WITH_HDF5
+  /**
+   * Compute a checksum (the 64-bit FNV-1a hash) of the bytes of the given
+   * array, starting from the given value.
+   */
+  template <typename T>
+  std::uint64_t
+  fnv1a_checksum(const std::vector<T> &data, std::uint64_t checksum)
+  {
+    const unsigned char *bytes =
+      reinterpret_cast<const unsigned char *>(data.data());
+    for (std::size_t i = 0; i < data.size() * sizeof(T); ++i)
+      checksum = (checksum ^ bytes[i]) * 1099511628211ULL;
+    return checksum;
+  }
+
+
+
+  /**
+   * Create the dataset @p name with @p n_global_rows rows and @p n_columns
+   * columns of type @p type at @p location, and collectively write the
+   * @p n_local_rows rows of @p data starting at row @p row_offset into it.
+   * The dataset is stored in chunks of about one megabyte that are
+   * compressed with zlib where possible.
+   */
+  void
+  write_hdf5_time_series_dataset(const hid_t                   location,
+                                 const std::string            &name,
+                                 const hid_t                   type,
+                                 const std::uint64_t           n_global_rows,
+                                 const std::uint64_t           row_offset,
+                                 const std::uint64_t           n_local_rows,
+                                 const unsigned int            n_columns,
+                                 const void                   *data,
+                                 const DataOutBase::Hdf5Flags &flags,
+                                 const MPI_Comm                comm)
+  {
+    herr_t status;
+
+    const hsize_t dimensions[2] = {n_global_rows, n_columns};
+    const hid_t   file_dataspace = H5Screate_simple(2, dimensions, nullptr);
+    AssertThrow(file_dataspace >= 0, ExcIO());
+
+    const hid_t creation_plist = H5Pcreate(H5P_DATASET_CREATE);
+    AssertThrow(creation_plist >= 0, ExcIO());
+    if (n_global_rows > 0)
+      {
+        const hsize_t rows_per_chunk =
+          std::min<hsize_t>(n_global_rows,
+                            std::max<hsize_t>(1,
+                                              (1 << 20) /
+                                                (n_columns * sizeof(double))));
+        const hsize_t chunk_dimensions[2] = {rows_per_chunk, n_columns};
+        status = H5Pset_chunk(creation_plist, 2, chunk_dimensions);
+        AssertThrow(status >= 0, ExcIO());
+
+        // Writing compressed datasets in parallel is only supported as of
+        // HDF5 version 1.10.2
+#  ifdef DEAL_II_WITH_ZLIB
+#    if H5_VERSION_GE(1, 10, 2)
+        const bool can_compress = true;
+#    else
+        const bool can_compress = (Utilities::MPI::n_mpi_processes(comm) == 1);
+#    endif
+        if (can_compress)
+          {
+            status = H5Pset_deflate(creation_plist,
+                                    get_zlib_compression_level(
+                                      flags.compression_level));
+            AssertThrow(status >= 0, ExcIO());
+          }
+#  endif
+      }
+#  ifndef DEAL_II_WITH_ZLIB
+    (void)flags;
+#  endif
+    (void)comm;
+
+    const hid_t dataset = H5Dcreate2(location,
+                                     name.c_str(),
+                                     type,
+                                     file_dataspace,
+                                     H5P_DEFAULT,
+                                     creation_plist,
+                                     H5P_DEFAULT);
+    AssertThrow(dataset >= 0, ExcIO());
+
+    // select the rows of this process in the file
+    const hsize_t count[2]  = {n_local_rows, n_columns};
+    const hsize_t offset[2] = {row_offset, 0};
+    status                  = H5Sselect_hyperslab(
+      file_dataspace, H5S_SELECT_SET, offset, nullptr, count, nullptr);
+    AssertThrow(status >= 0, ExcIO());
+    const hid_t memory_dataspace = H5Screate_simple(2, count, nullptr);
+    AssertThrow(memory_dataspace >= 0, ExcIO());
+
+    const hid_t transfer_plist = H5Pcreate(H5P_DATASET_XFER);
+    AssertThrow(transfer_plist >= 0, ExcIO());
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    status = H5Pset_dxpl_mpio(transfer_plist, H5FD_MPIO_COLLECTIVE);
+    AssertThrow(status >= 0, ExcIO());
+#    endif
+#  endif
+
+    status = H5Dwrite(
+      dataset, type, memory_dataspace, file_dataspace, transfer_plist, data);
+    AssertThrow(status >= 0, ExcIO());
+
+    status = H5Pclose(transfer_plist);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(memory_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Dclose(dataset);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Pclose(creation_plist);
+    AssertThrow(status >= 0, ExcIO());
+    status = H5Sclose(file_dataspace);
+    AssertThrow(status >= 0, ExcIO());
+  }
+
+
+
+  /**
+   * Create the property list for accessing an HDF5 file collectively from
+   * all processes in @p comm.
+   */
+  hid_t
+  create_hdf5_file_access_plist(const MPI_Comm comm)
+  {
+    const hid_t file_plist = H5Pcreate(H5P_FILE_ACCESS);
+    AssertThrow(file_plist >= 0, ExcIO());
+#  ifdef DEAL_II_WITH_MPI
+#    ifdef H5_HAVE_PARALLEL
+    const herr_t status = H5Pset_fapl_mpio(file_plist, comm, MPI_INFO_NULL);
+    AssertThrow(status >= 0, ExcIO());
+#    endif
+#  endif
+    (void)comm;
+    return file_plist;
+  }
+#endif
+
+
+
+  /**
+   * The lines that close the temporal collection of an XDMF file.
+   */
+  const std::string xdmf_time_series_footer =
+    "    </Grid>\n  </Domain>\n</Xdmf>\n";
+} // namespace
+
+
+
+template <int dim, int spacedim>
+DataOutHDF5TimeSeries<dim, spacedim>::DataOutHDF5TimeSeries(
+  const std::string            &h5_filename,
+  const std::string            &xdmf_filename,
+  const MPI_Comm                mpi_communicator,
+  const DataOutBase::Hdf5Flags &flags)
+  : h5_filename(h5_filename)
+  , xdmf_filename(xdmf_filename)
+  , mpi_communicator(mpi_communicator)
+  , flags(flags)
+  , n_written_time_steps(0)
+  , n_written_meshes(0)
+  , mesh_checksum(0)
+{
+  AssertThrow(
+    spacedim >= 2,
+    ExcMessage(
+      "DataOutBase was asked to write HDF5 output for a space dimension of 1. "
+      "HDF5 only supports datasets that live in 2 or 3 dimensions."));
+
+#ifndef DEAL_II_WITH_HDF5
+  AssertThrow(false, ExcNeedsHDF5());
+#else
+#  ifndef H5_HAVE_PARALLEL
+  AssertThrow(
+    Utilities::MPI::n_mpi_processes(mpi_communicator) <= 1,
+    ExcMessage(
+      "Serial HDF5 output on multiple processes is not yet supported."));
+#  endif
+
+  // Start the XDMF file with an empty temporal collection. write_time_step()
+  // inserts the entries of the time steps in front of the footer
+  if (Utilities::MPI::this_mpi_process(mpi_communicator) == 0)
+    {
+      std::ofstream xdmf_file(xdmf_filename);
+      AssertThrow(xdmf_file, ExcFileNotOpen(xdmf_filename));
+      xdmf_file << "<?xml version=\"1.0\" ?>\n";
+      xdmf_file << "<!DOCTYPE Xdmf SYSTEM \"Xdmf.dtd\" []>\n";
+      xdmf_file << "<Xdmf Version=\"2.0\">\n";
+      xdmf_file << "  <Domain>\n";
+      xdmf_file
+        << "    <Grid Name=\"CellTime\" GridType=\"Collection\" CollectionType=\"Temporal\">\n";
+      xdmf_file << xdmf_time_series_footer;
+    }
+
+  // Create an empty HDF5 file, overwriting any existing one
+  const hid_t file_plist = create_hdf5_file_access_plist(mpi_communicator);
+  const hid_t h5_file =
+    H5Fcreate(h5_filename.c_str(), H5F_ACC_TRUNC, H5P_DEFAULT, file_plist);
+  AssertThrow(h5_file >= 0, ExcIO());
+  herr_t status = H5Fclose(h5_file);
+  AssertThrow(status >= 0, ExcIO());
+  status = H5Pclose(file_plist);
+  AssertThrow(status >= 0, ExcIO());
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOutHDF5TimeSeries<dim, spacedim>::write_time_step(
+  const DataOutInterface<dim, spacedim> &data_out,
+  const double                           time)
+{
+#ifndef DEAL_II_WITH_HDF5
+  (void)data_out;
+  (void)time;
+  AssertThrow(false, ExcNeedsHDF5());
+#else
+  DataOutBase::DataOutFilter data_filter(
+    DataOutBase::DataOutFilterFlags(true, true));
+  data_out.write_filtered_data(data_filter);
+
+  // Compute the global numbers of nodes and cells, and the offsets of the
+  // data of this process
+  const std::uint64_t local_node_cell_count[2] = {data_filter.n_nodes(),
+                                                  data_filter.n_cells()};
+  std::uint64_t       global_node_cell_count[2]   = {0, 0};
+  std::uint64_t       global_node_cell_offsets[2] = {0, 0};
+#  ifdef DEAL_II_WITH_MPI
+  int ierr = MPI_Allreduce(local_node_cell_count,
+                           global_node_cell_count,
+                           2,
+                           MPI_UINT64_T,
+                           MPI_SUM,
+                           mpi_communicator);
+  AssertThrowMPI(ierr);
+  ierr = MPI_Exscan(local_node_cell_count,
+                    global_node_cell_offsets,
+                    2,
+                    MPI_UINT64_T,
+                    MPI_SUM,
+                    mpi_communicator);
+  AssertThrowMPI(ierr);
+#  else
+  global_node_cell_count[0] = local_node_cell_count[0];
+  global_node_cell_count[1] = local_node_cell_count[1];
+#  endif
+
+  std::vector<double> node_data;
+  data_filter.fill_node_data(node_data);
+  std::vector<unsigned int> cell_data;
+  data_filter.fill_cell_data(global_node_cell_offsets[0], cell_data);
+
+  // Find out whether the mesh differs from the one written last on any
+  // process
+  const std::uint64_t checksum =
+    fnv1a_checksum(cell_data,
+                   fnv1a_checksum(node_data, 14695981039346656037ULL));
+  const bool write_mesh =
+    (n_written_meshes == 0) ||
+    (Utilities::MPI::max(static_cast<unsigned int>(checksum != mesh_checksum),
+                         mpi_communicator) != 0);
+
+  const unsigned int mesh_index =
+    (write_mesh ? n_written_meshes : n_written_meshes - 1);
+  const std::string mesh_group = "/mesh_" + std::to_string(mesh_index);
+  const std::string step_group =
+    "/step_" + std::to_string(n_written_time_steps);
+
+  // The HDF5 routines perform collective calls that expect all ranks to
+  // participate, but ranks without any patches do not know the names of the
+  // data sets. Let only the ranks with data write.
+  const bool have_data = (data_filter.n_nodes() > 0);
+  MPI_Comm   split_comm;
+  {
+    const int key   = Utilities::MPI::this_mpi_process(mpi_communicator);
+    const int color = (have_data ? 1 : 0);
+    const int ierr  = MPI_Comm_split(mpi_communicator, color, key, &split_comm);
+    AssertThrowMPI(ierr);
+  }
+
+  if (have_data)
+    {
+      const hid_t file_plist = create_hdf5_file_access_plist(split_comm);
+      const hid_t h5_file =
+        H5Fopen(h5_filename.c_str(), H5F_ACC_RDWR, file_plist);
+      AssertThrow(h5_file >= 0, ExcIO());
+      herr_t status;
+
+      const unsigned int n_vertices_per_cell =
+        data_out.get_patches()[0].reference_cell.n_vertices();
+
+      if (write_mesh)
+        {
+          const hid_t group = H5Gcreate2(
+            h5_file, mesh_group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+          AssertThrow(group >= 0, ExcIO());
+
+          // HDF5 only supports 2- or 3-dimensional coordinates
+          write_hdf5_time_series_dataset(group,
+                                         "nodes",
+                                         H5T_NATIVE_DOUBLE,
+                                         global_node_cell_count[0],
+                                         global_node_cell_offsets[0],
+                                         local_node_cell_count[0],
+                                         (spacedim < 2) ? 2 : spacedim,
+                                         node_data.data(),
+                                         flags,
+                                         split_comm);
+          write_hdf5_time_series_dataset(group,
+                                         "cells",
+                                         H5T_NATIVE_UINT,
+                                         global_node_cell_count[1],
+                                         global_node_cell_offsets[1],
+                                         local_node_cell_count[1],
+                                         n_vertices_per_cell,
+                                         cell_data.data(),
+                                         flags,
+                                         split_comm);
+
+          status = H5Gclose(group);
+          AssertThrow(status >= 0, ExcIO());
+        }
+
+      const hid_t group = H5Gcreate2(
+        h5_file, step_group.c_str(), H5P_DEFAULT, H5P_DEFAULT, H5P_DEFAULT);
+      AssertThrow(group >= 0, ExcIO());
+      for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+        write_hdf5_time_series_dataset(group,
+                                       data_filter.get_data_set_name(i),
+                                       H5T_NATIVE_DOUBLE,
+                                       global_node_cell_count[0],
+                                       global_node_cell_offsets[0],
+                                       local_node_cell_count[0],
+                                       data_filter.get_data_set_dim(i),
+                                       data_filter.get_data_set(i),
+                                       flags,
+                                       split_comm);
+      status = H5Gclose(group);
+      AssertThrow(status >= 0, ExcIO());
+
+      status = H5Fclose(h5_file);
+      AssertThrow(status >= 0, ExcIO());
+      status = H5Pclose(file_plist);
+      AssertThrow(status >= 0, ExcIO());
+
+      // The first process with data appends the entry of this time step to
+      // the XDMF file, replacing the footer
+      if (Utilities::MPI::this_mpi_process(split_comm) == 0)
+        {
+          const std::string h5_name =
+            h5_filename.substr(h5_filename.find_last_of('/') + 1);
+          const auto indent = [](const unsigned int level) {
+            return std::string(2 * (level + 3), ' ');
+          };
+
+          std::stringstream entry;
+          entry.precision(12);
+          entry << indent(0) << "<Grid Name=\"mesh\" GridType=\"Uniform\">\n";
+          entry << indent(1) << "<Time Value=\"" << time << "\"/>\n";
+          entry << indent(1) << "<Geometry GeometryType=\""
+                << (spacedim <= 2 ? "XY" : "XYZ") << "\">\n";
+          entry << indent(2) << "<DataItem Dimensions=\""
+                << global_node_cell_count[0] << ' '
+                << (spacedim <= 2 ? 2 : spacedim)
+                << "\" NumberType=\"Float\" Precision=\"8\" Format=\"HDF\">\n";
+          entry << indent(3) << h5_name << ':' << mesh_group << "/nodes\n";
+          entry << indent(2) << "</DataItem>\n";
+          entry << indent(1) << "</Geometry>\n";
+
+          const ReferenceCell reference_cell =
+            data_out.get_patches()[0].reference_cell;
+          entry << indent(1) << "<Topology TopologyType=\"";
+          if (dim == 0)
+            entry << "Polyvertex";
+          else if (dim == 1)
+            entry << "Polyline";
+          else if (reference_cell == ReferenceCells::Quadrilateral)
+            entry << "Quadrilateral";
+          else if (reference_cell == ReferenceCells::Triangle)
+            entry << "Triangle";
+          else if (reference_cell == ReferenceCells::Hexahedron)
+            entry << "Hexahedron";
+          else if (reference_cell == ReferenceCells::Tetrahedron)
+            entry << "Tetrahedron";
+          else
+            Assert(false, ExcNotImplemented());
+          entry << "\" NumberOfElements=\"" << global_node_cell_count[1]
+                << '"';
+          if (dim < 2)
+            entry << " NodesPerElement=\"" << n_vertices_per_cell << '"';
+          entry << ">\n";
+          entry << indent(2) << "<DataItem Dimensions=\""
+                << global_node_cell_count[1] << ' ' << n_vertices_per_cell
+                << "\" NumberType=\"UInt\" Format=\"HDF\">\n";
+          entry << indent(3) << h5_name << ':' << mesh_group << "/cells\n";
+          entry << indent(2) << "</DataItem>\n";
+          entry << indent(1) << "</Topology>\n";
+
+          for (unsigned int i = 0; i < data_filter.n_data_sets(); ++i)
+            {
+              const unsigned int n_components = data_filter.get_data_set_dim(i);
+              entry << indent(1) << "<Attribute Name=\""
+                    << data_filter.get_data_set_name(i) << "\" AttributeType=\""
+                    << (n_components > 1 ? "Vector" : "Scalar")
+                    << "\" Center=\"Node\">\n";
+              entry << indent(2) << "<DataItem Dimensions=\""
+                    << global_node_cell_count[0] << ' ' << n_components
+                    << "\" NumberType=\"Float\" Precision=\"8\" "
+                       "Format=\"HDF\">\n";
+              entry << indent(3) << h5_name << ':' << step_group << '/'
+                    << data_filter.get_data_set_name(i) << '\n';
+              entry << indent(2) << "</DataItem>\n";
+              entry << indent(1) << "</Attribute>\n";
+            }
+          entry << indent(0) << "</Grid>\n";
+
+          std::fstream xdmf_file(xdmf_filename,
+                                 std::ios::in | std::ios::out |
+                                   std::ios::binary);
+          AssertThrow(xdmf_file, ExcFileNotOpen(xdmf_filename));
+          xdmf_file.seekp(-static_cast<std::streamoff>(
+                            xdmf_time_series_footer.size()),
+                          std::ios::end);
+          xdmf_file << entry.str() << xdmf_time_series_footer;
+          AssertThrow(xdmf_file, ExcIO());
+        }
+    }
+
+  const int ierr_free = MPI_Comm_free(&split_comm);
+  AssertThrowMPI(ierr_free);
+
+  if (write_mesh)
+    ++n_written_meshes;
+  mesh_checksum = checksum;
+  ++n_written_time_steps;
+#endif
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutHDF5TimeSeries<dim, spacedim>::n_time_steps() const
+{
+  return n_written_time_steps;
+}
+
+
+
+template <int dim, int spacedim>
+unsigned int
+DataOutHDF5TimeSeries<dim, spacedim>::n_meshes() const
+{
+  return n_written_meshes;
+}
+
+
+
 // ---------------------------------------------- XDMFEntry ----------
 
 XDMFEntry::XDMFEntry()
@@ -21,6 +21,7 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <algorithm>
 #include <map>
 
 DEAL_II_NAMESPACE_OPEN
@@ -107,6 +108,58 @@ FunctionParser<dim>::value(const Point<dim>  &p,
   return this->do_value(p, this->get_time(), component);
 }
 
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value(const Point<dim> &p,
+                                  Vector<double>   &values) const
+{
+  AssertDimension(values.size(), this->n_components);
+  ArrayView<double> values_view(values.begin(), values.size());
+  this->do_all_values(p, this->get_time(), values_view);
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::value_list(const std::vector<Point<dim>> &points,
+                                std::vector<double>           &values,
+                                const unsigned int             component) const
+{
+  AssertDimension(values.size(), points.size());
+  this->do_value_list(make_array_view(points),
+                      this->get_time(),
+                      component,
+                      make_array_view(values));
+}
+
+
+
+template <int dim>
+void
+FunctionParser<dim>::vector_value_list(
+  const std::vector<Point<dim>> &points,
+  std::vector<Vector<double>>   &values) const
+{
+  AssertDimension(values.size(), points.size());
+
+  // write the results directly into the output vectors through one view per
+  // point, rather than evaluating into a temporary array first
+  std::vector<ArrayView<double>> values_views;
+  values_views.reserve(values.size());
+  for (Vector<double> &point_values : values)
+    {
+      AssertDimension(point_values.size(), this->n_components);
+      values_views.emplace_back(point_values.begin(), point_values.size());
+    }
+
+  this->do_all_values_list(make_array_view(points),
+                           this->get_time(),
+                           make_array_view(values_views));
+}
+
 // Explicit Instantiations.
 
 template class FunctionParser<1>;
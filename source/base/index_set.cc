@@ -16,6 +16,8 @@
 #include <deal.II/base/index_set.h>
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/mpi.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/exceptions.h>
 
@@ -107,6 +109,11 @@ IndexSet::do_compress() const
     // which itself calls the current function)
     std::lock_guard<std::mutex> lock(compress_mutex);
 
+    // another thread might have compressed the set while we were waiting
+    // for the mutex
+    if (is_compressed.load(std::memory_order_relaxed) == true)
+      return;
+
     // see if any of the contiguous ranges can be merged. do not use
     // std::vector::erase in-place as it is quadratic in the number of
     // ranges. since the ranges are sorted by their first index, determining
@@ -154,7 +161,7 @@ IndexSet::do_compress() const
             largest_range      = i - ranges.begin();
           }
       }
-    is_compressed = true;
+    is_compressed.store(true, std::memory_order_release);
 
     // check that next_index is correct. needs to be after the previous
     // statement because we otherwise will get into an endless loop
@@ -427,6 +434,42 @@ IndexSet::add_ranges_internal(
             &tmp_ranges,
   const bool ranges_are_sorted)
 {
+  // for large unsorted input, sort chunks of the ranges in parallel, convert
+  // each of them to an index set, and merge these. adding sorted ranges to
+  // an index set and merging two index sets are both linear operations
+  const std::size_t min_chunk_size = 8192;
+  const std::size_t n_chunks =
+    ranges_are_sorted ?
+      1 :
+      std::min<std::size_t>(MultithreadInfo::n_threads(),
+                            tmp_ranges.size() / min_chunk_size);
+  if (n_chunks > 1)
+    {
+      std::vector<IndexSet> chunk_sets(n_chunks, IndexSet(size()));
+      parallel::apply_to_subranges(
+        0u,
+        static_cast<unsigned int>(n_chunks),
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int chunk = begin; chunk < end; ++chunk)
+            {
+              const auto first =
+                tmp_ranges.begin() + tmp_ranges.size() * chunk / n_chunks;
+              const auto last =
+                tmp_ranges.begin() + tmp_ranges.size() * (chunk + 1) / n_chunks;
+              std::sort(first, last);
+              chunk_sets[chunk].ranges.reserve(last - first);
+              for (auto p = first; p != last; ++p)
+                chunk_sets[chunk].add_range(p->first, p->second);
+              chunk_sets[chunk].compress();
+            }
+        },
+        1);
+
+      for (const auto &chunk_set : chunk_sets)
+        add_indices(chunk_set);
+      return;
+    }
+
   if (!ranges_are_sorted)
     std::sort(tmp_ranges.begin(), tmp_ranges.end());
 
@@ -607,7 +650,9 @@ IndexSet::block_read(std::istream &in)
     in.read(reinterpret_cast<char *>(&*ranges.begin()),
             ranges.size() * sizeof(Range));
 
-  do_compress(); // needed so that largest_range can be recomputed
+  // needed so that largest_range can be recomputed
+  is_compressed = false;
+  do_compress();
 }
 
 
@@ -995,7 +1040,7 @@ std::size_t
 IndexSet::memory_consumption() const
 {
   return (MemoryConsumption::memory_consumption(ranges) +
-          MemoryConsumption::memory_consumption(is_compressed) +
+          MemoryConsumption::memory_consumption(is_compressed.load()) +
           MemoryConsumption::memory_consumption(index_space_size) +
           sizeof(compress_mutex));
 }
@@ -473,6 +473,124 @@ namespace internal
 #endif
     }
 
+
+
+    template <int dim, typename Number>
+    void
+    ParserImplementation<dim, Number>::do_value_list(
+      const ArrayView<const Point<dim>> &points,
+      const double                       time,
+      const unsigned int                 component,
+      const ArrayView<Number>           &values) const
+    {
+#ifdef DEAL_II_WITH_MUPARSER
+      Assert(this->initialized == true, ExcNotInitialized());
+      AssertDimension(values.size(), points.size());
+
+      // initialize the parser if that hasn't happened yet on the current
+      // thread
+      internal::FunctionParser::ParserData &data = this->parser_data.get();
+      if (data.vars.empty())
+        init_muparser();
+
+      AssertIndexRange(component, data.parsers.size());
+      if (dim != this->n_vars)
+        data.vars[dim] = time;
+
+      try
+        {
+          Assert(dynamic_cast<Parser *>(data.parsers[component].get()),
+                 ExcInternalError());
+          // NOLINTNEXTLINE don't warn about using static_cast once we check
+          mu::Parser &parser = static_cast<Parser &>(*data.parsers[component]);
+
+          // the variables are bound to data.vars by address, so the byte code
+          // can simply be re-evaluated after updating the coordinates
+          for (unsigned int q = 0; q < points.size(); ++q)
+            {
+              for (unsigned int i = 0; i < dim; ++i)
+                data.vars[i] = points[q][i];
+              values[q] = parser.Eval();
+            }
+        } // try
+      catch (mu::ParserError &e)
+        {
+          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+          std::cerr << "Token:    <" << e.GetToken() << ">\n";
+          std::cerr << "Position: <" << e.GetPos() << ">\n";
+          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+        } // catch
+#else
+      (void)points;
+      (void)time;
+      (void)component;
+      (void)values;
+      AssertThrow(false, ExcNeedsFunctionparser());
+#endif
+    }
+
+
+
+    template <int dim, typename Number>
+    void
+    ParserImplementation<dim, Number>::do_all_values_list(
+      const ArrayView<const Point<dim>>        &points,
+      const double                              time,
+      const ArrayView<const ArrayView<Number>> &values) const
+    {
+#ifdef DEAL_II_WITH_MUPARSER
+      Assert(this->initialized == true, ExcNotInitialized());
+
+      // initialize the parser if that hasn't happened yet on the current
+      // thread
+      internal::FunctionParser::ParserData &data = this->parser_data.get();
+      if (data.vars.empty())
+        init_muparser();
+
+      const unsigned int n_components = data.parsers.size();
+      AssertDimension(values.size(), points.size());
+      if (dim != this->n_vars)
+        data.vars[dim] = time;
+
+      try
+        {
+          for (unsigned int q = 0; q < points.size(); ++q)
+            {
+              for (unsigned int i = 0; i < dim; ++i)
+                data.vars[i] = points[q][i];
+              AssertDimension(values[q].size(), n_components);
+              for (unsigned int component = 0; component < n_components;
+                   ++component)
+                {
+                  Assert(dynamic_cast<Parser *>(data.parsers[component].get()),
+                         ExcInternalError());
+                  mu::Parser &parser =
+                    // We just checked that the pointer is valid so suppress
+                    // the clang-tidy check
+                    static_cast<Parser &>(*data.parsers[component]); // NOLINT
+                  values[q][component] = parser.Eval();
+                }
+            }
+        } // try
+      catch (mu::ParserError &e)
+        {
+          std::cerr << "Message:  <" << e.GetMsg() << ">\n";
+          std::cerr << "Formula:  <" << e.GetExpr() << ">\n";
+          std::cerr << "Token:    <" << e.GetToken() << ">\n";
+          std::cerr << "Position: <" << e.GetPos() << ">\n";
+          std::cerr << "Errc:     <" << e.GetCode() << ">" << std::endl;
+          AssertThrow(false, ExcParseError(e.GetCode(), e.GetMsg()));
+        } // catch
+#else
+      (void)points;
+      (void)time;
+      (void)values;
+      AssertThrow(false, ExcNeedsFunctionparser());
+#endif
+    }
+
 // explicit instantiations
 #include "mu_parser_internal.inst"
 
@@ -180,6 +180,28 @@ namespace Functions
 
 
 
+  template <int dim>
+  void
+  ParsedFunction<dim>::value_list(const std::vector<Point<dim>> &points,
+                                  std::vector<double>           &values,
+                                  const unsigned int component) const
+  {
+    function_object.value_list(points, values, component);
+  }
+
+
+
+  template <int dim>
+  void
+  ParsedFunction<dim>::vector_value_list(
+    const std::vector<Point<dim>> &points,
+    std::vector<Vector<double>>   &values) const
+  {
+    function_object.vector_value_list(points, values);
+  }
+
+
+
   template <int dim>
   void
   ParsedFunction<dim>::set_time(const double newtime)
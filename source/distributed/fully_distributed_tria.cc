@@ -629,8 +629,6 @@ namespace parallel
 
       AssertThrow(version == 4,
                   ExcMessage("Incompatible version found in .info file."));
-      Assert(this->n_global_active_cells() == n_global_active_cells,
-             ExcMessage("Number of global active cells differ!"));
 
       // Load description and construct the triangulation.
       {
@@ -710,6 +708,9 @@ namespace parallel
         this->create_triangulation(construction_data);
       }
 
+      Assert(this->n_global_active_cells() == n_global_active_cells,
+             ExcMessage("Number of global active cells differ!"));
+
       // clear all of the callback data, as explained in the documentation of
       // register_data_attach()
       this->cell_attached_data.n_attached_data_sets = 0;
@@ -414,41 +414,28 @@ namespace internal
                               });
       }
 
-      template <int spacedim>
+      /**
+       * Reserve space for the level DoF indices on vertices. Each vertex
+       * stores indices for the range of levels of the cells adjacent to it.
+       * The indices of all vertices are stored in one contiguous array
+       * (rather than in one allocation per vertex), which keeps the memory
+       * overhead per vertex low.
+       */
+      template <int dim, int spacedim>
       static void
-      reserve_space_mg(DoFHandler<1, spacedim> &dof_handler)
+      reserve_space_mg_vertices(DoFHandler<dim, spacedim> &dof_handler)
       {
-        Assert(dof_handler.get_triangulation().n_levels() > 0,
-               ExcMessage("Invalid triangulation"));
-        dof_handler.clear_mg_space();
-
-        const dealii::Triangulation<1, spacedim> &tria =
+        const dealii::Triangulation<dim, spacedim> &tria =
           dof_handler.get_triangulation();
-        const unsigned int dofs_per_line =
-          dof_handler.get_fe().n_dofs_per_line();
-        const unsigned int n_levels = tria.n_levels();
-
-        for (unsigned int i = 0; i < n_levels; ++i)
-          {
-            dof_handler.mg_levels.emplace_back(
-              new internal::DoFHandlerImplementation::DoFLevel<1>);
-            dof_handler.mg_levels.back()->dof_object.dofs =
-              std::vector<types::global_dof_index>(tria.n_raw_lines(i) *
-                                                     dofs_per_line,
-                                                   numbers::invalid_dof_index);
-          }
-
-        const unsigned int n_vertices = tria.n_vertices();
-
-        dof_handler.mg_vertex_dofs.resize(n_vertices);
+        const unsigned int n_levels        = tria.n_levels();
+        const unsigned int n_vertices      = tria.n_vertices();
+        const unsigned int dofs_per_vertex =
+          dof_handler.get_fe().n_dofs_per_vertex();
 
         std::vector<unsigned int> max_level(n_vertices, 0);
         std::vector<unsigned int> min_level(n_vertices, n_levels);
 
-        for (typename dealii::Triangulation<1, spacedim>::cell_iterator cell =
-               tria.begin();
-             cell != tria.end();
-             ++cell)
+        for (const auto &cell : tria.cell_iterators())
           {
             const unsigned int level = cell->level();
 
@@ -464,24 +451,67 @@ namespace internal
               }
           }
 
+        std::size_t n_indices = 0;
         for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
           if (tria.vertex_used(vertex))
             {
               Assert(min_level[vertex] < n_levels, ExcInternalError());
               Assert(max_level[vertex] >= min_level[vertex],
                      ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(
-                min_level[vertex],
-                max_level[vertex],
-                dof_handler.get_fe().n_dofs_per_vertex());
+              n_indices += static_cast<std::size_t>(max_level[vertex] -
+                                                    min_level[vertex] + 1) *
+                           dofs_per_vertex;
             }
-
           else
             {
               Assert(min_level[vertex] == n_levels, ExcInternalError());
               Assert(max_level[vertex] == 0, ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(1, 0, 0);
             }
+
+        dof_handler.mg_vertex_dof_indices.assign(n_indices,
+                                                 numbers::invalid_dof_index);
+        dof_handler.mg_vertex_dofs.resize(n_vertices);
+
+        types::global_dof_index *next_indices =
+          dof_handler.mg_vertex_dof_indices.data();
+        for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
+          if (tria.vertex_used(vertex))
+            {
+              dof_handler.mg_vertex_dofs[vertex].init(min_level[vertex],
+                                                      max_level[vertex],
+                                                      next_indices);
+              next_indices += (max_level[vertex] - min_level[vertex] + 1) *
+                              dofs_per_vertex;
+            }
+          else
+            dof_handler.mg_vertex_dofs[vertex].init(1, 0, nullptr);
+      }
+
+      template <int spacedim>
+      static void
+      reserve_space_mg(DoFHandler<1, spacedim> &dof_handler)
+      {
+        Assert(dof_handler.get_triangulation().n_levels() > 0,
+               ExcMessage("Invalid triangulation"));
+        dof_handler.clear_mg_space();
+
+        const dealii::Triangulation<1, spacedim> &tria =
+          dof_handler.get_triangulation();
+        const unsigned int dofs_per_line =
+          dof_handler.get_fe().n_dofs_per_line();
+        const unsigned int n_levels = tria.n_levels();
+
+        for (unsigned int i = 0; i < n_levels; ++i)
+          {
+            dof_handler.mg_levels.emplace_back(
+              new internal::DoFHandlerImplementation::DoFLevel<1>);
+            dof_handler.mg_levels.back()->dof_object.dofs =
+              std::vector<types::global_dof_index>(tria.n_raw_lines(i) *
+                                                     dofs_per_line,
+                                                   numbers::invalid_dof_index);
+          }
+
+        reserve_space_mg_vertices(dof_handler);
       }
 
       template <int spacedim>
@@ -516,49 +546,7 @@ namespace internal
                                                  fe.n_dofs_per_line(),
                                                numbers::invalid_dof_index);
 
-        const unsigned int n_vertices = tria.n_vertices();
-
-        dof_handler.mg_vertex_dofs.resize(n_vertices);
-
-        std::vector<unsigned int> max_level(n_vertices, 0);
-        std::vector<unsigned int> min_level(n_vertices, n_levels);
-
-        for (typename dealii::Triangulation<2, spacedim>::cell_iterator cell =
-               tria.begin();
-             cell != tria.end();
-             ++cell)
-          {
-            const unsigned int level = cell->level();
-
-            for (const auto vertex : cell->vertex_indices())
-              {
-                const unsigned int vertex_index = cell->vertex_index(vertex);
-
-                if (min_level[vertex_index] > level)
-                  min_level[vertex_index] = level;
-
-                if (max_level[vertex_index] < level)
-                  max_level[vertex_index] = level;
-              }
-          }
-
-        for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-          if (tria.vertex_used(vertex))
-            {
-              Assert(min_level[vertex] < n_levels, ExcInternalError());
-              Assert(max_level[vertex] >= min_level[vertex],
-                     ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(min_level[vertex],
-                                                      max_level[vertex],
-                                                      fe.n_dofs_per_vertex());
-            }
-
-          else
-            {
-              Assert(min_level[vertex] == n_levels, ExcInternalError());
-              Assert(max_level[vertex] == 0, ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(1, 0, 0);
-            }
+        reserve_space_mg_vertices(dof_handler);
       }
 
       template <int spacedim>
@@ -599,49 +587,7 @@ namespace internal
           tria.n_raw_quads() * fe.n_dofs_per_quad(0 /*=face_no*/),
           numbers::invalid_dof_index);
 
-        const unsigned int n_vertices = tria.n_vertices();
-
-        dof_handler.mg_vertex_dofs.resize(n_vertices);
-
-        std::vector<unsigned int> max_level(n_vertices, 0);
-        std::vector<unsigned int> min_level(n_vertices, n_levels);
-
-        for (typename dealii::Triangulation<3, spacedim>::cell_iterator cell =
-               tria.begin();
-             cell != tria.end();
-             ++cell)
-          {
-            const unsigned int level = cell->level();
-
-            for (const auto vertex : cell->vertex_indices())
-              {
-                const unsigned int vertex_index = cell->vertex_index(vertex);
-
-                if (min_level[vertex_index] > level)
-                  min_level[vertex_index] = level;
-
-                if (max_level[vertex_index] < level)
-                  max_level[vertex_index] = level;
-              }
-          }
-
-        for (unsigned int vertex = 0; vertex < n_vertices; ++vertex)
-          if (tria.vertex_used(vertex))
-            {
-              Assert(min_level[vertex] < n_levels, ExcInternalError());
-              Assert(max_level[vertex] >= min_level[vertex],
-                     ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(min_level[vertex],
-                                                      max_level[vertex],
-                                                      fe.n_dofs_per_vertex());
-            }
-
-          else
-            {
-              Assert(min_level[vertex] == n_levels, ExcInternalError());
-              Assert(max_level[vertex] == 0, ExcInternalError());
-              dof_handler.mg_vertex_dofs[vertex].init(1, 0, 0);
-            }
+        reserve_space_mg_vertices(dof_handler);
       }
     };
   } // namespace DoFHandlerImplementation
@@ -2127,11 +2073,8 @@ std::size_t DoFHandler<dim, spacedim>::memory_consumption() const
       if (this->mg_faces != nullptr)
         mem += MemoryConsumption::memory_consumption(*this->mg_faces);
 
-      for (unsigned int i = 0; i < this->mg_vertex_dofs.size(); ++i)
-        mem += sizeof(MGVertexDoFs) +
-               (1 + this->mg_vertex_dofs[i].get_finest_level() -
-                this->mg_vertex_dofs[i].get_coarsest_level()) *
-                 sizeof(types::global_dof_index);
+      mem += this->mg_vertex_dofs.capacity() * sizeof(MGVertexDoFs) +
+             MemoryConsumption::memory_consumption(this->mg_vertex_dof_indices);
     }
 
   return mem;
@@ -2392,6 +2335,10 @@ void DoFHandler<dim, spacedim>::clear_mg_space()
 
   std::swap(this->mg_vertex_dofs, tmp);
 
+  std::vector<types::global_dof_index> tmp_indices;
+
+  std::swap(this->mg_vertex_dof_indices, tmp_indices);
+
   this->mg_number_cache.clear();
 }
 
@@ -3149,6 +3096,7 @@ DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 DoFHandler<dim, spacedim>::MGVertexDoFs::MGVertexDoFs()
   : coarsest_level(numbers::invalid_unsigned_int)
   , finest_level(0)
+  , indices(nullptr)
 {}
 
 
@@ -3156,25 +3104,13 @@ DoFHandler<dim, spacedim>::MGVertexDoFs::MGVertexDoFs()
 template <int dim, int spacedim>
 DEAL_II_CXX20_REQUIRES((concepts::is_valid_dim_spacedim<dim, spacedim>))
 void DoFHandler<dim, spacedim>::MGVertexDoFs::init(
-  const unsigned int cl,
-  const unsigned int fl,
-  const unsigned int dofs_per_vertex)
+  const unsigned int       cl,
+  const unsigned int       fl,
+  types::global_dof_index *storage)
 {
   coarsest_level = cl;
   finest_level   = fl;
-
-  if (coarsest_level <= finest_level)
-    {
-      const unsigned int n_levels  = finest_level - coarsest_level + 1;
-      const unsigned int n_indices = n_levels * dofs_per_vertex;
-
-      indices = std::make_unique<types::global_dof_index[]>(n_indices);
-      std::fill(indices.get(),
-                indices.get() + n_indices,
-                numbers::invalid_dof_index);
-    }
-  else
-    indices.reset();
+  indices        = (coarsest_level <= finest_level ? storage : nullptr);
 }
 
 
@@ -16,6 +16,8 @@
 
 #include <deal.II/base/geometry_info.h>
 #include <deal.II/base/memory_consumption.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/partitioner.h>
 #include <deal.II/base/thread_management.h>
 #include <deal.II/base/types.h>
@@ -36,6 +38,8 @@
 #include <deal.II/grid/tria_iterator.h>
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <numeric>
@@ -50,6 +54,126 @@ namespace internal
   {
     namespace Policy
     {
+      /**
+       * Storage for the first cell, in the order of enumeration, each
+       * vertex, line, and quad belongs to, see
+       * enumerate_dofs_on_first_cells(). There is one slot for each line
+       * and quad of the triangulation. Vertices either have one slot each,
+       * for the enumeration of the active cells or of the cells of a single
+       * level, or one slot for each level they are used on, so that all
+       * levels can be enumerated concurrently. Lines and quads need no such
+       * distinction since they only ever belong to cells of one level.
+       */
+      template <int dim>
+      class FirstCellOfObjects
+      {
+      public:
+        /**
+         * Constructor. If @p per_level is true, set up separate vertex
+         * slots for all levels of @p tria.
+         */
+        template <int spacedim>
+        FirstCellOfObjects(const Triangulation<dim, spacedim> &tria,
+                           const bool                          per_level)
+        {
+          unsigned int n_vertex_slots = tria.n_vertices();
+          if (per_level)
+            {
+              std::vector<unsigned int> min_level(tria.n_vertices(),
+                                                  tria.n_levels());
+              std::vector<unsigned int> max_level(tria.n_vertices(), 0);
+              for (const auto &cell : tria.cell_iterators())
+                for (const unsigned int v : cell->vertex_indices())
+                  {
+                    const unsigned int vertex_index = cell->vertex_index(v);
+                    min_level[vertex_index] =
+                      std::min<unsigned int>(min_level[vertex_index],
+                                             cell->level());
+                    max_level[vertex_index] =
+                      std::max<unsigned int>(max_level[vertex_index],
+                                             cell->level());
+                  }
+
+              // the slots of a vertex are at level_zero_vertex_slot[v] +
+              // level for the levels between min_level[v] and
+              // max_level[v]; the subtraction below may wrap around, but
+              // adding a valid level wraps back into the right range
+              level_zero_vertex_slot.resize(tria.n_vertices());
+              n_vertex_slots = 0;
+              for (unsigned int v = 0; v < tria.n_vertices(); ++v)
+                if (min_level[v] <= max_level[v])
+                  {
+                    level_zero_vertex_slot[v] = n_vertex_slots - min_level[v];
+                    n_vertex_slots += max_level[v] - min_level[v] + 1;
+                  }
+            }
+
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              const unsigned int n_slots =
+                (d == 0 ? n_vertex_slots :
+                          (d == 1 ? tria.n_raw_lines() : tria.n_raw_quads()));
+              first_cell[d] = std::vector<std::atomic<unsigned int>>(n_slots);
+              for (auto &slot : first_cell[d])
+                slot.store(numbers::invalid_unsigned_int,
+                           std::memory_order_relaxed);
+            }
+        }
+
+        /**
+         * Return the slot of the object with index @p object_index and
+         * dimension @p structdim, seen from a cell on level @p level.
+         */
+        std::atomic<unsigned int> &
+        operator()(const unsigned int structdim,
+                   const unsigned int object_index,
+                   const unsigned int level)
+        {
+          return first_cell[structdim][slot_index(structdim,
+                                                  object_index,
+                                                  level)];
+        }
+
+        /**
+         * Same as above, for constant objects.
+         */
+        const std::atomic<unsigned int> &
+        operator()(const unsigned int structdim,
+                   const unsigned int object_index,
+                   const unsigned int level) const
+        {
+          return first_cell[structdim][slot_index(structdim,
+                                                  object_index,
+                                                  level)];
+        }
+
+      private:
+        unsigned int
+        slot_index(const unsigned int structdim,
+                   const unsigned int object_index,
+                   const unsigned int level) const
+        {
+          AssertIndexRange(structdim, dim);
+          if (structdim == 0 && !level_zero_vertex_slot.empty())
+            return level_zero_vertex_slot[object_index] + level;
+          else
+            return object_index;
+        }
+
+        /**
+         * For separate vertex slots per level, the slot a vertex would
+         * have on level zero. Empty otherwise.
+         */
+        std::vector<unsigned int> level_zero_vertex_slot;
+
+        /**
+         * The first cell for each slot of vertices, lines, and quads.
+         */
+        std::array<std::vector<std::atomic<unsigned int>>, dim> first_cell;
+      };
+
+
+
       namespace
       {
         /**
@@ -62,131 +186,243 @@ namespace internal
           numbers::invalid_dof_index - 1;
 
 
-        using DoFIdentities =
-          std::vector<std::pair<unsigned int, unsigned int>>;
-
 
         /**
-         * Make sure that the given @p identities pointer points to a
-         * valid array. If the pointer is zero beforehand, create an
-         * entry with the correct data. If it is nonzero, don't touch
-         * it.
-         *
-         * @p structdim denotes the dimension of the objects on which
-         * identities are to be represented, i.e. zero for vertices,
-         * one for lines, etc.
+         * A wrapper around one of the DoF operations of
+         * internal::DoFAccessorImplementation::Implementation (i.e.,
+         * DoFIndexProcessor or MGDoFIndexProcessor) that only hands the DoF
+         * indices of those objects to the DoF processor that are numbered on
+         * the current cell. These are the interior of the cell and all
+         * vertices, lines, and quads for which the current cell is the first
+         * cell, in the order of enumeration, they belong to. The DoF indices
+         * of all other objects are skipped.
          */
-        template <int structdim, int dim, int spacedim>
-        const std::unique_ptr<DoFIdentities> &
-        ensure_existence_and_return_dof_identities(
-          const dealii::hp::FECollection<dim, spacedim> &fes,
-          const types::fe_index                          fe_index_1,
-          const types::fe_index                          fe_index_2,
-          std::unique_ptr<DoFIdentities>                &identities,
-          const unsigned int face_no = numbers::invalid_unsigned_int)
+        template <int dim, int spacedim, typename DoFOperation>
+        struct DoFOperationOnFirstCell
         {
-          Assert(structdim == 2 || face_no == numbers::invalid_unsigned_int,
-                 ExcInternalError());
+          DoFOperationOnFirstCell(
+            const DoFOperation            &dof_operation,
+            const FirstCellOfObjects<dim> &first_cell_of_object,
+            const unsigned int             cell_number,
+            const unsigned int             cell_level)
+            : dof_operation(dof_operation)
+            , first_cell_of_object(first_cell_of_object)
+            , cell_number(cell_number)
+            , cell_level(cell_level)
+          {}
+
+          template <typename DoFProcessor>
+          void
+          process_vertex_dofs(DoFHandler<dim, spacedim> &dof_handler,
+                              const unsigned int         vertex_index,
+                              const types::fe_index      fe_index,
+                              types::global_dof_index  *&dof_indices_ptr,
+                              const DoFProcessor        &dof_processor) const
+          {
+            if (first_cell_of_object(0, vertex_index, cell_level) ==
+                cell_number)
+              dof_operation.process_vertex_dofs(dof_handler,
+                                                vertex_index,
+                                                fe_index,
+                                                dof_indices_ptr,
+                                                dof_processor);
+            else
+              dof_operation.process_vertex_dofs(dof_handler,
+                                                vertex_index,
+                                                fe_index,
+                                                dof_indices_ptr,
+                                                [](auto &, auto) {});
+          }
 
-          // see if we need to fill this entry, or whether it already
-          // exists
-          if (identities.get() == nullptr)
-            {
-              // TODO: Change to
-              // std::vector<std::map<types::fe_index, unsigned int>>
-              std::vector<std::map<unsigned int, unsigned int>>
-                complete_identities;
+          template <int structdim, typename DoFMapping, typename DoFProcessor>
+          void
+          process_dofs(const DoFHandler<dim, spacedim>             &dof_handler,
+                       const unsigned int                           obj_level,
+                       const unsigned int                           obj_index,
+                       const types::fe_index                        fe_index,
+                       const DoFMapping                            &mapping,
+                       const std::integral_constant<int, structdim> dd,
+                       types::global_dof_index                   *&dof_indices_ptr,
+                       const DoFProcessor &dof_processor) const
+          {
+            if (structdim >= dim ||
+                first_cell_of_object(structdim, obj_index, cell_level) ==
+                  cell_number)
+              dof_operation.process_dofs(dof_handler,
+                                         obj_level,
+                                         obj_index,
+                                         fe_index,
+                                         mapping,
+                                         dd,
+                                         dof_indices_ptr,
+                                         dof_processor);
+            else
+              dof_operation.process_dofs(dof_handler,
+                                         obj_level,
+                                         obj_index,
+                                         fe_index,
+                                         mapping,
+                                         dd,
+                                         dof_indices_ptr,
+                                         [](auto &, auto) {});
+          }
 
-              switch (structdim)
-                {
-                  case 0:
-                    {
-                      // TODO: Change set to types::fe_index
-                      complete_identities = fes.hp_vertex_dof_identities(
-                        std::set<unsigned int>{fe_index_1, fe_index_2});
-                      break;
-                    }
+        private:
+          const DoFOperation            &dof_operation;
+          const FirstCellOfObjects<dim> &first_cell_of_object;
+          const unsigned int             cell_number;
+          const unsigned int             cell_level;
+        };
 
-                  case 1:
-                    {
-                      // TODO: Change set to types::fe_index
-                      complete_identities = fes.hp_line_dof_identities(
-                        std::set<unsigned int>{fe_index_1, fe_index_2});
-                      break;
-                    }
 
-                  case 2:
-                    {
-                      // TODO: Change set to types::fe_index
-                      complete_identities = fes.hp_quad_dof_identities(
-                        std::set<unsigned int>{fe_index_1, fe_index_2},
-                        face_no);
-                      break;
-                    }
 
-                  default:
-                    Assert(false, ExcNotImplemented());
-                }
+        /**
+         * Assign consecutive indices, starting at zero, to all unnumbered
+         * degrees of freedom on the given @p cells, which must all be
+         * either active cells or cells on the same level, depending on
+         * whether @p dof_operation refers to active or level DoF indices.
+         * Only one finite element may be in use.
+         *
+         * The result is the same as the one of a loop over @p cells that
+         * assigns the next free index to every unnumbered DoF index in the
+         * order visited by process_dof_indices(). To be able to work on
+         * several cells concurrently, we first determine for every vertex,
+         * line, and quad the first cell in @p cells it belongs to, and
+         * store it in @p first_cell_of_object, whose slots for the objects
+         * of @p cells must be unused. Since the DoFs on an object are
+         * numbered on that cell only, each cell can count the DoFs it
+         * numbers independently of all others, and, after a prefix sum over
+         * these counts, enumerate them.
+         *
+         * Return the number of DoFs numbered.
+         */
+        template <int dim,
+                  int spacedim,
+                  typename CellIteratorType,
+                  typename DoFOperation>
+        types::global_dof_index
+        enumerate_dofs_on_first_cells(
+          const std::vector<CellIteratorType> &cells,
+          const DoFOperation                  &dof_operation,
+          const bool                           count_level_dofs,
+          FirstCellOfObjects<dim>             &first_cell_of_object)
+        {
+          if (cells.empty())
+            return 0;
+
+          // 1) find the first cell of each vertex, line, and quad
+          const auto record_cell = [](std::atomic<unsigned int> &first_cell,
+                                      const unsigned int         cell_number) {
+            unsigned int current = first_cell.load(std::memory_order_relaxed);
+            while (cell_number < current &&
+                   !first_cell.compare_exchange_weak(current,
+                                                     cell_number,
+                                                     std::memory_order_relaxed))
+              ;
+          };
 
-#ifdef DEBUG
-              // Each entry of 'complete_identities' contains a set of
-              // pairs (fe_index,dof_index). Because we put in exactly
-              // two fe indices, we know that each entry of the outer
-              // vector needs to contain a set of exactly two such
-              // pairs. Check this. While there, also check that
-              // the two entries actually reference fe_index_1 and
-              // fe_index_2:
-              for (const auto &complete_identity : complete_identities)
+          const unsigned int grain_size = 256;
+          dealii::parallel::apply_to_subranges(
+            0u,
+            static_cast<unsigned int>(cells.size()),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
                 {
-                  Assert(complete_identity.size() == 2, ExcInternalError());
-                  Assert(complete_identity.find(fe_index_1) !=
-                           complete_identity.end(),
-                         ExcInternalError());
-                  Assert(complete_identity.find(fe_index_2) !=
-                           complete_identity.end(),
-                         ExcInternalError());
+                  const auto        &cell  = cells[c];
+                  const unsigned int level = cell->level();
+                  for (const unsigned int v : cell->vertex_indices())
+                    record_cell(
+                      first_cell_of_object(0, cell->vertex_index(v), level),
+                      c);
+                  if (dim > 1)
+                    for (const unsigned int l : cell->line_indices())
+                      record_cell(
+                        first_cell_of_object(1, cell->line_index(l), level),
+                        c);
+                  if (dim > 2)
+                    for (const unsigned int f : cell->face_indices())
+                      record_cell(
+                        first_cell_of_object(2, cell->quad_index(f), level),
+                        c);
                 }
-#endif
-
-              // Next reduce these sets of two pairs by removing the
-              // fe_index parts: We know which indices we have. But we
-              // have to make sure in which order we consider the
-              // pair, by considering whether the fe_index part we are
-              // throwing away matched fe_index_1 or fe_index_2. Fortunately,
-              // this is easy to do because we can ask the std::map for the
-              // dof_index that matches a given fe_index:
-              DoFIdentities reduced_identities;
-              for (const auto &complete_identity : complete_identities)
+            },
+            grain_size);
+
+          // 2) count the DoFs numbered on each cell
+          std::vector<types::global_dof_index> first_dof_on_cell(cells.size() +
+                                                                 1);
+          dealii::parallel::apply_to_subranges(
+            0u,
+            static_cast<unsigned int>(cells.size()),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
                 {
-                  const unsigned int dof_index_1 =
-                    complete_identity.at(fe_index_1);
-                  const unsigned int dof_index_2 =
-                    complete_identity.at(fe_index_2);
-
-                  reduced_identities.emplace_back(dof_index_1, dof_index_2);
+                  types::global_dof_index n_dofs = 0;
+                  DoFAccessorImplementation::Implementation::
+                    process_dof_indices(
+                      *cells[c],
+                      std::make_tuple(),
+                      DoFHandler<dim, spacedim>::default_fe_index,
+                      DoFOperationOnFirstCell<dim, spacedim, DoFOperation>(
+                        dof_operation,
+                        first_cell_of_object,
+                        c,
+                        cells[c]->level()),
+                      [&n_dofs](auto &stored_index, auto) {
+                        if (stored_index == numbers::invalid_dof_index)
+                          ++n_dofs;
+                      },
+                      count_level_dofs);
+                  first_dof_on_cell[c + 1] = n_dofs;
                 }
-
-#ifdef DEBUG
-              // double check whether the newly created entries make
-              // any sense at all
-              for (const auto &identity : reduced_identities)
+            },
+            grain_size);
+
+          std::partial_sum(first_dof_on_cell.begin(),
+                           first_dof_on_cell.end(),
+                           first_dof_on_cell.begin());
+
+          AssertThrow(
+            first_dof_on_cell.back() <
+              std::numeric_limits<types::global_dof_index>::max(),
+            ExcMessage(
+              "You have reached the maximal number of degrees of "
+              "freedom that can be stored in the chosen data "
+              "type. In practice, this can only happen if you "
+              "are using 32-bit data types. You will have to "
+              "re-compile deal.II with the "
+              "`DEAL_II_WITH_64BIT_INDICES' flag set to `ON'."));
+
+          // 3) enumerate the DoFs, starting on each cell after the ones of
+          //    all previous cells
+          dealii::parallel::apply_to_subranges(
+            0u,
+            static_cast<unsigned int>(cells.size()),
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int c = begin; c < end; ++c)
                 {
-                  Assert(identity.first <
-                           fes[fe_index_1]
-                             .template n_dofs_per_object<structdim>(face_no),
-                         ExcInternalError());
-                  Assert(identity.second <
-                           fes[fe_index_2]
-                             .template n_dofs_per_object<structdim>(face_no),
-                         ExcInternalError());
+                  types::global_dof_index next_free_dof = first_dof_on_cell[c];
+                  DoFAccessorImplementation::Implementation::
+                    process_dof_indices(
+                      *cells[c],
+                      std::make_tuple(),
+                      DoFHandler<dim, spacedim>::default_fe_index,
+                      DoFOperationOnFirstCell<dim, spacedim, DoFOperation>(
+                        dof_operation,
+                        first_cell_of_object,
+                        c,
+                        cells[c]->level()),
+                      [&next_free_dof](auto &stored_index, auto) {
+                        if (stored_index == numbers::invalid_dof_index)
+                          stored_index = next_free_dof++;
+                      },
+                      count_level_dofs);
+                  AssertDimension(next_free_dof, first_dof_on_cell[c + 1]);
                 }
-#endif
-
-              identities =
-                std::make_unique<DoFIdentities>(std::move(reduced_identities));
-            }
+            },
+            grain_size);
 
-          return identities;
+          return first_dof_on_cell.back();
         }
       } // namespace
 
@@ -197,34 +433,29 @@ namespace internal
         /* -------------- distribute_dofs functionality ------------- */
 
         /**
-         * Compute identities between DoFs located on vertices. Called from
-         * distribute_dofs().
+         * Compute identities between DoFs located on the vertices with
+         * indices in the range [begin_vertex, end_vertex) and add them to
+         * @p dof_identities. Called from compute_vertex_dof_identities().
          */
         template <int dim, int spacedim>
-        static std::map<types::global_dof_index, types::global_dof_index>
-        compute_vertex_dof_identities(
-          const DoFHandler<dim, spacedim> &dof_handler)
-        {
-          Assert(
-            dof_handler.hp_capability_enabled == true,
-            (typename DoFHandler<dim, spacedim>::ExcOnlyAvailableWithHP()));
-
+        static void
+        compute_vertex_dof_identities_on_range(
+          const DoFHandler<dim, spacedim> &dof_handler,
+          const unsigned int               begin_vertex,
+          const unsigned int               end_vertex,
           std::map<types::global_dof_index, types::global_dof_index>
-            dof_identities;
-
+            &dof_identities)
+        {
           // Note: we may wish to have something here similar to what
           // we do for lines and quads, namely that we only identify
           // dofs for any FE towards the most dominating one. however,
           // it is not clear whether this is actually necessary for
           // vertices at all, I can't think of a finite element that
           // would make that necessary...
-          dealii::Table<2, std::unique_ptr<DoFIdentities>>
-            vertex_dof_identities(dof_handler.get_fe_collection().size(),
-                                  dof_handler.get_fe_collection().size());
 
           // loop over all vertices and see which one we need to work on
-          for (unsigned int vertex_index = 0;
-               vertex_index < dof_handler.get_triangulation().n_vertices();
+          for (unsigned int vertex_index = begin_vertex;
+               vertex_index < end_vertex;
                ++vertex_index)
             if (dof_handler.get_triangulation()
                   .get_used_vertices()[vertex_index] == true)
@@ -274,15 +505,14 @@ namespace internal
                     for (const auto &other_fe_index : fe_indices)
                       if (other_fe_index != most_dominating_fe_index)
                         {
-                          // make sure the entry in the equivalence
-                          // table exists
+                          // get the identities between the two elements;
+                          // the FECollection computes them only once
                           const auto &identities =
-                            *ensure_existence_and_return_dof_identities<0>(
-                              dof_handler.get_fe_collection(),
-                              most_dominating_fe_index,
-                              other_fe_index,
-                              vertex_dof_identities[most_dominating_fe_index]
-                                                   [other_fe_index]);
+                            dof_handler.get_fe_collection()
+                              .hp_object_dof_identities(
+                                0,
+                                most_dominating_fe_index,
+                                other_fe_index);
 
                           // then loop through the identities we
                           // have. first get the global numbers of the
@@ -353,6 +583,62 @@ namespace internal
                         }
                   }
               }
+        }
+
+
+
+        /**
+         * Compute identities between DoFs located on vertices. Called from
+         * distribute_dofs().
+         *
+         * The identities found on different vertices are independent of each
+         * other, so we compute them on chunks of vertices concurrently and
+         * merge the results in the order of the chunks afterwards. This
+         * yields the same map as a sequential loop over all vertices.
+         */
+        template <int dim, int spacedim>
+        static std::map<types::global_dof_index, types::global_dof_index>
+        compute_vertex_dof_identities(
+          const DoFHandler<dim, spacedim> &dof_handler)
+        {
+          Assert(
+            dof_handler.hp_capability_enabled == true,
+            (typename DoFHandler<dim, spacedim>::ExcOnlyAvailableWithHP()));
+
+          const unsigned int n_vertices =
+            dof_handler.get_triangulation().n_vertices();
+          const unsigned int n_chunks =
+            (MultithreadInfo::is_running_single_threaded() ?
+               1 :
+               std::max(1u,
+                        std::min(4 * MultithreadInfo::n_threads(),
+                                 n_vertices / 1024)));
+
+          std::vector<
+            std::map<types::global_dof_index, types::global_dof_index>>
+            dof_identities_on_chunk(n_chunks);
+          dealii::parallel::apply_to_subranges(
+            0u,
+            n_chunks,
+            [&](const unsigned int begin, const unsigned int end) {
+              for (unsigned int chunk = begin; chunk < end; ++chunk)
+                compute_vertex_dof_identities_on_range(
+                  dof_handler,
+                  static_cast<unsigned int>(std::uint64_t(n_vertices) *
+                                            chunk / n_chunks),
+                  static_cast<unsigned int>(std::uint64_t(n_vertices) *
+                                            (chunk + 1) / n_chunks),
+                  dof_identities_on_chunk[chunk]);
+            },
+            1);
+
+          // later vertices overwrite identities of earlier ones, as they
+          // would in a sequential loop
+          std::map<types::global_dof_index, types::global_dof_index>
+            dof_identities = std::move(dof_identities_on_chunk[0]);
+          for (unsigned int chunk = 1; chunk < n_chunks; ++chunk)
+            for (const auto &identity : dof_identities_on_chunk[chunk])
+              dof_identities[identity.first] = identity.second;
 
           return dof_identities;
         }
@@ -405,8 +691,6 @@ namespace internal
           // pairs of finite elements that have *identical* dofs, and then only
           // deal with those that are not identical of which we can handle at
           // most 2
-          dealii::Table<2, std::unique_ptr<DoFIdentities>> line_dof_identities(
-            dof_handler.fe_collection.size(), dof_handler.fe_collection.size());
 
           std::vector<bool> line_touched(
             dof_handler.get_triangulation().n_raw_lines());
@@ -459,11 +743,10 @@ namespace internal
                               dof_handler.get_fe(fe_index_1).n_dofs_per_line();
 
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<1>(
-                                dof_handler.get_fe_collection(),
-                                fe_index_1,
-                                fe_index_2,
-                                line_dof_identities[fe_index_1][fe_index_2]);
+                              dof_handler.get_fe_collection()
+                                .hp_object_dof_identities(1,
+                                                          fe_index_1,
+                                                          fe_index_2);
                             // see if these sets of dofs are identical. the
                             // first condition for this is that indeed there are
                             // n identities
@@ -649,13 +932,11 @@ namespace internal
                             if (other_fe_index != most_dominating_fe_index)
                               {
                                 const auto &identities =
-                                  *ensure_existence_and_return_dof_identities<
-                                    1>(dof_handler.get_fe_collection(),
-                                       most_dominating_fe_index,
-                                       other_fe_index,
-                                       line_dof_identities
-                                         [most_dominating_fe_index]
-                                         [other_fe_index]);
+                                  dof_handler.get_fe_collection()
+                                    .hp_object_dof_identities(
+                                      1,
+                                      most_dominating_fe_index,
+                                      other_fe_index);
 
                                 for (const auto &identity : identities)
                                   {
@@ -761,10 +1042,6 @@ namespace internal
           // trouble. note that this only happens for lines in 3d and
           // higher, and for quads only in 4d and higher, so this
           // isn't a particularly frequent case
-          dealii::Table<3, std::unique_ptr<DoFIdentities>> quad_dof_identities(
-            dof_handler.fe_collection.size(),
-            dof_handler.fe_collection.size(),
-            2 /*triangle (0) or quadrilateral (1)*/);
 
           std::vector<bool> quad_touched(
             dof_handler.get_triangulation().n_raw_quads());
@@ -808,15 +1085,12 @@ namespace internal
                         if (other_fe_index != most_dominating_fe_index)
                           {
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<2>(
-                                dof_handler.get_fe_collection(),
-                                most_dominating_fe_index,
-                                other_fe_index,
-                                quad_dof_identities
-                                  [most_dominating_fe_index][other_fe_index]
-                                  [cell->quad(q)->reference_cell() ==
-                                   ReferenceCells::Quadrilateral],
-                                most_dominating_fe_index_face_no);
+                              dof_handler.get_fe_collection()
+                                .hp_object_dof_identities(
+                                  2,
+                                  most_dominating_fe_index,
+                                  other_fe_index,
+                                  most_dominating_fe_index_face_no);
 
                             for (const auto &identity : identities)
                               {
@@ -1041,9 +1315,6 @@ namespace internal
           // it is not clear whether this is actually necessary for
           // vertices at all, I can't think of a finite element that
           // would make that necessary...
-          dealii::Table<2, std::unique_ptr<DoFIdentities>>
-            vertex_dof_identities(dof_handler.get_fe_collection().size(),
-                                  dof_handler.get_fe_collection().size());
 
           // mark all vertices on ghost cells to identify those cells that we
           // have already treated
@@ -1110,15 +1381,14 @@ namespace internal
                     for (const auto &other_fe_index : fe_indices)
                       if (other_fe_index != most_dominating_fe_index)
                         {
-                          // make sure the entry in the equivalence
-                          // table exists
+                          // get the identities between the two elements;
+                          // the FECollection computes them only once
                           const auto &identities =
-                            *ensure_existence_and_return_dof_identities<0>(
-                              dof_handler.get_fe_collection(),
-                              most_dominating_fe_index,
-                              other_fe_index,
-                              vertex_dof_identities[most_dominating_fe_index]
-                                                   [other_fe_index]);
+                            dof_handler.get_fe_collection()
+                              .hp_object_dof_identities(
+                                0,
+                                most_dominating_fe_index,
+                                other_fe_index);
 
                           // then loop through the identities we
                           // have. first get the global numbers of the
@@ -1234,8 +1504,6 @@ namespace internal
           // pairs of finite elements that have *identical* dofs, and then only
           // deal with those that are not identical of which we can handle at
           // most 2
-          dealii::Table<2, std::unique_ptr<DoFIdentities>> line_dof_identities(
-            dof_handler.fe_collection.size(), dof_handler.fe_collection.size());
 
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto l : cell->line_indices())
@@ -1271,11 +1539,10 @@ namespace internal
                               dof_handler.get_fe(fe_index_1).n_dofs_per_line();
 
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<1>(
-                                dof_handler.get_fe_collection(),
-                                fe_index_1,
-                                fe_index_2,
-                                line_dof_identities[fe_index_1][fe_index_2]);
+                              dof_handler.get_fe_collection()
+                                .hp_object_dof_identities(1,
+                                                          fe_index_1,
+                                                          fe_index_2);
                             // see if these sets of dofs are identical. the
                             // first condition for this is that indeed there are
                             // n identities
@@ -1401,13 +1668,11 @@ namespace internal
                             if (other_fe_index != most_dominating_fe_index)
                               {
                                 const auto &identities =
-                                  *ensure_existence_and_return_dof_identities<
-                                    1>(dof_handler.get_fe_collection(),
-                                       most_dominating_fe_index,
-                                       other_fe_index,
-                                       line_dof_identities
-                                         [most_dominating_fe_index]
-                                         [other_fe_index]);
+                                  dof_handler.get_fe_collection()
+                                    .hp_object_dof_identities(
+                                      1,
+                                      most_dominating_fe_index,
+                                      other_fe_index);
 
                                 for (const auto &identity : identities)
                                   {
@@ -1498,10 +1763,6 @@ namespace internal
           // trouble. note that this only happens for lines in 3d and
           // higher, and for quads only in 4d and higher, so this
           // isn't a particularly frequent case
-          dealii::Table<3, std::unique_ptr<DoFIdentities>> quad_dof_identities(
-            dof_handler.fe_collection.size(),
-            dof_handler.fe_collection.size(),
-            2 /*triangle (0) or quadrilateral (1)*/);
 
           for (const auto &cell : dof_handler.active_cell_iterators())
             for (const auto q : cell->face_indices())
@@ -1544,15 +1805,12 @@ namespace internal
                         if (other_fe_index != most_dominating_fe_index)
                           {
                             const auto &identities =
-                              *ensure_existence_and_return_dof_identities<2>(
-                                dof_handler.get_fe_collection(),
-                                most_dominating_fe_index,
-                                other_fe_index,
-                                quad_dof_identities
-                                  [most_dominating_fe_index][other_fe_index]
-                                  [cell->quad(q)->reference_cell() ==
-                                   ReferenceCells::Quadrilateral],
-                                most_dominating_fe_index_face_no);
+                              dof_handler.get_fe_collection()
+                                .hp_object_dof_identities(
+                                  2,
+                                  most_dominating_fe_index,
+                                  other_fe_index,
+                                  most_dominating_fe_index_face_no);
 
                             for (const auto &identity : identities)
                               {
@@ -1652,6 +1910,31 @@ namespace internal
           Assert(dof_handler.get_triangulation().n_levels() > 0,
                  ExcMessage("Empty triangulation"));
 
+          // without hp-capabilities, there is only one finite element and
+          // the DoFs can be enumerated on many cells concurrently, resulting
+          // in the same numbering as the sequential loop below
+          if (dof_handler.hp_capability_enabled == false)
+            {
+              std::vector<
+                typename DoFHandler<dim, spacedim>::active_cell_iterator>
+                cells;
+              cells.reserve(dof_handler.get_triangulation().n_active_cells());
+              for (const auto &cell : dof_handler.active_cell_iterators())
+                if (!cell->is_artificial() &&
+                    ((subdomain_id == numbers::invalid_subdomain_id) ||
+                     (cell->subdomain_id() == subdomain_id)))
+                  cells.push_back(cell);
+
+              FirstCellOfObjects<dim> first_cell_of_object(
+                dof_handler.get_triangulation(), false);
+              return enumerate_dofs_on_first_cells<dim, spacedim>(
+                cells,
+                DoFAccessorImplementation::Implementation::
+                  DoFIndexProcessor<dim, spacedim>(),
+                false,
+                first_cell_of_object);
+            }
+
           // distribute dofs on all cells excluding artificial ones
           types::global_dof_index next_free_dof = 0;
 
@@ -1742,11 +2025,21 @@ namespace internal
 
 
 
+        /**
+         * Enumerate the level DoFs on the cells of @p level, or only those
+         * with @p level_subdomain_id as level subdomain id if it is valid.
+         * The first cells of vertices, lines, and quads are recorded in
+         * @p first_cell_of_object, which may be shared by concurrent calls
+         * for different levels if it was set up with separate vertex slots
+         * per level.
+         */
         template <int dim, int spacedim>
         static types::global_dof_index
-        distribute_dofs_on_level(const types::subdomain_id  level_subdomain_id,
-                                 DoFHandler<dim, spacedim> &dof_handler,
-                                 const unsigned int         level)
+        distribute_dofs_on_level(
+          const types::subdomain_id  level_subdomain_id,
+          DoFHandler<dim, spacedim> &dof_handler,
+          const unsigned int         level,
+          FirstCellOfObjects<dim>   &first_cell_of_object)
         {
           Assert(dof_handler.hp_capability_enabled == false,
                  ExcInternalError());
@@ -1757,39 +2050,43 @@ namespace internal
           if (level >= tria.n_levels())
             return 0; // this is allowed for multigrid
 
-          types::global_dof_index next_free_dof = 0;
-
-          for (auto cell : dof_handler.cell_iterators_on_level(level))
+          std::vector<typename DoFHandler<dim, spacedim>::level_cell_iterator>
+            cells;
+          for (const auto &cell : dof_handler.cell_iterators_on_level(level))
             if ((level_subdomain_id == numbers::invalid_subdomain_id) ||
                 (cell->level_subdomain_id() == level_subdomain_id))
-              {
-                DoFAccessorImplementation::Implementation::process_dof_indices(
-                  *cell,
-                  std::make_tuple(),
-                  0,
-                  DoFAccessorImplementation::Implementation::
-                    MGDoFIndexProcessor<dim, spacedim>(level),
-                  [&next_free_dof](auto &stored_index, auto) {
-                    if (stored_index == numbers::invalid_dof_index)
-                      {
-                        stored_index = next_free_dof;
-                        Assert(
-                          next_free_dof !=
-                            std::numeric_limits<types::global_dof_index>::max(),
-                          ExcMessage(
-                            "You have reached the maximal number of degrees of "
-                            "freedom that can be stored in the chosen data "
-                            "type. In practice, this can only happen if you "
-                            "are using 32-bit data types. You will have to "
-                            "re-compile deal.II with the "
-                            "`DEAL_II_WITH_64BIT_INDICES' flag set to `ON'."));
-                        ++next_free_dof;
-                      }
-                  },
-                  true);
-              }
+              cells.push_back(cell);
+
+          return enumerate_dofs_on_first_cells<dim, spacedim>(
+            cells,
+            DoFAccessorImplementation::Implementation::MGDoFIndexProcessor<
+              dim,
+              spacedim>(level),
+            true,
+            first_cell_of_object);
+        }
 
-          return next_free_dof;
+
+
+        /**
+         * Same as above, but with storage for the first cells of the
+         * objects on @p level only.
+         */
+        template <int dim, int spacedim>
+        static types::global_dof_index
+        distribute_dofs_on_level(const types::subdomain_id  level_subdomain_id,
+                                 DoFHandler<dim, spacedim> &dof_handler,
+                                 const unsigned int         level)
+        {
+          if (level >= dof_handler.get_triangulation().n_levels())
+            return 0; // this is allowed for multigrid
+
+          FirstCellOfObjects<dim> first_cell_of_object(
+            dof_handler.get_triangulation(), false);
+          return distribute_dofs_on_level(level_subdomain_id,
+                                          dof_handler,
+                                          level,
+                                          first_cell_of_object);
         }
 
 
@@ -2671,20 +2968,33 @@ namespace internal
       std::vector<NumberCache>
       Sequential<dim, spacedim>::distribute_mg_dofs() const
       {
-        std::vector<NumberCache> number_caches;
-        number_caches.reserve(dof_handler->get_triangulation().n_levels());
-        for (unsigned int level = 0;
-             level < dof_handler->get_triangulation().n_levels();
-             ++level)
-          {
-            // first distribute dofs on this level
-            const types::global_dof_index n_level_dofs =
-              Implementation::distribute_dofs_on_level(
-                numbers::invalid_subdomain_id, *dof_handler, level);
+        // the levels are enumerated independently of each other: every
+        // vertex stores separate indices for each level, and lines, quads,
+        // and cells are only ever part of cells on their own level. we can
+        // therefore work on all levels concurrently. the levels share one
+        // set of first cells, with separate slots per level for vertices,
+        // so that the memory used does not grow with the number of levels
+        const unsigned int n_levels =
+          dof_handler->get_triangulation().n_levels();
+        FirstCellOfObjects<dim> first_cell_of_object(
+          dof_handler->get_triangulation(), true);
+        std::vector<types::global_dof_index> n_level_dofs(n_levels);
+        Threads::TaskGroup<void>             tasks;
+        for (unsigned int level = 0; level < n_levels; ++level)
+          tasks += Threads::new_task([&, level]() {
+            n_level_dofs[level] = Implementation::distribute_dofs_on_level(
+              numbers::invalid_subdomain_id,
+              *dof_handler,
+              level,
+              first_cell_of_object);
+          });
+        tasks.join_all();
 
-            // then add a complete, sequential index set
-            number_caches.emplace_back(n_level_dofs);
-          }
+        // then add a complete, sequential index set for each level
+        std::vector<NumberCache> number_caches;
+        number_caches.reserve(n_levels);
+        for (unsigned int level = 0; level < n_levels; ++level)
+          number_caches.emplace_back(n_level_dofs[level]);
 
         return number_caches;
       }
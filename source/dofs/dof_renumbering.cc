@@ -662,6 +662,95 @@ namespace DoFRenumbering
 
 
 
+  template <int dim, int spacedim>
+  void
+  nested_dissection(DoFHandler<dim, spacedim> &dof_handler,
+                    const bool                 use_constraints)
+  {
+    std::vector<types::global_dof_index> renumbering(
+      dof_handler.locally_owned_dofs().n_elements(),
+      numbers::invalid_dof_index);
+    compute_nested_dissection(renumbering, dof_handler, use_constraints);
+
+    dof_handler.renumber_dofs(renumbering);
+  }
+
+
+
+  template <int dim, int spacedim>
+  void
+  compute_nested_dissection(std::vector<types::global_dof_index> &new_indices,
+                            const DoFHandler<dim, spacedim> &dof_handler,
+                            const bool use_constraints)
+  {
+    const IndexSet &locally_owned_dofs = dof_handler.locally_owned_dofs();
+    if (locally_owned_dofs.n_elements() == 0)
+      {
+        Assert(new_indices.empty(), ExcInternalError());
+        return;
+      }
+    AssertDimension(new_indices.size(), locally_owned_dofs.n_elements());
+
+    AffineConstraints<double> constraints;
+    if (use_constraints)
+      {
+        constraints.reinit(locally_owned_dofs,
+                           DoFTools::extract_locally_relevant_dofs(
+                             dof_handler));
+        DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+      }
+    constraints.close();
+
+    // make the connection graph of the locally owned dofs, in the local
+    // index space if we are working on a parallel triangulation
+    DynamicSparsityPattern local_sparsity;
+    if (locally_owned_dofs.n_elements() == locally_owned_dofs.size())
+      {
+        local_sparsity.reinit(dof_handler.n_dofs(), dof_handler.n_dofs());
+        DoFTools::make_sparsity_pattern(dof_handler,
+                                        local_sparsity,
+                                        constraints);
+      }
+    else
+      {
+        DynamicSparsityPattern dsp(locally_owned_dofs.size(),
+                                   locally_owned_dofs.size(),
+                                   locally_owned_dofs);
+        DoFTools::make_sparsity_pattern(dof_handler, dsp, constraints);
+
+        local_sparsity.reinit(locally_owned_dofs.n_elements(),
+                              locally_owned_dofs.n_elements());
+        std::vector<types::global_dof_index> row_entries;
+        for (unsigned int i = 0; i < locally_owned_dofs.n_elements(); ++i)
+          {
+            const types::global_dof_index row =
+              locally_owned_dofs.nth_index_in_set(i);
+            const unsigned int row_length = dsp.row_length(row);
+            row_entries.clear();
+            for (unsigned int j = 0; j < row_length; ++j)
+              {
+                const types::global_dof_index col = dsp.column_number(row, j);
+                if (col != row && locally_owned_dofs.is_element(col))
+                  row_entries.push_back(
+                    locally_owned_dofs.index_within_set(col));
+              }
+            local_sparsity.add_entries(i,
+                                       row_entries.begin(),
+                                       row_entries.end(),
+                                       true);
+          }
+      }
+
+    SparsityTools::reorder_nested_dissection(local_sparsity, new_indices);
+
+    // convert indices back to the global index space
+    if (locally_owned_dofs.n_elements() != locally_owned_dofs.size())
+      for (types::global_dof_index &new_index : new_indices)
+        new_index = locally_owned_dofs.nth_index_in_set(new_index);
+  }
+
+
+
   template <int dim, int spacedim>
   void
   component_wise(DoFHandler<dim, spacedim>       &dof_handler,
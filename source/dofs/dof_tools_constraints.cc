@@ -13,6 +13,9 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/array_view.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 #include <deal.II/base/table.h>
 #include <deal.II/base/template_constraints.h>
 #include <deal.II/base/utilities.h>
@@ -46,6 +49,7 @@
 #include <array>
 #include <memory>
 #include <numeric>
+#include <unordered_set>
 
 DEAL_II_NAMESPACE_OPEN
 
@@ -483,13 +487,16 @@ namespace DoFTools
        * It also suppresses very small entries in the AffineConstraints object
        * to avoid making the sparsity pattern fuller than necessary.
        */
-      template <typename number1, typename number2>
+      template <typename number1,
+                typename number2,
+                template <typename>
+                class ConstraintsType>
       void
       filter_constraints(
         const std::vector<types::global_dof_index> &primary_dofs,
         const std::vector<types::global_dof_index> &dependent_dofs,
         const FullMatrix<number1>                  &face_constraints,
-        AffineConstraints<number2>                 &constraints)
+        ConstraintsType<number2>                   &constraints)
       {
         Assert(face_constraints.n() == primary_dofs.size(),
                ExcDimensionMismatch(primary_dofs.size(), face_constraints.n()));
@@ -509,9 +516,7 @@ namespace DoFTools
           Assert(primary_dofs[col] != numbers::invalid_dof_index,
                  ExcInternalError());
 
-        std::vector<
-          std::pair<typename AffineConstraints<number2>::size_type, number2>>
-          entries;
+        std::vector<std::pair<types::global_dof_index, number2>> entries;
         entries.reserve(n_primary_dofs);
         for (unsigned int row = 0; row != n_dependent_dofs; ++row)
           if (constraints.is_constrained(dependent_dofs[row]) == false)
@@ -577,9 +582,104 @@ namespace DoFTools
             }
       }
 
+
     } // namespace
 
 
+    /**
+     * Collect the constraints that filter_constraints() creates for one
+     * chunk of cells in make_hp_hanging_node_constraints(). This class
+     * provides the functions of AffineConstraints used there, but only
+     * stores the constrained DoFs and their entries in the order in which
+     * they were added. Its memory therefore grows with the number of
+     * constraints of the chunk, rather than with the largest constrained
+     * DoF index as the cache of an AffineConstraints object does.
+     */
+    template <typename number>
+    class ChunkConstraints
+    {
+    public:
+      bool
+      is_constrained(const types::global_dof_index index) const
+      {
+        return constrained_dofs.find(index) != constrained_dofs.end();
+      }
+
+      void
+      add_line(const types::global_dof_index index)
+      {
+        Assert(is_constrained(index) == false, ExcInternalError());
+        constrained_dofs.insert(index);
+        lines.push_back(index);
+        entry_starts.push_back(entries.size());
+      }
+
+      void
+      add_entries(
+        const types::global_dof_index index,
+        const std::vector<std::pair<types::global_dof_index, number>>
+          &col_weight_pairs)
+      {
+        (void)index;
+        Assert(lines.size() > 0 && lines.back() == index, ExcInternalError());
+        entries.insert(entries.end(),
+                       col_weight_pairs.begin(),
+                       col_weight_pairs.end());
+      }
+
+      void
+      set_inhomogeneity(const types::global_dof_index index,
+                        const number                  value)
+      {
+        (void)index;
+        (void)value;
+        Assert(value == number(), ExcInternalError());
+      }
+
+      /**
+       * Add the collected constraints to @p constraints, skipping the DoFs
+       * that are already constrained there.
+       */
+      void
+      copy_to(AffineConstraints<number> &constraints) const
+      {
+        std::vector<std::pair<types::global_dof_index, number>> line_entries;
+        for (std::size_t i = 0; i < lines.size(); ++i)
+          if (constraints.is_constrained(lines[i]) == false)
+            {
+              const std::size_t end =
+                (i + 1 < lines.size()) ? entry_starts[i + 1] : entries.size();
+              line_entries.assign(entries.begin() + entry_starts[i],
+                                  entries.begin() + end);
+              constraints.add_line(lines[i]);
+              constraints.add_entries(lines[i], line_entries);
+            }
+      }
+
+    private:
+      /**
+       * The constrained DoFs, for fast lookup in is_constrained().
+       */
+      std::unordered_set<types::global_dof_index> constrained_dofs;
+
+      /**
+       * The constrained DoFs in the order in which they were added.
+       */
+      std::vector<types::global_dof_index> lines;
+
+      /**
+       * The position of the first entry of each line in #entries.
+       */
+      std::vector<std::size_t> entry_starts;
+
+      /**
+       * The entries of all lines, one line after the other.
+       */
+      std::vector<std::pair<types::global_dof_index, number>> entries;
+    };
+
+
+
     template <typename number>
     void
     make_hp_hanging_node_constraints(const DoFHandler<1> &,
@@ -1034,11 +1134,13 @@ namespace DoFTools
 
 
 
-    template <int dim, int spacedim, typename number>
+    template <int dim, int spacedim, typename ConstraintsType>
     void
-    make_hp_hanging_node_constraints(
+    make_hp_hanging_node_constraints_on_cells(
       const DoFHandler<dim, spacedim> &dof_handler,
-      AffineConstraints<number>       &constraints)
+      const ArrayView<
+        const typename DoFHandler<dim, spacedim>::active_cell_iterator> &cells,
+      ConstraintsType &constraints)
     {
       // note: this function is going to be hard to understand if you haven't
       // read the hp-paper. however, we try to follow the notation laid out
@@ -1088,13 +1190,8 @@ namespace DoFTools
       // note that even though we may visit a face twice if the neighboring
       // cells are equally refined, we can only visit each face with hanging
       // nodes once
-      for (const auto &cell : dof_handler.active_cell_iterators())
+      for (const auto &cell : cells)
         {
-          // artificial cells can at best neighbor ghost cells, but we're not
-          // interested in these interfaces
-          if (cell->is_artificial())
-            continue;
-
           for (const unsigned int face : cell->face_indices())
             if (cell->face(face)->has_children())
               {
@@ -1787,6 +1884,70 @@ namespace DoFTools
               }
         }
     }
+
+
+
+    template <int dim, int spacedim, typename number>
+    void
+    make_hp_hanging_node_constraints(
+      const DoFHandler<dim, spacedim> &dof_handler,
+      AffineConstraints<number>       &constraints)
+    {
+      // artificial cells can at best neighbor ghost cells, but we're not
+      // interested in these interfaces
+      std::vector<typename DoFHandler<dim, spacedim>::active_cell_iterator>
+        cells;
+      cells.reserve(dof_handler.get_triangulation().n_active_cells());
+      for (const auto &cell : dof_handler.active_cell_iterators())
+        if (cell->is_artificial() == false)
+          cells.push_back(cell);
+
+      // on small meshes, or if we only have one thread, simply work on the
+      // given object
+      const unsigned int minimal_chunk_size = 512;
+      const unsigned int n_chunks =
+        MultithreadInfo::is_running_single_threaded() ?
+          1 :
+          std::min<std::size_t>(4 * MultithreadInfo::n_threads(),
+                                cells.size() / minimal_chunk_size);
+      if (n_chunks <= 1)
+        {
+          make_hp_hanging_node_constraints_on_cells(dof_handler,
+                                                    make_array_view(cells),
+                                                    constraints);
+          return;
+        }
+
+      // otherwise split the cells into contiguous chunks and let each task
+      // collect the constraints of its chunk in a separate object. the
+      // constraints of a chunk are independent of the ones of the other
+      // chunks except that a DoF that is already constrained is not
+      // constrained again. we resolve this by merging the chunks in the order
+      // of the cells, keeping the first constraint for every DoF; this gives
+      // the same result as a single loop over all cells. the chunks store
+      // their constraints in plain arrays, since an AffineConstraints object
+      // per chunk would allocate memory for all DoF indices up to the largest
+      // one it constrains.
+      std::vector<ChunkConstraints<number>> chunk_constraints(n_chunks);
+      parallel::apply_to_subranges(
+        0U,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int chunk = begin; chunk < end; ++chunk)
+            {
+              const std::size_t first = cells.size() * chunk / n_chunks;
+              const std::size_t last  = cells.size() * (chunk + 1) / n_chunks;
+              make_hp_hanging_node_constraints_on_cells(
+                dof_handler,
+                make_array_view(cells.begin() + first, cells.begin() + last),
+                chunk_constraints[chunk]);
+            }
+        },
+        1);
+
+      for (const ChunkConstraints<number> &chunk : chunk_constraints)
+        chunk.copy_to(constraints);
+    }
   } // namespace internal
 
 
@@ -230,6 +230,10 @@ FEValues<dim, spacedim>::initialize(const UpdateFlags update_flags)
 
   const UpdateFlags flags = this->compute_update_flags(update_flags);
 
+  // check whether finite element functions can be evaluated by sum
+  // factorization
+  this->initialize_tensor_product_evaluation(quadrature);
+
   // initialize the base classes
   if (flags & update_mapping)
     this->mapping_output.initialize(this->max_n_quadrature_points, flags);
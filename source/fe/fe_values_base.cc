@@ -17,8 +17,10 @@
 #include <deal.II/base/memory_consumption.h>
 #include <deal.II/base/multithread_info.h>
 #include <deal.II/base/numbers.h>
+#include <deal.II/base/polynomial.h>
 #include <deal.II/base/quadrature.h>
 #include <deal.II/base/signaling_nan.h>
+#include <deal.II/base/tensor_product_polynomials.h>
 #include <deal.II/base/thread_management.h>
 
 #include <deal.II/differentiation/ad.h>
@@ -26,6 +28,7 @@
 #include <deal.II/dofs/dof_accessor.h>
 
 #include <deal.II/fe/fe.h>
+#include <deal.II/fe/fe_poly.h>
 #include <deal.II/fe/fe_values.h>
 #include <deal.II/fe/mapping.h>
 
@@ -34,6 +37,8 @@
 
 #include <deal.II/lac/vector.h>
 
+#include <deal.II/matrix_free/tensor_product_kernels.h>
+
 #include <boost/container/small_vector.hpp>
 
 #include <iomanip>
@@ -731,6 +736,11 @@ FEValuesBase<dim, spacedim>::get_function_values(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (maybe_evaluate_by_sum_factorization(
+        make_const_array_view(dof_values),
+        make_array_view(values),
+        ArrayView<Tensor<1, spacedim, Number>>()))
+    return;
   internal::do_function_values(make_array_view(dof_values.begin(),
                                                dof_values.end()),
                                this->finite_element_output.shape_values,
@@ -755,6 +765,11 @@ FEValuesBase<dim, spacedim>::get_function_values(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+  if (maybe_evaluate_by_sum_factorization(
+        make_const_array_view(view),
+        make_array_view(values),
+        ArrayView<Tensor<1, spacedim, Number>>()))
+    return;
   internal::do_function_values(view,
                                this->finite_element_output.shape_values,
                                values);
@@ -866,6 +881,10 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   // get function values of dofs on this cell
   Vector<Number> dof_values(dofs_per_cell);
   present_cell.get_interpolated_dof_values(fe_function, dof_values);
+  if (maybe_evaluate_by_sum_factorization(make_const_array_view(dof_values),
+                                          ArrayView<Number>(),
+                                          make_array_view(gradients)))
+    return;
   internal::do_function_derivatives(make_array_view(dof_values.begin(),
                                                     dof_values.end()),
                                     this->finite_element_output.shape_gradients,
@@ -890,6 +909,10 @@ FEValuesBase<dim, spacedim>::get_function_gradients(
   boost::container::small_vector<Number, 200> dof_values(dofs_per_cell);
   auto view = make_array_view(dof_values.begin(), dof_values.end());
   fe_function.extract_subvector_to(indices, view);
+  if (maybe_evaluate_by_sum_factorization(make_const_array_view(view),
+                                          ArrayView<Number>(),
+                                          make_array_view(gradients)))
+    return;
   internal::do_function_derivatives(view,
                                     this->finite_element_output.shape_gradients,
                                     gradients);
@@ -1462,6 +1485,211 @@ FEValuesBase<dim, spacedim>::get_cell_similarity() const
 
 
 
+template <int dim, int spacedim>
+struct FEValuesBase<dim, spacedim>::TensorProductData
+{
+  /**
+   * Number of one-dimensional shape functions.
+   */
+  unsigned int n_dofs_1d;
+
+  /**
+   * Number of points of the one-dimensional quadrature formula.
+   */
+  unsigned int n_q_points_1d;
+
+  /**
+   * The index of the shape function of the element for each position in
+   * the lexicographic ordering of the tensor product.
+   */
+  std::vector<unsigned int> lexicographic_numbering;
+
+  /**
+   * Values and derivatives of the one-dimensional shape functions in the
+   * one-dimensional quadrature points, with the quadrature point running
+   * fastest.
+   */
+  std::vector<double> shape_values;
+  std::vector<double> shape_gradients;
+};
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesBase<dim, spacedim>::initialize_tensor_product_evaluation(
+  const Quadrature<dim> &quadrature)
+{
+  tensor_product_data.reset();
+
+  // we only consider the volume case. in 1d, sum factorization does not
+  // reduce the work
+  if (dim == 1 || dim != spacedim || quadrature.is_tensor_product() == false)
+    return;
+
+  const auto fe_poly = dynamic_cast<const FE_Poly<dim, spacedim> *>(&*fe);
+  if (fe_poly == nullptr || fe_poly->get_degree() < 3)
+    return;
+  const auto poly_space = dynamic_cast<const TensorProductPolynomials<dim> *>(
+    &fe_poly->get_poly_space());
+  if (poly_space == nullptr ||
+      poly_space->n() != fe_poly->n_dofs_per_cell())
+    return;
+
+  const Quadrature<1> &quadrature_1d = quadrature.get_tensor_basis()[0];
+  for (unsigned int d = 1; d < dim; ++d)
+    if (!(quadrature.get_tensor_basis()[d] == quadrature_1d))
+      return;
+
+  const std::vector<Polynomials::Polynomial<double>> polynomials =
+    poly_space->get_underlying_polynomials();
+
+  auto data                     = std::make_unique<TensorProductData>();
+  data->n_dofs_1d               = polynomials.size();
+  data->n_q_points_1d           = quadrature_1d.size();
+  data->lexicographic_numbering = fe_poly->get_poly_space_numbering_inverse();
+  data->shape_values.resize(data->n_dofs_1d * data->n_q_points_1d);
+  data->shape_gradients.resize(data->n_dofs_1d * data->n_q_points_1d);
+  std::array<double, 2> values;
+  for (unsigned int i = 0; i < data->n_dofs_1d; ++i)
+    for (unsigned int q = 0; q < data->n_q_points_1d; ++q)
+      {
+        polynomials[i].value(quadrature_1d.point(q)[0], 1, values.data());
+        data->shape_values[i * data->n_q_points_1d + q]    = values[0];
+        data->shape_gradients[i * data->n_q_points_1d + q] = values[1];
+      }
+
+  tensor_product_data = std::move(data);
+}
+
+
+
+namespace internal
+{
+  namespace
+  {
+    // apply the one-dimensional shape values or, if 'derivative' is set, the
+    // one-dimensional shape gradients along the given direction
+    template <int direction, int dim>
+    void
+    apply_tensor_product_kernel(
+      const EvaluatorTensorProduct<evaluate_general, dim, 0, 0, double> &eval,
+      const bool    derivative,
+      const double *in,
+      double       *out)
+    {
+      if (derivative)
+        eval.template gradients<direction, true, false>(in, out);
+      else
+        eval.template values<direction, true, false>(in, out);
+    }
+  } // namespace
+} // namespace internal
+
+
+
+template <int dim, int spacedim>
+void
+FEValuesBase<dim, spacedim>::evaluate_by_sum_factorization(
+  const ArrayView<const double>        &dof_values,
+  const ArrayView<double>              &values,
+  const ArrayView<Tensor<1, spacedim>> &gradients) const
+{
+  Assert(tensor_product_data != nullptr, ExcInternalError());
+  AssertDimension(dof_values.size(), dofs_per_cell);
+  if (values.size() > 0)
+    AssertDimension(values.size(), n_quadrature_points);
+  if (gradients.size() > 0)
+    AssertDimension(gradients.size(), n_quadrature_points);
+
+  const TensorProductData &data = *tensor_product_data;
+
+  const internal::EvaluatorTensorProduct<internal::evaluate_general,
+                                         dim,
+                                         0,
+                                         0,
+                                         double>
+    eval(data.shape_values.data(),
+         data.shape_gradients.data(),
+         nullptr,
+         data.n_dofs_1d,
+         data.n_q_points_1d);
+
+  // buffers for the lexicographically ordered dof values, the two
+  // intermediate results of the sum factorization and the result in the
+  // quadrature points
+  const unsigned int buffer_size = Utilities::fixed_power<dim>(
+    std::max(data.n_dofs_1d, data.n_q_points_1d));
+  boost::container::small_vector<double, 1024> buffer(4 * buffer_size);
+  double *const lexicographic_values = buffer.data();
+  double *const tmp_0                = buffer.data() + buffer_size;
+  double *const tmp_1                = buffer.data() + 2 * buffer_size;
+  double *const result               = buffer.data() + 3 * buffer_size;
+  (void)tmp_1;
+  boost::container::small_vector<Tensor<1, dim>, 200> unit_gradients(
+    gradients.size());
+
+  for (unsigned int i = 0; i < dofs_per_cell; ++i)
+    lexicographic_values[i] = dof_values[data.lexicographic_numbering[i]];
+
+  // compute the values (component -1) and the gradients on the unit cell
+  // (components 0 to dim-1) one after the other. a derivative is applied in
+  // the direction given by the component, function values in all others
+  for (int component = (values.size() > 0 ? -1 : 0);
+       component < (gradients.size() > 0 ? dim : 0);
+       ++component)
+    {
+      if constexpr (dim == 2)
+        {
+          internal::apply_tensor_product_kernel<0>(eval,
+                                                   component == 0,
+                                                   lexicographic_values,
+                                                   tmp_0);
+          internal::apply_tensor_product_kernel<1>(eval,
+                                                   component == 1,
+                                                   tmp_0,
+                                                   result);
+        }
+      else if constexpr (dim == 3)
+        {
+          internal::apply_tensor_product_kernel<0>(eval,
+                                                   component == 0,
+                                                   lexicographic_values,
+                                                   tmp_0);
+          internal::apply_tensor_product_kernel<1>(eval,
+                                                   component == 1,
+                                                   tmp_0,
+                                                   tmp_1);
+          internal::apply_tensor_product_kernel<2>(eval,
+                                                   component == 2,
+                                                   tmp_1,
+                                                   result);
+        }
+      else
+        Assert(false, ExcNotImplemented());
+
+      if (component < 0)
+        std::copy_n(result, n_quadrature_points, values.begin());
+      else
+        for (unsigned int q = 0; q < n_quadrature_points; ++q)
+          unit_gradients[q][component] = result[q];
+    }
+
+  // transform the gradients on the unit cell to real space in the same way
+  // as the element does for the gradients of the shape functions. this
+  // uses the covariant transformation the mapping computes anyway for
+  // update_gradients
+  if (gradients.size() > 0)
+    this->get_mapping().transform(
+      ArrayView<const Tensor<1, dim>>(unit_gradients.data(),
+                                      unit_gradients.size()),
+      mapping_covariant,
+      *this->mapping_data,
+      gradients);
+}
+
+
+
 template <int dim, int spacedim>
 const unsigned int FEValuesBase<dim, spacedim>::dimension;
 
@@ -374,6 +374,11 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    if (fe_values->maybe_evaluate_by_sum_factorization(
+          make_const_array_view(dof_values),
+          make_array_view(values),
+          ArrayView<dealii::Tensor<1, spacedim, Number>>()))
+      return;
     internal::do_function_values<dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_values,
@@ -426,6 +431,11 @@ namespace FEValuesViews
     dealii::Vector<Number> dof_values(fe_values->dofs_per_cell);
     fe_values->present_cell.get_interpolated_dof_values(fe_function,
                                                         dof_values);
+    if (fe_values->maybe_evaluate_by_sum_factorization(
+          make_const_array_view(dof_values),
+          ArrayView<Number>(),
+          make_array_view(gradients)))
+      return;
     internal::do_function_derivatives<1, dim, spacedim>(
       make_const_array_view(dof_values),
       fe_values->finite_element_output.shape_gradients,
@@ -54,6 +54,7 @@ MappingQ<dim, spacedim>::InternalData::InternalData(
   , n_shape_functions(Utilities::fixed_power<dim>(polynomial_degree + 1))
   , line_support_points(QGaussLobatto<1>(polynomial_degree + 1))
   , tensor_product_quadrature(false)
+  , is_affine(false)
   , output_data(nullptr)
 {}
 
@@ -821,7 +822,22 @@ MappingQ<dim, spacedim>::fill_fe_values(
        cell_similarity :
        CellSimilarity::none);
 
-  if (dim > 1 && data.tensor_product_quadrature)
+  // on affine cells, the Jacobian is the same in all quadrature points and
+  // we can skip the evaluation of the mapping in each of them
+  if (internal::MappingQImplementation::compute_affine_jacobian<dim, spacedim>(
+        data, unit_cell_support_points))
+    {
+      internal::MappingQImplementation::
+        maybe_update_q_points_Jacobians_and_grads_affine<dim, spacedim>(
+          computed_cell_similarity,
+          data,
+          make_array_view(quadrature.get_points()),
+          output_data.quadrature_points,
+          output_data.jacobians,
+          output_data.inverse_jacobians,
+          output_data.jacobian_grads);
+    }
+  else if (dim > 1 && data.tensor_product_quadrature)
     {
       internal::MappingQImplementation::
         maybe_update_q_points_Jacobians_and_grads_tensor<dim, spacedim>(
@@ -1017,6 +1033,7 @@ MappingQ<dim, spacedim>::fill_fe_face_values(
          ExcInternalError());
   const InternalData &data = static_cast<const InternalData &>(internal_data);
   data.output_data         = &output_data;
+  data.is_affine           = false;
 
   // if necessary, recompute the support points of the transformation of this
   // cell (note that we need to first check the triangulation pointer, since
@@ -1068,6 +1085,7 @@ MappingQ<dim, spacedim>::fill_fe_subface_values(
          ExcInternalError());
   const InternalData &data = static_cast<const InternalData &>(internal_data);
   data.output_data         = &output_data;
+  data.is_affine           = false;
 
   // if necessary, recompute the support points of the transformation of this
   // cell (note that we need to first check the triangulation pointer, since
@@ -1121,6 +1139,7 @@ MappingQ<dim, spacedim>::fill_fe_immersed_surface_values(
          ExcInternalError());
   const InternalData &data = static_cast<const InternalData &>(internal_data);
   data.output_data         = &output_data;
+  data.is_affine           = false;
 
   const unsigned int n_q_points = quadrature.size();
 
@@ -1261,6 +1280,7 @@ MappingQ<dim, spacedim>::fill_mapping_data_for_generic_points(
                                                            unit_points.end())));
   const InternalData &data = static_cast<const InternalData &>(*internal_data);
   data.output_data         = &output_data;
+  data.is_affine           = false;
   data.mapping_support_points = this->compute_mapping_support_points(cell);
 
   internal::MappingQImplementation::maybe_update_q_points_Jacobians_generic(
@@ -1296,6 +1316,7 @@ MappingQ<dim, spacedim>::fill_mapping_data_for_face_quadrature(
 
   data.mapping_support_points = this->compute_mapping_support_points(cell);
   data.output_data            = &output_data;
+  data.is_affine              = false;
 
   internal::MappingQImplementation::do_fill_fe_face_values(
     *this,
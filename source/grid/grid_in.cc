@@ -36,6 +36,7 @@
 
 #include <algorithm>
 #include <cctype>
+#include <cstdint>
 #include <fstream>
 #include <functional>
 #include <limits>
@@ -2018,6 +2019,27 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // assign boundary ids.
   std::array<std::map<int, int>, 4> tag_maps;
 
+  // In binary files (only supported for format 4.1), the section markers
+  // are text, but the contents of the $Entities, $Nodes, and $Elements
+  // sections are stored as raw integers (int for entity data, and the
+  // size_t of the writing machine, which we require to have 64 bits, for
+  // counts and tags) and doubles. This function reads a single value in
+  // either representation; the type of the argument determines the number
+  // of bytes read in the binary case.
+  bool       binary     = false;
+  const auto read_value = [&in, &binary](auto &value) {
+    if (binary)
+      in.read(reinterpret_cast<char *>(&value), sizeof(value));
+    else
+      in >> value;
+  };
+  // Binary data starts right after the newline that ends the line with the
+  // section marker, so skip that newline before reading raw values.
+  const auto skip_to_section_data = [&in, &binary]() {
+    if (binary)
+      in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+  };
+
   in >> line;
 
   // first determine file format
@@ -2041,8 +2063,25 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       Assert((version >= 2.0) && (version <= 4.1), ExcNotImplemented());
       gmsh_file_format = static_cast<unsigned int>(version * 10);
 
-      Assert(file_type == 0, ExcNotImplemented());
-      Assert(data_size == sizeof(double), ExcNotImplemented());
+      AssertThrow((file_type == 0) ||
+                    ((file_type == 1) && (gmsh_file_format == 41)),
+                  ExcNotImplemented());
+      AssertThrow(data_size == sizeof(double), ExcNotImplemented());
+
+      // binary files are followed by the integer 1 in the byte order of
+      // the machine that wrote the file
+      if (file_type == 1)
+        {
+          AssertThrow(data_size == sizeof(std::uint64_t), ExcNotImplemented());
+          in.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+          int one = 0;
+          in.read(reinterpret_cast<char *>(&one), sizeof(one));
+          AssertThrow(one == 1,
+                      ExcMessage("Binary gmsh files written on a machine "
+                                 "with a different byte order are not "
+                                 "supported."));
+          binary = true;
+        }
 
       // read the end of the header and the first line of the nodes
       // description to synch ourselves with the format 1 handling above
@@ -2064,22 +2103,30 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // if the next block is of kind $Entities, parse it
       if (line == "$Entities")
         {
-          unsigned long n_points, n_curves, n_surfaces, n_volumes;
+          skip_to_section_data();
+
+          std::uint64_t n_points, n_curves, n_surfaces, n_volumes;
 
-          in >> n_points >> n_curves >> n_surfaces >> n_volumes;
+          read_value(n_points);
+          read_value(n_curves);
+          read_value(n_surfaces);
+          read_value(n_volumes);
           for (unsigned int i = 0; i < n_points; ++i)
             {
               // parse point ids
-              int          tag;
-              unsigned int n_physicals;
+              int           tag;
+              std::uint64_t n_physicals;
               double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
                 box_max_z;
 
               // we only care for 'tag' as key for tag_maps[0]
               if (gmsh_file_format > 40)
                 {
-                  in >> tag >> box_min_x >> box_min_y >> box_min_z >>
-                    n_physicals;
+                  read_value(tag);
+                  read_value(box_min_x);
+                  read_value(box_min_y);
+                  read_value(box_min_z);
+                  read_value(n_physicals);
                   box_max_x = box_min_x;
                   box_max_y = box_min_y;
                   box_max_z = box_min_z;
@@ -2096,20 +2143,26 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // if there is no physical tag, use 0 as default
               int physical_tag = 0;
               for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
+                read_value(physical_tag);
               tag_maps[0][tag] = physical_tag;
             }
           for (unsigned int i = 0; i < n_curves; ++i)
             {
               // parse curve ids
-              int          tag;
-              unsigned int n_physicals;
+              int           tag;
+              std::uint64_t n_physicals;
               double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
                 box_max_z;
 
               // we only care for 'tag' as key for tag_maps[1]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
+              read_value(tag);
+              read_value(box_min_x);
+              read_value(box_min_y);
+              read_value(box_min_z);
+              read_value(box_max_x);
+              read_value(box_max_y);
+              read_value(box_max_z);
+              read_value(n_physicals);
               // if there is a physical tag, we will use it as boundary id
               // below
               AssertThrow(n_physicals < 2,
@@ -2117,27 +2170,33 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // if there is no physical tag, use 0 as default
               int physical_tag = 0;
               for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
+                read_value(physical_tag);
               tag_maps[1][tag] = physical_tag;
               // we don't care about the points associated to a curve, but
               // have to parse them anyway because their format is
               // unstructured
-              in >> n_points;
+              read_value(n_points);
               for (unsigned int j = 0; j < n_points; ++j)
-                in >> tag;
+                read_value(tag);
             }
 
           for (unsigned int i = 0; i < n_surfaces; ++i)
             {
               // parse surface ids
-              int          tag;
-              unsigned int n_physicals;
+              int           tag;
+              std::uint64_t n_physicals;
               double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
                 box_max_z;
 
               // we only care for 'tag' as key for tag_maps[2]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
+              read_value(tag);
+              read_value(box_min_x);
+              read_value(box_min_y);
+              read_value(box_min_z);
+              read_value(box_max_x);
+              read_value(box_max_y);
+              read_value(box_max_z);
+              read_value(n_physicals);
               // if there is a physical tag, we will use it as boundary id
               // below
               AssertThrow(n_physicals < 2,
@@ -2145,26 +2204,32 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // if there is no physical tag, use 0 as default
               int physical_tag = 0;
               for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
+                read_value(physical_tag);
               tag_maps[2][tag] = physical_tag;
               // we don't care about the curves associated to a surface, but
               // have to parse them anyway because their format is
               // unstructured
-              in >> n_curves;
+              read_value(n_curves);
               for (unsigned int j = 0; j < n_curves; ++j)
-                in >> tag;
+                read_value(tag);
             }
           for (unsigned int i = 0; i < n_volumes; ++i)
             {
               // parse volume ids
-              int          tag;
-              unsigned int n_physicals;
+              int           tag;
+              std::uint64_t n_physicals;
               double box_min_x, box_min_y, box_min_z, box_max_x, box_max_y,
                 box_max_z;
 
               // we only care for 'tag' as key for tag_maps[3]
-              in >> tag >> box_min_x >> box_min_y >> box_min_z >> box_max_x >>
-                box_max_y >> box_max_z >> n_physicals;
+              read_value(tag);
+              read_value(box_min_x);
+              read_value(box_min_y);
+              read_value(box_min_z);
+              read_value(box_max_x);
+              read_value(box_max_y);
+              read_value(box_max_z);
+              read_value(n_physicals);
               // if there is a physical tag, we will use it as boundary id
               // below
               AssertThrow(n_physicals < 2,
@@ -2172,14 +2237,14 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // if there is no physical tag, use 0 as default
               int physical_tag = 0;
               for (unsigned int j = 0; j < n_physicals; ++j)
-                in >> physical_tag;
+                read_value(physical_tag);
               tag_maps[3][tag] = physical_tag;
               // we don't care about the surfaces associated to a volume, but
               // have to parse them anyway because their format is
               // unstructured
-              in >> n_surfaces;
+              read_value(n_surfaces);
               for (unsigned int j = 0; j < n_surfaces; ++j)
-                in >> tag;
+                read_value(tag);
             }
           in >> line;
           AssertThrow(line == "$EndEntities", ExcInvalidGMSHInput(line));
@@ -2201,15 +2266,21 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
       // in any case, be the list of
       // nodes:
       AssertThrow(line == "$Nodes", ExcInvalidGMSHInput(line));
+      skip_to_section_data();
     }
 
   // now read the nodes list
-  int n_entity_blocks = 1;
+  std::uint64_t n_entity_blocks = 1;
+  std::uint64_t min_node_tag    = 0;
+  std::uint64_t max_node_tag    = 0;
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_vertices >> min_node_tag >> max_node_tag;
+      std::uint64_t n_nodes;
+      read_value(n_entity_blocks);
+      read_value(n_nodes);
+      read_value(min_node_tag);
+      read_value(max_node_tag);
+      n_vertices = n_nodes;
     }
   else if (gmsh_file_format == 40)
     {
@@ -2223,12 +2294,37 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   // vertices vector
   std::map<int, int> vertex_indices;
 
+  // Starting with format 4.1, the range of node tags is known upfront. gmsh
+  // usually numbers nodes (almost) contiguously, so we can then replace the
+  // std::map above by a plain vector indexed by the node tag, which is
+  // considerably faster and leaner for large meshes.
+  std::vector<unsigned int> dense_vertex_indices;
+  if ((gmsh_file_format > 40) && (n_vertices > 0) &&
+      (max_node_tag >= min_node_tag) &&
+      (max_node_tag - min_node_tag < 2 * std::uint64_t(n_vertices)))
+    dense_vertex_indices.resize(max_node_tag - min_node_tag + 1,
+                                numbers::invalid_unsigned_int);
+
+  // Translate a node tag from the file into the index in the vertices
+  // vector, returning numbers::invalid_unsigned_int for unknown tags.
+  const auto get_vertex_index = [&](const std::uint64_t node_tag) {
+    if (dense_vertex_indices.size() > 0)
+      return (node_tag >= min_node_tag && node_tag <= max_node_tag) ?
+               dense_vertex_indices[node_tag - min_node_tag] :
+               numbers::invalid_unsigned_int;
+    const auto it = vertex_indices.find(node_tag);
+    return (it != vertex_indices.end()) ?
+             static_cast<unsigned int>(it->second) :
+             numbers::invalid_unsigned_int;
+  };
+
   {
     unsigned int global_vertex = 0;
-    for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
+    for (std::uint64_t entity_block = 0; entity_block < n_entity_blocks;
+         ++entity_block)
       {
         int           parametric;
-        unsigned long numNodes;
+        std::uint64_t numNodes;
 
         if (gmsh_file_format < 40)
           {
@@ -2240,31 +2336,56 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             // but we are ignoring both anyway.
             int tagEntity, dimEntity;
-            in >> tagEntity >> dimEntity >> parametric >> numNodes;
+            read_value(tagEntity);
+            read_value(dimEntity);
+            read_value(parametric);
+            read_value(numNodes);
           }
 
-        std::vector<int> vertex_numbers;
-        int              vertex_number;
+        AssertThrow(global_vertex + numNodes <= n_vertices,
+                    ExcInvalidGMSHInput(std::to_string(numNodes)));
+
+        std::vector<std::uint64_t> vertex_numbers;
         if (gmsh_file_format > 40)
-          for (unsigned long vertex_per_entity = 0;
-               vertex_per_entity < numNodes;
-               ++vertex_per_entity)
-            {
-              in >> vertex_number;
-              vertex_numbers.push_back(vertex_number);
-            }
+          {
+            vertex_numbers.resize(numNodes);
+            if (binary)
+              in.read(reinterpret_cast<char *>(vertex_numbers.data()),
+                      numNodes * sizeof(std::uint64_t));
+            else
+              for (std::uint64_t &vertex_number : vertex_numbers)
+                in >> vertex_number;
+          }
 
-        for (unsigned long vertex_per_entity = 0; vertex_per_entity < numNodes;
+        // in binary files, the coordinates of all nodes of a block follow
+        // each other, so read them all at once
+        std::vector<double> block_coordinates;
+        if (binary && parametric == 0)
+          {
+            block_coordinates.resize(3 * numNodes);
+            in.read(reinterpret_cast<char *>(block_coordinates.data()),
+                    block_coordinates.size() * sizeof(double));
+          }
+
+        for (std::uint64_t vertex_per_entity = 0; vertex_per_entity < numNodes;
              ++vertex_per_entity, ++global_vertex)
           {
-            int    vertex_number;
-            double x[3];
+            std::uint64_t vertex_number;
+            double        x[3];
 
             // read vertex
             if (gmsh_file_format > 40)
               {
                 vertex_number = vertex_numbers[vertex_per_entity];
-                in >> x[0] >> x[1] >> x[2];
+                if (block_coordinates.size() > 0)
+                  for (unsigned int d = 0; d < 3; ++d)
+                    x[d] = block_coordinates[3 * vertex_per_entity + d];
+                else
+                  {
+                    read_value(x[0]);
+                    read_value(x[1]);
+                    read_value(x[2]);
+                  }
               }
             else
               in >> vertex_number >> x[0] >> x[1] >> x[2];
@@ -2272,14 +2393,24 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             for (unsigned int d = 0; d < spacedim; ++d)
               vertices[global_vertex](d) = x[d];
             // store mapping
-            vertex_indices[vertex_number] = global_vertex;
+            if (dense_vertex_indices.size() > 0)
+              {
+                AssertThrow(vertex_number >= min_node_tag &&
+                              vertex_number <= max_node_tag,
+                            ExcInvalidGMSHInput(std::to_string(vertex_number)));
+                dense_vertex_indices[vertex_number - min_node_tag] =
+                  global_vertex;
+              }
+            else
+              vertex_indices[vertex_number] = global_vertex;
 
             // ignore parametric coordinates
             if (parametric != 0)
               {
                 double u = 0.;
                 double v = 0.;
-                in >> u >> v;
+                read_value(u);
+                read_value(v);
                 (void)u;
                 (void)v;
               }
@@ -2289,6 +2420,7 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   }
 
   // Assert we reached the end of the block
+  AssertThrow(in.fail() == false, ExcIO());
   in >> line;
   static const std::string end_nodes_marker[] = {"$ENDNOD", "$EndNodes"};
   AssertThrow(line == end_nodes_marker[gmsh_file_format == 10 ? 0 : 1],
@@ -2299,13 +2431,17 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
   static const std::string begin_elements_marker[] = {"$ELM", "$Elements"};
   AssertThrow(line == begin_elements_marker[gmsh_file_format == 10 ? 0 : 1],
               ExcInvalidGMSHInput(line));
+  skip_to_section_data();
 
   // now read the cell list
   if (gmsh_file_format > 40)
     {
-      int min_node_tag;
-      int max_node_tag;
-      in >> n_entity_blocks >> n_cells >> min_node_tag >> max_node_tag;
+      std::uint64_t n_elements, min_element_tag, max_element_tag;
+      read_value(n_entity_blocks);
+      read_value(n_elements);
+      read_value(min_element_tag);
+      read_value(max_element_tag);
+      n_cells = n_elements;
     }
   else if (gmsh_file_format == 40)
     {
@@ -2334,10 +2470,11 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
     static constexpr std::array<unsigned int, 8> local_vertex_numbering = {
       {0, 1, 5, 4, 2, 3, 7, 6}};
     unsigned int global_cell = 0;
-    for (int entity_block = 0; entity_block < n_entity_blocks; ++entity_block)
+    for (std::uint64_t entity_block = 0; entity_block < n_entity_blocks;
+         ++entity_block)
       {
         unsigned int  material_id;
-        unsigned long numElements;
+        std::uint64_t numElements;
         int           cell_type;
 
         if (gmsh_file_format < 40)
@@ -2356,7 +2493,10 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
           {
             // for gmsh_file_format 4.1 the order of tag and dim is reversed,
             int tagEntity, dimEntity;
-            in >> dimEntity >> tagEntity >> cell_type >> numElements;
+            read_value(dimEntity);
+            read_value(tagEntity);
+            read_value(cell_type);
+            read_value(numElements);
             material_id = tag_maps[dimEntity][tagEntity];
           }
 
@@ -2433,8 +2573,8 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
             else // file format version 4.0 and later
               {
                 // ignore tag
-                int tag;
-                in >> tag;
+                std::uint64_t tag;
+                read_value(tag);
 
                 if (cell_type == 1) // line
                   nod_num = 2;
@@ -2500,14 +2640,17 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 cell.vertices.resize(vertices_per_cell);
                 for (unsigned int i = 0; i < vertices_per_cell; ++i)
                   {
+                    std::uint64_t node_tag;
+                    read_value(node_tag);
                     // hypercube cells need to be reordered
                     if (vertices_per_cell ==
                         GeometryInfo<dim>::vertices_per_cell)
-                      in >> cell.vertices[dim == 3 ?
-                                            local_vertex_numbering[i] :
-                                            GeometryInfo<dim>::ucd_to_deal[i]];
+                      cell.vertices[dim == 3 ?
+                                      local_vertex_numbering[i] :
+                                      GeometryInfo<dim>::ucd_to_deal[i]] =
+                        node_tag;
                     else
-                      in >> cell.vertices[i];
+                      cell.vertices[i] = node_tag;
                   }
 
                 // to make sure that the cast won't fail
@@ -2526,13 +2669,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 // transform from gmsh to consecutive numbering
                 for (unsigned int i = 0; i < vertices_per_cell; ++i)
                   {
-                    AssertThrow(vertex_indices.find(cell.vertices[i]) !=
-                                  vertex_indices.end(),
+                    const unsigned int vertex =
+                      get_vertex_index(cell.vertices[i]);
+                    AssertThrow(vertex != numbers::invalid_unsigned_int,
                                 ExcInvalidVertexIndexGmsh(cell_per_entity,
                                                           elm_number,
                                                           cell.vertices[i]));
 
-                    const auto vertex = vertex_indices[cell.vertices[i]];
                     if (dim == 1)
                       vertex_counts[vertex] += 1u;
                     cell.vertices[i] = vertex;
@@ -2543,8 +2686,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
               // boundary info
               {
                 subcelldata.boundary_lines.emplace_back();
-                in >> subcelldata.boundary_lines.back().vertices[0] >>
-                  subcelldata.boundary_lines.back().vertices[1];
+                for (unsigned int &vertex :
+                     subcelldata.boundary_lines.back().vertices)
+                  {
+                    std::uint64_t node_tag;
+                    read_value(node_tag);
+                    vertex = node_tag;
+                  }
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -2565,17 +2713,13 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 // consecutive numbering
                 for (unsigned int &vertex :
                      subcelldata.boundary_lines.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      AssertThrow(false,
-                                  ExcInvalidVertexIndex(cell_per_entity,
-                                                        vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
+                  {
+                    const unsigned int vertex_index = get_vertex_index(vertex);
+                    // no such vertex index
+                    AssertThrow(vertex_index != numbers::invalid_unsigned_int,
+                                ExcInvalidVertexIndex(cell_per_entity, vertex));
+                    vertex = vertex_index;
+                  }
               }
             else if ((cell_type == 2 || cell_type == 3) &&
                      (dim == 3)) // a triangle or a quad in 3d
@@ -2595,7 +2739,11 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   vertices_per_cell);
                 // for loop
                 for (unsigned int i = 0; i < vertices_per_cell; ++i)
-                  in >> subcelldata.boundary_quads.back().vertices[i];
+                  {
+                    std::uint64_t node_tag;
+                    read_value(node_tag);
+                    subcelldata.boundary_quads.back().vertices[i] = node_tag;
+                  }
 
                 // to make sure that the cast won't fail
                 Assert(material_id <=
@@ -2616,21 +2764,18 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                 // consecutive numbering
                 for (unsigned int &vertex :
                      subcelldata.boundary_quads.back().vertices)
-                  if (vertex_indices.find(vertex) != vertex_indices.end())
-                    // vertex with this index exists
-                    vertex = vertex_indices[vertex];
-                  else
-                    {
-                      // no such vertex index
-                      Assert(false,
-                             ExcInvalidVertexIndex(cell_per_entity, vertex));
-                      vertex = numbers::invalid_unsigned_int;
-                    }
+                  {
+                    const unsigned int vertex_index = get_vertex_index(vertex);
+                    // no such vertex index
+                    Assert(vertex_index != numbers::invalid_unsigned_int,
+                           ExcInvalidVertexIndex(cell_per_entity, vertex));
+                    vertex = vertex_index;
+                  }
               }
             else if (cell_type == 15)
               {
                 // read the indices of nodes given
-                unsigned int node_index = 0;
+                std::uint64_t node_index = 0;
                 if (gmsh_file_format < 20)
                   {
                     // For points (cell_type==15), we can only ever
@@ -2640,14 +2785,19 @@ GridIn<dim, spacedim>::read_msh(std::istream &in)
                   }
                 else
                   {
-                    in >> node_index;
+                    read_value(node_index);
                   }
 
                 // we only care about boundary indicators assigned to
                 // individual vertices in 1d (because otherwise the vertices
-                // are not faces)
+                // are not faces). points that do not refer to a node we
+                // have read are skipped
                 if (dim == 1)
-                  boundary_ids_1d[vertex_indices[node_index]] = material_id;
+                  {
+                    const unsigned int vertex = get_vertex_index(node_index);
+                    if (vertex != numbers::invalid_unsigned_int)
+                      boundary_ids_1d[vertex] = material_id;
+                  }
               }
             else
               {
@@ -4169,7 +4319,10 @@ GridIn<dim, spacedim>::read(const std::string &filename, Format format)
     }
   else
     {
-      std::ifstream in(name);
+      // gmsh files may contain binary data, so open them in binary mode
+      std::ifstream in(name,
+                       (format == msh) ? std::ios::in | std::ios::binary :
+                                         std::ios::in);
       read(in, format);
     }
 }
@@ -20,6 +20,8 @@
 #include <deal.II/grid/grid_tools.h>
 #include <deal.II/grid/grid_tools_cache.h>
 
+#include <boost/geometry/algorithms/equals.hpp>
+
 DEAL_II_NAMESPACE_OPEN
 
 namespace GridTools
@@ -31,17 +33,45 @@ namespace GridTools
     , tria(&tria)
     , mapping(&mapping)
   {
-    tria_signal =
-      tria.signals.any_change.connect([&]() { mark_for_update(update_all); });
+    tria_signals.push_back(
+      tria.signals.create.connect([&]() { mark_for_update(update_all); }));
+    tria_signals.push_back(
+      tria.signals.clear.connect([&]() { mark_for_update(update_all); }));
+    tria_signals.push_back(tria.signals.mesh_movement.connect(
+      [&]() { mark_for_update(update_all); }));
+
+    // Refinement and coarsening typically only change a small fraction of
+    // the cells, so keep the tree of cell bounding boxes up to date cell by
+    // cell, and only mark the remaining data structures for update.
+    tria_signals.push_back(tria.signals.post_refinement.connect([&]() {
+      mark_for_update(update_all & ~update_cell_bounding_boxes_rtree);
+    }));
+    tria_signals.push_back(tria.signals.pre_coarsening_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        if (update_flags & update_cell_bounding_boxes_rtree)
+          return;
+        for (const auto &child : cell->child_iterators())
+          remove_from_cell_bounding_boxes_rtree(child);
+        cells_to_add_to_bounding_boxes_rtree.insert(cell);
+      }));
+    tria_signals.push_back(tria.signals.post_refinement_on_cell.connect(
+      [&](const typename Triangulation<dim, spacedim>::cell_iterator &cell) {
+        if (update_flags & update_cell_bounding_boxes_rtree)
+          return;
+        remove_from_cell_bounding_boxes_rtree(cell);
+        for (const auto &child : cell->child_iterators())
+          cells_to_add_to_bounding_boxes_rtree.insert(child);
+      }));
   }
 
   template <int dim, int spacedim>
   Cache<dim, spacedim>::~Cache()
   {
-    // Make sure that the signals that was attached to the triangulation
-    // is removed here.
-    if (tria_signal.connected())
-      tria_signal.disconnect();
+    // Make sure that the signals that were attached to the triangulation
+    // are removed here.
+    for (auto &connection : tria_signals)
+      if (connection.connected())
+        connection.disconnect();
   }
 
 
@@ -137,12 +167,58 @@ namespace GridTools
 
         cell_bounding_boxes_rtree = pack_rtree(boxes);
         update_flags = update_flags & ~update_cell_bounding_boxes_rtree;
+        cells_to_add_to_bounding_boxes_rtree.clear();
+      }
+    else if (cells_to_add_to_bounding_boxes_rtree.size() > 0)
+      {
+        for (const auto &cell : cells_to_add_to_bounding_boxes_rtree)
+          cell_bounding_boxes_rtree.insert(std::make_pair(
+            mapping->get_bounding_box(cell),
+            typename Triangulation<dim, spacedim>::active_cell_iterator(cell)));
+        cells_to_add_to_bounding_boxes_rtree.clear();
       }
     return cell_bounding_boxes_rtree;
   }
 
 
 
+  template <int dim, int spacedim>
+  void
+  Cache<dim, spacedim>::remove_from_cell_bounding_boxes_rtree(
+    const typename Triangulation<dim, spacedim>::cell_iterator &cell)
+  {
+    if (update_flags & update_cell_bounding_boxes_rtree)
+      return;
+
+    // the cell might have been created since the last update of the tree
+    if (cells_to_add_to_bounding_boxes_rtree.erase(cell) > 0)
+      return;
+
+    // The bounding box of a cell contains its vertices, and therefore also
+    // their average, so we can find the entry of the cell by a point query.
+    // This is not true if the mapping moves the vertices, in which case we
+    // do not find the cell and fall back to recomputing the whole tree.
+    namespace bgi = boost::geometry::index;
+    std::vector<
+      std::pair<BoundingBox<spacedim>,
+                typename Triangulation<dim, spacedim>::active_cell_iterator>>
+      entries;
+    cell_bounding_boxes_rtree.query(
+      bgi::intersects(cell->center()) &&
+        bgi::satisfies([&cell](const auto &entry) {
+          return typename Triangulation<dim, spacedim>::cell_iterator(
+                   entry.second) == cell;
+        }),
+      std::back_inserter(entries));
+
+    if (entries.size() == 1)
+      cell_bounding_boxes_rtree.remove(entries[0]);
+    else
+      mark_for_update(update_cell_bounding_boxes_rtree);
+  }
+
+
+
   template <int dim, int spacedim>
   const RTree<
     std::pair<BoundingBox<spacedim>,
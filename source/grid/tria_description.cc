@@ -28,6 +28,8 @@
 #include <deal.II/grid/tria.h>
 #include <deal.II/grid/tria_description.h>
 
+#include <fstream>
+
 DEAL_II_NAMESPACE_OPEN
 
 
@@ -790,6 +792,87 @@ namespace TriangulationDescription
 
 
 
+    template <int dim, int spacedim>
+    void
+    save_description_from_triangulation(
+      const dealii::Triangulation<dim, spacedim> &tria,
+      const unsigned int                          n_partitions,
+      const std::string                          &filename,
+      const TriangulationDescription::Settings    settings)
+    {
+      Assert(
+        (dynamic_cast<const parallel::TriangulationBase<dim, spacedim> *>(
+           &tria) == nullptr),
+        ExcMessage("This function only works for serial triangulations."));
+      AssertThrow(n_partitions > 0, ExcMessage("Need at least one partition."));
+
+      const auto subdomain_id_function = [](const auto &cell) {
+        return cell->subdomain_id();
+      };
+
+      const auto level_subdomain_id_function = [](const auto &cell) {
+        return cell->level_subdomain_id();
+      };
+
+      // set up the helper only once: its constructor collects the
+      // coinciding vertices of the whole triangulation, which we do not
+      // want to repeat for every partition
+      const CreateDescriptionFromTriangulationHelper<dim, spacedim> helper(
+        tria,
+        subdomain_id_function,
+        level_subdomain_id_function,
+        MPI_COMM_SELF,
+        settings);
+
+      // write the file read by parallel::fullydistributed::Triangulation::load:
+      // the sizes of the packed descriptions of all ranks, followed by the
+      // packed descriptions themselves; since we expect that this function is
+      // called for huge meshes, only one Description is kept in memory at a
+      // time and the sizes are written once all partitions have been
+      // processed
+      {
+        std::ofstream f(filename + "_triangulation.data",
+                        std::ios::out | std::ios::binary);
+        AssertThrow(f.fail() == false, ExcIO());
+
+        std::vector<std::uint64_t> buffer_sizes(n_partitions, 0);
+        f.write(reinterpret_cast<const char *>(buffer_sizes.data()),
+                buffer_sizes.size() * sizeof(std::uint64_t));
+
+        for (unsigned int rank = 0; rank < n_partitions; ++rank)
+          {
+            const auto construction_data =
+              helper.template create_description_for_rank<
+                Description<dim, spacedim>>(rank);
+
+            std::vector<char> buffer;
+            dealii::Utilities::pack(construction_data, buffer, false);
+
+            buffer_sizes[rank] = buffer.size();
+            f.write(buffer.data(), buffer.size());
+          }
+
+        f.seekp(0);
+        f.write(reinterpret_cast<const char *>(buffer_sizes.data()),
+                buffer_sizes.size() * sizeof(std::uint64_t));
+        AssertThrow(f.fail() == false, ExcIO());
+      }
+
+      // write the .info file in the same format as
+      // parallel::fullydistributed::Triangulation::save(), without any
+      // attached data
+      {
+        std::ofstream f(filename + ".info");
+        AssertThrow(f.fail() == false, ExcIO());
+        f << "version nproc n_attached_fixed_size_objs n_attached_variable_size_objs n_global_active_cells"
+          << std::endl
+          << 4 << " " << n_partitions << " " << 0 << " " << 0 << " "
+          << tria.n_active_cells() << std::endl;
+      }
+    }
+
+
+
     template <int dim, int spacedim>
     Description<dim, spacedim>
     create_description_from_triangulation_in_groups(
@@ -847,6 +930,16 @@ namespace TriangulationDescription
             std::min(group_root + group_size,
                      dealii::Utilities::MPI::n_mpi_processes(comm));
 
+          // set up the helper creating the descriptions only once for all
+          // processes of the group, since its setup involves the whole
+          // serial triangulation
+          const CreateDescriptionFromTriangulationHelper<dim, spacedim> helper(
+            tria,
+            [](const auto &cell) { return cell->subdomain_id(); },
+            [](const auto &cell) { return cell->level_subdomain_id(); },
+            comm,
+            settings);
+
           // 3) create Description for the other processes in group; since
           // we expect that this function is called for huge meshes, one
           // Description is created at a time and send away; only once the
@@ -856,10 +949,8 @@ namespace TriangulationDescription
             {
               // 3a) create construction data for other ranks
               const auto construction_data =
-                create_description_from_triangulation(tria,
-                                                      comm,
-                                                      settings,
-                                                      other_rank);
+                helper.template create_description_for_rank<
+                  Description<dim, spacedim>>(other_rank);
               // 3b) pack
               std::vector<char> buffer;
               dealii::Utilities::pack(construction_data, buffer, false);
@@ -876,10 +967,8 @@ namespace TriangulationDescription
 
           // 4) create TriangulationDescription::Description for this process
           // (root of group)
-          return create_description_from_triangulation(tria,
-                                                       comm,
-                                                       settings,
-                                                       my_rank);
+          return helper.template create_description_for_rank<
+            Description<dim, spacedim>>(my_rank);
         }
       else
         {
@@ -1094,6 +1183,246 @@ namespace TriangulationDescription
                                         settings);
     }
 
+
+
+    template <int dim, int spacedim>
+    Description<dim, spacedim>
+    create_description_from_subdivided_hyper_rectangle(
+      const std::vector<unsigned int>         &repetitions,
+      const Point<dim>                        &p_1,
+      const Point<dim>                        &p_2,
+      const MPI_Comm                           comm,
+      const bool                               colorize,
+      const TriangulationDescription::Settings settings)
+    {
+      AssertDimension(repetitions.size(), dim);
+
+      // normalize the corner points in the same way as
+      // GridGenerator::subdivided_hyper_rectangle() does, so that the
+      // vertices are bitwise identical to the ones of the serial mesh
+      Point<spacedim> p1, p2;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          p1[d] = std::min(p_1[d], p_2[d]);
+          p2[d] = std::max(p_1[d], p_2[d]);
+        }
+
+      // cells and vertices are both numbered lexicographically, set up the
+      // strides of these numberings
+      std::array<Point<spacedim>, dim>       delta;
+      std::array<types::coarse_cell_id, dim> cell_stride;
+      std::array<types::coarse_cell_id, dim> vertex_stride;
+      types::coarse_cell_id                  n_cells    = 1;
+      types::coarse_cell_id                  n_vertices = 1;
+      for (unsigned int d = 0; d < dim; ++d)
+        {
+          Assert(repetitions[d] >= 1,
+                 ExcMessage("The number of repetitions in each coordinate "
+                            "direction needs to be at least one."));
+
+          delta[d][d] = (p2[d] - p1[d]) / repetitions[d];
+          Assert(delta[d][d] > 0.0,
+                 ExcMessage("The first dim entries of coordinates of p1 and "
+                            "p2 need to be different."));
+
+          cell_stride[d] = n_cells;
+          n_cells *= repetitions[d];
+          vertex_stride[d] = n_vertices;
+          n_vertices *= repetitions[d] + 1;
+        }
+
+      const unsigned int my_rank =
+        dealii::Utilities::MPI::this_mpi_process(comm);
+      const unsigned int n_ranks =
+        dealii::Utilities::MPI::n_mpi_processes(comm);
+
+      // the cells [first_cell(r), first_cell(r+1)) are owned by rank r
+      const auto first_cell = [&](const unsigned int rank) {
+        return n_cells * rank / n_ranks;
+      };
+      const auto owner = [&](const types::coarse_cell_id cell) {
+        return static_cast<types::subdomain_id>(((cell + 1) * n_ranks - 1) /
+                                                n_cells);
+      };
+
+      const auto cell_coordinates = [&](types::coarse_cell_id cell) {
+        std::array<unsigned int, dim> coordinates;
+        for (unsigned int d = 0; d < dim; ++d)
+          {
+            coordinates[d] = cell % repetitions[d];
+            cell /= repetitions[d];
+          }
+        return coordinates;
+      };
+
+      const types::coarse_cell_id cell_begin = first_cell(my_rank);
+      const types::coarse_cell_id cell_end   = first_cell(my_rank + 1);
+
+      // 1) collect the locally owned cells and the cells sharing a vertex
+      //    with one of them. the latter differ in their id by at most the
+      //    sum of the strides from a locally owned cell, so only a small
+      //    range of ids around the locally owned ones needs to be checked.
+      std::vector<types::coarse_cell_id> relevant_cells;
+      if (cell_begin < cell_end)
+        {
+          types::coarse_cell_id halo = 0;
+          for (unsigned int d = 0; d < dim; ++d)
+            halo += cell_stride[d];
+
+          const types::coarse_cell_id first =
+            (cell_begin > halo ? cell_begin - halo : 0);
+          const types::coarse_cell_id last = std::min(cell_end + halo, n_cells);
+
+          for (types::coarse_cell_id cell = first; cell < last; ++cell)
+            {
+              if (cell >= cell_begin && cell < cell_end)
+                {
+                  relevant_cells.push_back(cell);
+                  continue;
+                }
+
+              const auto         coordinates = cell_coordinates(cell);
+              bool               is_ghost    = false;
+              const unsigned int n_neighbors = dealii::Utilities::pow(3, dim);
+              for (unsigned int n = 0; n < n_neighbors && !is_ghost; ++n)
+                {
+                  types::coarse_cell_id neighbor = 0;
+                  bool                  valid    = true;
+                  for (unsigned int d = 0, code = n; d < dim; ++d, code /= 3)
+                    {
+                      const int x = static_cast<int>(coordinates[d]) +
+                                    static_cast<int>(code % 3) - 1;
+                      if (x < 0 || x >= static_cast<int>(repetitions[d]))
+                        {
+                          valid = false;
+                          break;
+                        }
+                      neighbor += x * cell_stride[d];
+                    }
+                  if (valid && neighbor >= cell_begin && neighbor < cell_end)
+                    is_ghost = true;
+                }
+
+              if (is_ghost)
+                relevant_cells.push_back(cell);
+            }
+        }
+
+      const auto global_vertex_index = [&](const std::array<unsigned int, dim>
+                                             &coordinates,
+                                           const unsigned int v) {
+        types::coarse_cell_id index = 0;
+        for (unsigned int d = 0; d < dim; ++d)
+          index += (coordinates[d] + ((v >> d) & 1)) * vertex_stride[d];
+        return index;
+      };
+
+      // 2) enumerate the vertices of the locally relevant cells and compute
+      //    their coordinates
+      std::vector<types::coarse_cell_id> relevant_vertices;
+      relevant_vertices.reserve(relevant_cells.size() *
+                                GeometryInfo<dim>::vertices_per_cell);
+      for (const auto cell : relevant_cells)
+        {
+          const auto coordinates = cell_coordinates(cell);
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            relevant_vertices.push_back(global_vertex_index(coordinates, v));
+        }
+      std::sort(relevant_vertices.begin(), relevant_vertices.end());
+      relevant_vertices.erase(std::unique(relevant_vertices.begin(),
+                                          relevant_vertices.end()),
+                              relevant_vertices.end());
+
+      Description<dim, spacedim> description;
+
+      description.coarse_cell_vertices.reserve(relevant_vertices.size());
+      for (auto vertex : relevant_vertices)
+        {
+          Point<spacedim> p = p1;
+          for (unsigned int d = 0; d < dim; ++d)
+            {
+              p = p + static_cast<unsigned int>(vertex % (repetitions[d] + 1)) *
+                        delta[d];
+              vertex /= repetitions[d] + 1;
+            }
+          description.coarse_cell_vertices.push_back(p);
+        }
+
+      // 3) set up the coarse cells and their cell infos, using the same
+      //    material and boundary ids as the serial function
+      description.coarse_cells.reserve(relevant_cells.size());
+      description.coarse_cell_index_to_coarse_cell_id.reserve(
+        relevant_cells.size());
+      description.cell_infos.resize(1);
+      description.cell_infos[0].reserve(relevant_cells.size());
+      for (const auto cell : relevant_cells)
+        {
+          const auto coordinates = cell_coordinates(cell);
+
+          dealii::CellData<dim> cell_data;
+          Point<spacedim>       center;
+          for (const unsigned int v : GeometryInfo<dim>::vertex_indices())
+            {
+              cell_data.vertices[v] =
+                std::lower_bound(relevant_vertices.begin(),
+                                 relevant_vertices.end(),
+                                 global_vertex_index(coordinates, v)) -
+                relevant_vertices.begin();
+              center += description.coarse_cell_vertices[cell_data.vertices[v]];
+            }
+          center /= GeometryInfo<dim>::vertices_per_cell;
+
+          if (colorize)
+            {
+              if (dim == 1)
+                cell_data.material_id = (center[0] > 0 ? 1 : 0);
+              else
+                for (unsigned int d = 0; d < dim; ++d)
+                  if (center[d] > 0)
+                    cell_data.material_id += (1 << d);
+            }
+
+          description.coarse_cells.push_back(cell_data);
+          description.coarse_cell_index_to_coarse_cell_id.push_back(cell);
+
+          CellData<dim> cell_info;
+          cell_info.id = CellId(cell, {}).template to_binary<dim>();
+
+          cell_info.subdomain_id       = owner(cell);
+          cell_info.level_subdomain_id = owner(cell);
+          cell_info.manifold_id        = numbers::flat_manifold_id;
+          std::fill(cell_info.manifold_line_ids.begin(),
+                    cell_info.manifold_line_ids.end(),
+                    numbers::flat_manifold_id);
+          std::fill(cell_info.manifold_quad_ids.begin(),
+                    cell_info.manifold_quad_ids.end(),
+                    numbers::flat_manifold_id);
+
+          // in 1d, the two ends of the interval have boundary ids 0 and 1
+          // also without colorization
+          for (const unsigned int f : GeometryInfo<dim>::face_indices())
+            {
+              const unsigned int d = f / 2;
+              if ((f % 2 == 0 && coordinates[d] == 0) ||
+                  (f % 2 == 1 && coordinates[d] + 1 == repetitions[d]))
+                cell_info.boundary_ids.emplace_back(
+                  f, (colorize || dim == 1) ? f : 0);
+            }
+
+          description.cell_infos[0].push_back(cell_info);
+        }
+
+      description.comm     = comm;
+      description.settings = settings;
+      description.smoothing =
+        (settings &
+             TriangulationDescription::Settings::construct_multigrid_hierarchy ?
+           Triangulation<dim, spacedim>::limit_level_difference_at_vertices :
+           Triangulation<dim, spacedim>::none);
+
+      return description;
+    }
+
   } // namespace Utilities
 } // namespace TriangulationDescription
 
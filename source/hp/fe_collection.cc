@@ -21,6 +21,8 @@
 
 #include <limits>
 #include <set>
+#include <shared_mutex>
+#include <tuple>
 
 
 
@@ -74,6 +76,10 @@ namespace hp
                       "same number of vector components!"));
 
     Collection<FiniteElement<dim, spacedim>>::push_back(new_fe.clone());
+
+    // the cached query results may be shared with copies of this object that
+    // do not contain the new element, so start over with a new cache
+    query_cache = std::make_shared<QueryCache>();
   }
 
 
@@ -211,9 +217,23 @@ namespace hp
       AssertIndexRange(fe, this->size());
 #endif
 
+    // See if we have answered this query before. The key only references
+    // the set of elements, so that lookups do not need to copy it.
+    const std::tuple<bool, const std::set<unsigned int> &, unsigned int> key(
+      false, fes, codim);
+    if (query_cache != nullptr)
+      {
+        std::shared_lock<std::shared_mutex> lock(query_cache->mutex);
+        const auto entry = query_cache->dominating_fes.find(key);
+        if (entry != query_cache->dominating_fes.end())
+          return entry->second;
+      }
+
     // There may also be others, in which case we'll check if any of these
     // elements is able to dominate all others. If one was found, we stop
-    // looking further and return the dominating element.
+    // looking further and return the dominating element. If we can't find
+    // one, we return an invalid index.
+    unsigned int dominating_fe = numbers::invalid_fe_index;
     for (const auto &current_fe : fes)
       {
         // Check if current_fe can dominate all elements in @p fes.
@@ -230,11 +250,19 @@ namespace hp
         if ((domination == FiniteElementDomination::this_element_dominates) ||
             (domination == FiniteElementDomination::either_element_can_dominate
              /*covers cases like {Q2,Q3,Q1,Q1} with fes={2,3}*/))
-          return current_fe;
+          {
+            dominating_fe = current_fe;
+            break;
+          }
       }
 
-    // If we couldn't find the dominating object, return an invalid one.
-    return numbers::invalid_fe_index;
+    if (query_cache != nullptr)
+      {
+        std::unique_lock<std::shared_mutex> lock(query_cache->mutex);
+        query_cache->dominating_fes.emplace(key, dominating_fe);
+      }
+
+    return dominating_fe;
   }
 
 
@@ -292,6 +320,18 @@ namespace hp
     const std::set<unsigned int> &fes,
     const unsigned int            codim) const
   {
+    // See if we have answered this query before. The key only references
+    // the set of elements, so that lookups do not need to copy it.
+    const std::tuple<bool, const std::set<unsigned int> &, unsigned int> key(
+      true, fes, codim);
+    if (query_cache != nullptr)
+      {
+        std::shared_lock<std::shared_mutex> lock(query_cache->mutex);
+        const auto entry = query_cache->dominating_fes.find(key);
+        if (entry != query_cache->dominating_fes.end())
+          return entry->second;
+      }
+
     unsigned int fe_index = find_dominating_fe(fes, codim);
 
     if (fe_index == numbers::invalid_fe_index)
@@ -301,6 +341,12 @@ namespace hp
         fe_index = find_dominated_fe(dominating_fes, codim);
       }
 
+    if (query_cache != nullptr)
+      {
+        std::unique_lock<std::shared_mutex> lock(query_cache->mutex);
+        query_cache->dominating_fes.emplace(key, fe_index);
+      }
+
     return fe_index;
   }
 
@@ -568,6 +614,87 @@ namespace hp
 
 
 
+  template <int dim, int spacedim>
+  const std::vector<std::pair<unsigned int, unsigned int>> &
+  FECollection<dim, spacedim>::hp_object_dof_identities(
+    const unsigned int structdim,
+    const unsigned int fe_index_1,
+    const unsigned int fe_index_2,
+    const unsigned int face_no) const
+  {
+    AssertIndexRange(structdim, 3);
+    AssertIndexRange(fe_index_1, this->size());
+    AssertIndexRange(fe_index_2, this->size());
+    Assert(query_cache != nullptr, ExcInternalError());
+
+    // The face number only matters for quads. Don't let it create distinct
+    // entries for vertices and lines.
+    const auto key = std::make_tuple(structdim,
+                                     fe_index_1,
+                                     fe_index_2,
+                                     (structdim == 2 ? face_no : 0u));
+    {
+      std::shared_lock<std::shared_mutex> lock(query_cache->mutex);
+      const auto entry = query_cache->dof_identities.find(key);
+      if (entry != query_cache->dof_identities.end())
+        return entry->second;
+    }
+
+    // Compute the identities outside the lock, since querying the elements
+    // may be expensive. If another thread computes the same entry in the
+    // meantime, the first one to be stored wins; both are identical anyway.
+    const std::set<unsigned int> fes{fe_index_1, fe_index_2};
+    std::vector<std::map<unsigned int, unsigned int>> complete_identities;
+    switch (structdim)
+      {
+        case 0:
+          complete_identities = hp_vertex_dof_identities(fes);
+          break;
+        case 1:
+          complete_identities = hp_line_dof_identities(fes);
+          break;
+        case 2:
+          complete_identities = hp_quad_dof_identities(fes, face_no);
+          break;
+        default:
+          Assert(false, ExcNotImplemented());
+      }
+
+    // Each entry of 'complete_identities' contains a set of pairs
+    // (fe_index,dof_index). Reduce these to pairs of DoF indices by asking
+    // the std::map for the dof_index that matches fe_index_1 and fe_index_2,
+    // respectively:
+    std::vector<std::pair<unsigned int, unsigned int>> identities;
+    identities.reserve(complete_identities.size());
+    for (const auto &complete_identity : complete_identities)
+      {
+        Assert(complete_identity.size() == fes.size(), ExcInternalError());
+        identities.emplace_back(complete_identity.at(fe_index_1),
+                                complete_identity.at(fe_index_2));
+      }
+
+#ifdef DEBUG
+    // double check whether the newly created entries make any sense at all
+    const auto n_dofs_per_object = [&](const unsigned int fe_index) {
+      const FiniteElement<dim, spacedim> &fe = (*this)[fe_index];
+      return (structdim == 0 ? fe.n_dofs_per_vertex() :
+              structdim == 1 ? fe.n_dofs_per_line() :
+                               fe.n_dofs_per_quad(face_no));
+    };
+    for (const auto &identity : identities)
+      {
+        AssertIndexRange(identity.first, n_dofs_per_object(fe_index_1));
+        AssertIndexRange(identity.second, n_dofs_per_object(fe_index_2));
+      }
+#endif
+
+    std::unique_lock<std::shared_mutex> lock(query_cache->mutex);
+    return query_cache->dof_identities.emplace(key, std::move(identities))
+      .first->second;
+  }
+
+
+
   template <int dim, int spacedim>
   void
   FECollection<dim, spacedim>::set_hierarchy(
@@ -15,6 +15,8 @@
 
 
 #include <deal.II/base/exceptions.h>
+#include <deal.II/base/multithread_info.h>
+#include <deal.II/base/parallel.h>
 
 #include <deal.II/lac/exceptions.h>
 #include <deal.II/lac/sparsity_pattern.h>
@@ -571,6 +573,93 @@ namespace SparsityTools
 
       return starting_point;
     }
+
+
+
+    /**
+     * Append to @p next_round_dofs all as-yet unnumbered neighbors of the
+     * indices in @p last_round_dofs, each of them exactly once, and mark them
+     * as found by setting their entry in @p new_indices to zero.
+     *
+     * Large fronts are split into chunks whose neighbors are collected in
+     * parallel. The order in which the neighbors are appended then differs
+     * from the one of the sequential loop, but since the caller sorts them
+     * by coordination number and index, this has no effect on the final
+     * numbering.
+     */
+    void
+    find_unnumbered_neighbors(
+      const DynamicSparsityPattern                         &sparsity,
+      const std::vector<DynamicSparsityPattern::size_type> &last_round_dofs,
+      std::vector<DynamicSparsityPattern::size_type>       &new_indices,
+      std::vector<DynamicSparsityPattern::size_type>       &next_round_dofs)
+    {
+      const unsigned int min_chunk_size = 256;
+      const unsigned int n_chunks       = std::min<std::size_t>(
+        4 * MultithreadInfo::n_threads(),
+        last_round_dofs.size() / min_chunk_size);
+
+      if (n_chunks <= 1)
+        {
+          for (const auto dof : last_round_dofs)
+            {
+              const unsigned int row_length = sparsity.row_length(dof);
+              for (unsigned int i = 0; i < row_length; ++i)
+                {
+                  // skip dofs which are already numbered
+                  const auto column = sparsity.column_number(dof, i);
+                  if (new_indices[column] == numbers::invalid_size_type)
+                    {
+                      next_round_dofs.push_back(column);
+
+                      // assign a dummy value to 'new_indices' to avoid adding
+                      // the same index again; those will get the right
+                      // number in the caller
+                      new_indices[column] = 0;
+                    }
+                }
+            }
+          return;
+        }
+
+      // collect the candidates of each chunk without modifying
+      // 'new_indices', which is only read concurrently, ...
+      std::vector<std::vector<DynamicSparsityPattern::size_type>> candidates(
+        n_chunks);
+      parallel::apply_to_subranges(
+        0u,
+        n_chunks,
+        [&](const unsigned int begin, const unsigned int end) {
+          for (unsigned int chunk = begin; chunk < end; ++chunk)
+            {
+              const std::size_t first =
+                last_round_dofs.size() * chunk / n_chunks;
+              const std::size_t last =
+                last_round_dofs.size() * (chunk + 1) / n_chunks;
+              for (std::size_t k = first; k < last; ++k)
+                {
+                  const auto         dof        = last_round_dofs[k];
+                  const unsigned int row_length = sparsity.row_length(dof);
+                  for (unsigned int i = 0; i < row_length; ++i)
+                    {
+                      const auto column = sparsity.column_number(dof, i);
+                      if (new_indices[column] == numbers::invalid_size_type)
+                        candidates[chunk].push_back(column);
+                    }
+                }
+            }
+        },
+        1);
+
+      // ... and then remove the duplicates
+      for (const auto &chunk_candidates : candidates)
+        for (const auto column : chunk_candidates)
+          if (new_indices[column] == numbers::invalid_size_type)
+            {
+              next_round_dofs.push_back(column);
+              new_indices[column] = 0;
+            }
+    }
   } // namespace internal
 
 
@@ -637,25 +726,12 @@ namespace SparsityTools
       {
         next_round_dofs.clear();
 
-        // find all neighbors of the dofs numbered in the last round
-        for (const auto dof : last_round_dofs)
-          {
-            const unsigned int row_length = sparsity.row_length(dof);
-            for (unsigned int i = 0; i < row_length; ++i)
-              {
-                // skip dofs which are already numbered
-                const auto column = sparsity.column_number(dof, i);
-                if (new_indices[column] == numbers::invalid_size_type)
-                  {
-                    next_round_dofs.push_back(column);
-
-                    // assign a dummy value to 'new_indices' to avoid adding
-                    // the same index again; those will get the right number
-                    // at the end of the outer 'while' loop
-                    new_indices[column] = 0;
-                  }
-              }
-          }
+        // find all neighbors of the dofs numbered in the last round. they
+        // will get the right number at the end of the outer 'while' loop
+        internal::find_unnumbered_neighbors(sparsity,
+                                            last_round_dofs,
+                                            new_indices,
+                                            next_round_dofs);
 
         // check whether there are any new dofs in the list. if there are
         // none, then we have completely numbered the current component of the
@@ -901,6 +977,73 @@ namespace SparsityTools
 
 
 
+  void
+  reorder_nested_dissection(
+    const DynamicSparsityPattern                   &sparsity,
+    std::vector<DynamicSparsityPattern::size_type> &new_indices)
+  {
+    Assert(sparsity.n_rows() == sparsity.n_cols(),
+           ExcDimensionMismatch(sparsity.n_rows(), sparsity.n_cols()));
+    Assert(sparsity.n_rows() == new_indices.size(),
+           ExcDimensionMismatch(sparsity.n_rows(), new_indices.size()));
+    Assert(sparsity.row_index_set().size() == 0 ||
+             sparsity.row_index_set().size() == sparsity.n_rows(),
+           ExcMessage(
+             "Only valid for sparsity patterns which store all rows."));
+
+#ifndef DEAL_II_WITH_METIS
+    (void)sparsity;
+    (void)new_indices;
+    AssertThrow(false, ExcMETISNotInstalled());
+#else
+    if (sparsity.n_rows() == 0)
+      return;
+
+    // set up the graph in the compressed row storage format METIS expects.
+    // contrary to the partitioning functions above, the graph must not
+    // contain any self-loops, so skip the diagonal entries
+    idx_t n = static_cast<idx_t>(sparsity.n_rows());
+
+    std::vector<idx_t> int_rowstart(1);
+    int_rowstart.reserve(sparsity.n_rows() + 1);
+    std::vector<idx_t> int_colnums;
+    int_colnums.reserve(sparsity.n_nonzero_elements());
+    for (DynamicSparsityPattern::size_type row = 0; row < sparsity.n_rows();
+         ++row)
+      {
+        const unsigned int row_length = sparsity.row_length(row);
+        for (unsigned int i = 0; i < row_length; ++i)
+          {
+            const auto column = sparsity.column_number(row, i);
+            if (column != row)
+              int_colnums.push_back(static_cast<idx_t>(column));
+          }
+        int_rowstart.push_back(int_colnums.size());
+      }
+
+    idx_t options[METIS_NOPTIONS];
+    METIS_SetDefaultOptions(options);
+
+    // METIS returns two permutations: 'perm' maps new to old indices, and
+    // 'iperm' maps old to new indices, which is what we want
+    std::vector<idx_t> perm(sparsity.n_rows());
+    std::vector<idx_t> iperm(sparsity.n_rows());
+
+    const int ierr = METIS_NodeND(&n,
+                                  int_rowstart.data(),
+                                  int_colnums.data(),
+                                  nullptr,
+                                  options,
+                                  perm.data(),
+                                  iperm.data());
+    AssertThrow(ierr == 1, ExcMETISError(ierr));
+
+    std::copy(iperm.begin(), iperm.end(), new_indices.begin());
+#endif
+  }
+
+
+
 #ifdef DEAL_II_WITH_MPI
 
   void
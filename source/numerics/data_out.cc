@@ -13,6 +13,7 @@
 //
 // ---------------------------------------------------------------------
 
+#include <deal.II/base/quadrature_lib.h>
 #include <deal.II/base/work_stream.h>
 
 #include <deal.II/dofs/dof_accessor.h>
@@ -30,6 +31,9 @@
 
 #include <deal.II/numerics/data_out.h>
 
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <sstream>
 
 DEAL_II_NAMESPACE_OPEN
@@ -66,6 +70,10 @@ namespace internal
 
 template <int dim, int spacedim>
 DataOut<dim, spacedim>::DataOut()
+  : cache_geometry(false)
+  , cached_n_subdivisions(0)
+  , cached_curved_cell_region(no_curved_cells)
+  , cached_triangulation(nullptr)
 {
   set_cell_selection(
     [this](const Triangulation<dim, spacedim> &) {
@@ -91,13 +99,23 @@ DataOut<dim, spacedim>::DataOut()
 
 
 
+template <int dim, int spacedim>
+DataOut<dim, spacedim>::~DataOut()
+{
+  tria_listener_any_change.disconnect();
+  tria_listener_repartition.disconnect();
+}
+
+
+
 template <int dim, int spacedim>
 void
 DataOut<dim, spacedim>::build_one_patch(
   const std::pair<cell_iterator, unsigned int>                 *cell_and_index,
   internal::DataOutImplementation::ParallelData<dim, spacedim> &scratch_data,
   const unsigned int                                            n_subdivisions,
-  const CurvedCellRegion curved_cell_region)
+  const CurvedCellRegion curved_cell_region,
+  const bool             use_cached_geometry)
 {
   // first create the output object that we will write into
 
@@ -111,9 +129,23 @@ DataOut<dim, spacedim>::build_one_patch(
   const FEValuesBase<dim, spacedim> &fe_patch_values =
     scratch_data.get_present_fe_values(0);
 
-  const auto vertices =
-    fe_patch_values.get_mapping().get_vertices(cell_and_index->first);
-  std::copy(vertices.begin(), vertices.end(), std::begin(patch.vertices));
+  // the patches are built in the order of the cells, so the position of
+  // the cell in the list of cells is the index of the patch in the cache
+  const DataOutBase::Patch<dim, spacedim> *cached_patch =
+    (use_cached_geometry ?
+       &cached_patches[cell_and_index - cached_cells.data()] :
+       nullptr);
+
+  if (use_cached_geometry)
+    std::copy(std::begin(cached_patch->vertices),
+              std::end(cached_patch->vertices),
+              std::begin(patch.vertices));
+  else
+    {
+      const auto vertices =
+        fe_patch_values.get_mapping().get_vertices(cell_and_index->first);
+      std::copy(vertices.begin(), vertices.end(), std::begin(patch.vertices));
+    }
 
   const unsigned int n_q_points = fe_patch_values.n_quadrature_points;
 
@@ -140,11 +172,26 @@ DataOut<dim, spacedim>::build_one_patch(
   // want to produce curved cells everywhere
   //
   // note: a cell is *always* at the boundary if dim<spacedim
-  if (curved_cell_region == curved_inner_cells ||
-      (curved_cell_region == curved_boundary &&
-       (cell_and_index->first->at_boundary() || (dim != spacedim))) ||
-      (cell_and_index->first->reference_cell() !=
-       ReferenceCells::get_hypercube<dim>()))
+  if (use_cached_geometry)
+    {
+      // copy the points from the cache if they are available
+      patch.points_are_available = cached_patch->points_are_available;
+      if (patch.points_are_available)
+        {
+          patch.data.reinit(scratch_data.n_datasets + spacedim, n_q_points);
+          for (unsigned int i = 0; i < spacedim; ++i)
+            for (unsigned int q = 0; q < n_q_points; ++q)
+              patch.data(patch.data.size(0) - spacedim + i, q) =
+                cached_patch->data(i, q);
+        }
+      else
+        patch.data.reinit(scratch_data.n_datasets, n_q_points);
+    }
+  else if (curved_cell_region == curved_inner_cells ||
+           (curved_cell_region == curved_boundary &&
+            (cell_and_index->first->at_boundary() || (dim != spacedim))) ||
+           (cell_and_index->first->reference_cell() !=
+            ReferenceCells::get_hypercube<dim>()))
     {
       Assert(patch.space_dim == spacedim, ExcInternalError());
 
@@ -1002,6 +1049,16 @@ DataOut<dim, spacedim>::build_one_patch(
     }
 
 
+  if (use_cached_geometry)
+    {
+      patch.neighbors   = cached_patch->neighbors;
+      patch.patch_index = cached_patch->patch_index;
+
+      // Put the patch into the patches vector
+      this->patches[patch.patch_index].swap(patch);
+      return;
+    }
+
   for (const unsigned int f : cell_and_index->first->face_indices())
     {
       // let's look up whether the neighbor behind that face is noted in the
@@ -1106,6 +1163,18 @@ DataOut<dim, spacedim>::build_patches(
 
   this->validate_dataset_names();
 
+  const CurvedCellRegion curved_cell_region =
+    (n_subdivisions < 2 ? no_curved_cells : curved_region);
+
+  // If the geometry of the patches built on the same triangulation with the
+  // same parameters is in the cache, we can skip the setup of the list of
+  // cells below and only need to compute the data on the cells
+  const bool use_cached_geometry =
+    cache_geometry && (cached_cells.empty() == false) &&
+    (cached_triangulation == &*this->triangulation) &&
+    (cached_n_subdivisions == n_subdivisions) &&
+    (cached_curved_cell_region == curved_cell_region);
+
   // First count the cells we want to create patches of. Also fill the object
   // that maps the cell indices to the patch numbers, as this will be needed
   // for generation of neighborship information.
@@ -1123,8 +1192,9 @@ DataOut<dim, spacedim>::build_patches(
   // Now construct the map such that
   // cell_to_patch_index_map[cell->level][cell->index] = patch_index
   std::vector<std::vector<unsigned int>> cell_to_patch_index_map;
-  cell_to_patch_index_map.resize(this->triangulation->n_levels());
-  for (unsigned int l = 0; l < this->triangulation->n_levels(); ++l)
+  if (use_cached_geometry == false)
+    cell_to_patch_index_map.resize(this->triangulation->n_levels());
+  for (unsigned int l = 0; l < cell_to_patch_index_map.size(); ++l)
     {
       // max_index is the largest cell->index on level l
       unsigned int max_index = 0;
@@ -1141,44 +1211,49 @@ DataOut<dim, spacedim>::build_patches(
 
   // will be all_cells[patch_index] = pair(cell, active_index)
   std::vector<std::pair<cell_iterator, unsigned int>> all_cells;
-  {
-    // important: we need to compute the active_index of the cell in the range
-    // 0..n_active_cells() because this is where we need to look up cell
-    // data from (cell data vectors do not have the length distance computed by
-    // first_cell_function/next_cell_function because this might skip
-    // some values (FilteredIterator).
-    auto          active_cell  = this->triangulation->begin_active();
-    unsigned int  active_index = 0;
-    cell_iterator cell         = first_cell_function(*this->triangulation);
-    for (; cell != this->triangulation->end();
-         cell = next_cell_function(*this->triangulation, cell))
-      {
-        // move forward until active_cell points at the cell (cell) we are
-        // looking at to compute the current active_index
-        while (active_cell != this->triangulation->end() && cell->is_active() &&
-               decltype(active_cell)(cell) != active_cell)
-          {
-            ++active_cell;
-            ++active_index;
-          }
+  if (use_cached_geometry == false)
+    {
+      // important: we need to compute the active_index of the cell in the
+      // range 0..n_active_cells() because this is where we need to look up
+      // cell data from (cell data vectors do not have the length distance
+      // computed by first_cell_function/next_cell_function because this might
+      // skip some values (FilteredIterator).
+      auto          active_cell  = this->triangulation->begin_active();
+      unsigned int  active_index = 0;
+      cell_iterator cell         = first_cell_function(*this->triangulation);
+      for (; cell != this->triangulation->end();
+           cell = next_cell_function(*this->triangulation, cell))
+        {
+          // move forward until active_cell points at the cell (cell) we are
+          // looking at to compute the current active_index
+          while (active_cell != this->triangulation->end() &&
+                 cell->is_active() &&
+                 decltype(active_cell)(cell) != active_cell)
+            {
+              ++active_cell;
+              ++active_index;
+            }
 
-        Assert(static_cast<unsigned int>(cell->level()) <
-                 cell_to_patch_index_map.size(),
-               ExcInternalError());
-        Assert(static_cast<unsigned int>(cell->index()) <
-                 cell_to_patch_index_map[cell->level()].size(),
-               ExcInternalError());
-        Assert(active_index < this->triangulation->n_active_cells(),
-               ExcInternalError());
-        cell_to_patch_index_map[cell->level()][cell->index()] =
-          all_cells.size();
-
-        all_cells.emplace_back(cell, active_index);
-      }
-  }
+          Assert(static_cast<unsigned int>(cell->level()) <
+                   cell_to_patch_index_map.size(),
+                 ExcInternalError());
+          Assert(static_cast<unsigned int>(cell->index()) <
+                   cell_to_patch_index_map[cell->level()].size(),
+                 ExcInternalError());
+          Assert(active_index < this->triangulation->n_active_cells(),
+                 ExcInternalError());
+          cell_to_patch_index_map[cell->level()][cell->index()] =
+            all_cells.size();
+
+          all_cells.emplace_back(cell, active_index);
+        }
+    }
+
+  const std::vector<std::pair<cell_iterator, unsigned int>> &cells =
+    (use_cached_geometry ? cached_cells : all_cells);
 
   this->patches.clear();
-  this->patches.resize(all_cells.size());
+  this->patches.resize(cells.size());
 
   // Now create a default object for the WorkStream object to work with. The
   // first step is to count how many output data sets there will be. This is,
@@ -1207,11 +1282,8 @@ DataOut<dim, spacedim>::build_patches(
     else
       n_postprocessor_outputs[dataset] = 0;
 
-  const CurvedCellRegion curved_cell_region =
-    (n_subdivisions < 2 ? no_curved_cells : curved_region);
-
   UpdateFlags update_flags = update_values;
-  if (curved_cell_region != no_curved_cells)
+  if ((curved_cell_region != no_curved_cells) && !use_cached_geometry)
     update_flags |= update_quadrature_points;
 
   for (unsigned int i = 0; i < this->dof_data.size(); ++i)
@@ -1235,7 +1307,7 @@ DataOut<dim, spacedim>::build_patches(
     update_flags,
     cell_to_patch_index_map);
 
-  auto worker = [this, n_subdivisions, curved_cell_region](
+  auto worker = [this, n_subdivisions, curved_cell_region, use_cached_geometry](
                   const std::pair<cell_iterator, unsigned int> *cell_and_index,
                   internal::DataOutImplementation::ParallelData<dim, spacedim>
                     &scratch_data,
@@ -1245,13 +1317,14 @@ DataOut<dim, spacedim>::build_patches(
     this->build_one_patch(cell_and_index,
                           scratch_data,
                           n_subdivisions,
-                          curved_cell_region);
+                          curved_cell_region,
+                          use_cached_geometry);
   };
 
   // now build the patches in parallel
-  if (all_cells.size() > 0)
-    WorkStream::run(all_cells.data(),
-                    all_cells.data() + all_cells.size(),
+  if (cells.size() > 0)
+    WorkStream::run(cells.data(),
+                    cells.data() + cells.size(),
                     worker,
                     // no copy-local-to-global function needed here
                     std::function<void(const int)>(),
@@ -1265,6 +1338,431 @@ DataOut<dim, spacedim>::build_patches(
                     // @ref workstream_paper, on 32 cores) and if
                     8 * MultithreadInfo::n_threads(),
                     64);
+
+  // If requested, store the geometric part of the patches we have just
+  // built for later calls of this function
+  if (cache_geometry && (use_cached_geometry == false))
+    {
+      if (cached_triangulation != &*this->triangulation)
+        {
+          tria_listener_any_change.disconnect();
+          tria_listener_repartition.disconnect();
+          tria_listener_any_change =
+            this->triangulation->signals.any_change.connect(
+              [this]() { this->clear_geometry_cache(); });
+          tria_listener_repartition =
+            this->triangulation->signals.post_distributed_repartition.connect(
+              [this]() { this->clear_geometry_cache(); });
+          cached_triangulation = &*this->triangulation;
+        }
+
+      cached_cells = std::move(all_cells);
+      cached_patches.resize(this->patches.size());
+      for (unsigned int i = 0; i < this->patches.size(); ++i)
+        {
+          const auto &patch        = this->patches[i];
+          auto       &cached_patch = cached_patches[i];
+          std::copy(std::begin(patch.vertices),
+                    std::end(patch.vertices),
+                    std::begin(cached_patch.vertices));
+          cached_patch.neighbors            = patch.neighbors;
+          cached_patch.patch_index          = patch.patch_index;
+          cached_patch.n_subdivisions       = patch.n_subdivisions;
+          cached_patch.points_are_available = patch.points_are_available;
+          cached_patch.reference_cell       = patch.reference_cell;
+          if (patch.points_are_available)
+            {
+              const unsigned int first_point_row =
+                patch.data.size(0) - spacedim;
+              cached_patch.data.reinit(spacedim, patch.data.size(1));
+              for (unsigned int d = 0; d < spacedim; ++d)
+                for (unsigned int q = 0; q < patch.data.size(1); ++q)
+                  cached_patch.data(d, q) = patch.data(first_point_row + d, q);
+            }
+          else
+            cached_patch.data.reinit(0, 0);
+        }
+      cached_n_subdivisions     = n_subdivisions;
+      cached_curved_cell_region = curved_cell_region;
+
+      // let the output functions know that the geometry has changed
+      ++this->patch_geometry_id;
+    }
+  else if (cache_geometry == false)
+    this->patch_geometry_id = 0;
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOut<dim, spacedim>::write_vtu_higher_order(
+  std::ostream                 &out,
+  const Mapping<dim, spacedim> &mapping,
+  const unsigned int            n_subdivisions_) const
+{
+  Assert(this->triangulation != nullptr,
+         Exceptions::DataOutImplementation::ExcNoTriangulationSelected());
+
+  const unsigned int n_subdivisions =
+    (n_subdivisions_ != 0) ? n_subdivisions_ : this->default_subdivisions;
+  Assert(n_subdivisions >= 1,
+         Exceptions::DataOutImplementation::ExcInvalidNumberOfSubdivisions(
+           n_subdivisions));
+  AssertThrow(this->triangulation->all_reference_cells_are_hyper_cube(),
+              ExcNotImplemented());
+
+  this->validate_dataset_names();
+
+  for (const auto &dataset : this->dof_data)
+    AssertThrow(dataset->postprocessor == nullptr &&
+                  dataset->is_complex_valued() == false &&
+                  dataset->dof_handler->has_hp_capabilities() == false,
+                ExcMessage("DataOut::write_vtu_higher_order() only supports "
+                           "real-valued data vectors without postprocessor "
+                           "on DoFHandler objects without hp-capabilities."));
+  for (const auto &dataset : this->cell_data)
+    AssertThrow(dataset->is_complex_valued() == false,
+                ExcMessage("DataOut::write_vtu_higher_order() only supports "
+                           "real-valued cell data vectors."));
+
+  // For each data set, i.e., each component of the output, find the vector
+  // it comes from (counting the dof data vectors first and then the cell
+  // data vectors, in the same order as get_dataset_names()) and the
+  // component within that vector
+  const std::vector<std::string> data_names = this->get_dataset_names();
+
+  std::vector<std::pair<unsigned int, unsigned int>> data_set_source;
+  for (unsigned int i = 0; i < this->dof_data.size(); ++i)
+    for (unsigned int c = 0; c < this->dof_data[i]->n_output_variables; ++c)
+      data_set_source.emplace_back(i, c);
+  for (unsigned int i = 0; i < this->cell_data.size(); ++i)
+    data_set_source.emplace_back(this->dof_data.size() + i, 0);
+  AssertDimension(data_set_source.size(), data_names.size());
+
+  std::vector<cell_iterator> cells;
+  for (cell_iterator cell = first_cell_function(*this->triangulation);
+       cell != this->triangulation->end();
+       cell = next_cell_function(*this->triangulation, cell))
+    cells.push_back(cell);
+
+  DataOutBase::VtkFlags flags    = this->get_vtk_flags();
+  flags.write_higher_order_cells = true;
+
+  const QIterated<dim> quadrature(QTrapezoid<1>(), n_subdivisions);
+  const unsigned int   n_points_per_cell = quadrature.size();
+  const unsigned int   n_cells           = cells.size();
+  const unsigned int   n_points          = n_cells * n_points_per_cell;
+
+  // The FEValues objects of the dof data vectors, set up when a vector is
+  // first evaluated and reused for all of its data sets
+  std::vector<std::unique_ptr<FEValues<dim, spacedim>>> fe_values_of_vector(
+    this->dof_data.size());
+
+  // Evaluate the data sets first_data_set, ..., last_data_set, which all
+  // need to come from the same vector, on all cells, and return them with
+  // the components of each point stored contiguously
+  const auto evaluate_data_sets = [&](const unsigned int first_data_set,
+                                      const unsigned int last_data_set) {
+    const unsigned int n_components = last_data_set - first_data_set + 1;
+    const unsigned int vector_index = data_set_source[first_data_set].first;
+    const unsigned int first_component =
+      data_set_source[first_data_set].second;
+    AssertDimension(data_set_source[last_data_set].first, vector_index);
+
+    std::vector<float> values(n_points * n_components);
+    if (vector_index < this->dof_data.size())
+      {
+        const auto &dataset = this->dof_data[vector_index];
+        const auto &fe      = dataset->dof_handler->get_fe();
+
+        if (fe_values_of_vector[vector_index] == nullptr)
+          fe_values_of_vector[vector_index] =
+            std::make_unique<FEValues<dim, spacedim>>(mapping,
+                                                      fe,
+                                                      quadrature,
+                                                      update_values);
+        FEValues<dim, spacedim> &fe_values = *fe_values_of_vector[vector_index];
+
+        std::vector<double>         scalar_values(n_points_per_cell);
+        std::vector<Vector<double>> system_values(
+          n_points_per_cell, Vector<double>(fe.n_components()));
+
+        for (unsigned int c = 0; c < n_cells; ++c)
+          {
+            const typename DoFHandler<dim, spacedim>::cell_iterator dh_cell(
+              &cells[c]->get_triangulation(),
+              cells[c]->level(),
+              cells[c]->index(),
+              dataset->dof_handler);
+            fe_values.reinit(dh_cell);
+
+            float *cell_values =
+              values.data() + c * n_points_per_cell * n_components;
+            if (fe.n_components() == 1)
+              {
+                dataset->get_function_values(
+                  fe_values,
+                  internal::DataOutImplementation::ComponentExtractor::
+                    real_part,
+                  scalar_values);
+                for (unsigned int q = 0; q < n_points_per_cell; ++q)
+                  cell_values[q] = scalar_values[q];
+              }
+            else
+              {
+                dataset->get_function_values(
+                  fe_values,
+                  internal::DataOutImplementation::ComponentExtractor::
+                    real_part,
+                  system_values);
+                for (unsigned int q = 0; q < n_points_per_cell; ++q)
+                  for (unsigned int i = 0; i < n_components; ++i)
+                    cell_values[q * n_components + i] =
+                      system_values[q](first_component + i);
+              }
+          }
+      }
+    else
+      {
+        const auto &dataset =
+          this->cell_data[vector_index - this->dof_data.size()];
+        for (unsigned int c = 0; c < n_cells; ++c)
+          {
+            Assert(cells[c]->is_active(), ExcNotImplemented());
+            const float value = dataset->get_cell_data_value(
+              cells[c]->active_cell_index(),
+              internal::DataOutImplementation::ComponentExtractor::real_part);
+            std::fill(values.begin() + c * n_points_per_cell * n_components,
+                      values.begin() +
+                        (c + 1) * n_points_per_cell * n_components,
+                      value);
+          }
+      }
+    return values;
+  };
+
+  const auto units_attribute = [&flags](const std::string &name) {
+    if (flags.physical_units.find(name) != flags.physical_units.end())
+      return " units=\"" + flags.physical_units.at(name) + "\"";
+    else
+      return std::string();
+  };
+
+  // The locations of the points, padded to three coordinates as VTU wants
+  // it, and then the description of the cells. Since all cells have the same
+  // number of points, the ordering of the points within a cell is the same
+  // for all of them.
+  const auto write_vertex_information = [&]() {
+    const FE_DGQ<dim, spacedim> fe(0);
+    FEValues<dim, spacedim>     fe_values(mapping,
+                                          fe,
+                                          quadrature,
+                                          update_quadrature_points);
+    std::vector<float>          coordinates(n_points * 3, 0.f);
+    for (unsigned int c = 0; c < n_cells; ++c)
+      {
+        fe_values.reinit(cells[c]);
+        for (unsigned int q = 0; q < n_points_per_cell; ++q)
+          for (unsigned int d = 0; d < spacedim; ++d)
+            coordinates[(c * n_points_per_cell + q) * 3 + d] =
+              fe_values.quadrature_point(q)[d];
+      }
+
+    out << "  <Points>\n";
+    DataOutBase::write_vtu_data_array(
+      coordinates, "type=\"Float32\" NumberOfComponents=\"3\"", flags, out);
+    out << "  </Points>\n\n";
+  };
+
+  const auto write_cell_information = [&]() {
+    const ReferenceCell reference_cell = ReferenceCells::get_hypercube<dim>();
+
+    std::vector<std::int32_t> point_order(n_points_per_cell);
+    for (unsigned int i = 0; i < n_points_per_cell; ++i)
+      {
+        std::array<unsigned int, dim> point_indices;
+        std::array<unsigned int, dim> n_subdivisions_per_direction;
+        for (unsigned int d = 0, index = i; d < dim;
+             ++d, index /= (n_subdivisions + 1))
+          {
+            point_indices[d]                = index % (n_subdivisions + 1);
+            n_subdivisions_per_direction[d] = n_subdivisions;
+          }
+        const unsigned int vtk_index =
+          reference_cell.template vtk_lexicographic_to_node_index<dim>(
+            point_indices,
+            n_subdivisions_per_direction,
+            /* use VTU, not VTK: */ false);
+        point_order[vtk_index] = i;
+      }
+
+    std::vector<std::int32_t> connectivity;
+    connectivity.reserve(n_points);
+    for (unsigned int c = 0; c < n_cells; ++c)
+      for (const std::int32_t i : point_order)
+        connectivity.push_back(c * n_points_per_cell + i);
+
+    std::vector<std::int32_t> offsets(n_cells);
+    for (unsigned int c = 0; c < n_cells; ++c)
+      offsets[c] = (c + 1) * n_points_per_cell;
+
+    const std::vector<std::uint8_t> cell_types(
+      n_cells, static_cast<std::uint8_t>(reference_cell.vtk_lagrange_type()));
+
+    out << "  <Cells>\n";
+#ifdef DEAL_II_WITH_ZLIB
+    const bool write_binary =
+      (flags.compression_level != DataOutBase::CompressionLevel::plain_text);
+#else
+    const bool write_binary = false;
+#endif
+    if (write_binary)
+      DataOutBase::write_vtu_data_array(connectivity,
+                                        "type=\"Int32\" Name=\"connectivity\"",
+                                        flags,
+                                        out);
+    else
+      {
+        // Like write_vtu(), put the points of each cell on a separate line
+        out << "    <DataArray type=\"Int32\" Name=\"connectivity\" "
+               "format=\"ascii\">\n";
+        for (unsigned int c = 0; c < n_cells; ++c)
+          {
+            for (unsigned int i = 0; i < n_points_per_cell; ++i)
+              out << '\t' << connectivity[c * n_points_per_cell + i];
+            out << '\n';
+          }
+        out << "    </DataArray>\n";
+      }
+    DataOutBase::write_vtu_data_array(offsets,
+                                      "type=\"Int32\" Name=\"offsets\"",
+                                      flags,
+                                      out);
+    DataOutBase::write_vtu_data_array(cell_types,
+                                      "type=\"UInt8\" Name=\"types\"",
+                                      flags,
+                                      out);
+    out << "  </Cells>\n";
+  };
+
+  // Vector- and tensor-valued data sets are padded to three and nine
+  // components, respectively
+  const auto write_nonscalar_data_range = [&](const auto &range) {
+    const unsigned int first_data_set = std::get<0>(range);
+    const unsigned int last_data_set  = std::get<1>(range);
+    const bool         is_tensor =
+      (std::get<3>(range) ==
+       DataComponentInterpretation::component_is_part_of_tensor);
+    const unsigned int n_components     = last_data_set - first_data_set + 1;
+    const unsigned int n_vtk_components = (is_tensor ? 9 : 3);
+    AssertThrow(n_components <= n_vtk_components,
+                ExcMessage("Can't declare a vector with more than 3 or a "
+                           "tensor with more than 9 components in VTU "
+                           "format."));
+
+    std::vector<float> data(n_points * n_vtk_components, 0.f);
+    {
+      const std::vector<float> values =
+        evaluate_data_sets(first_data_set, last_data_set);
+      for (unsigned int p = 0; p < n_points; ++p)
+        for (unsigned int c = 0; c < n_components; ++c)
+          {
+            unsigned int vtk_component = c;
+            if (is_tensor && n_components == 4)
+              {
+                const auto indices =
+                  Tensor<2, 2>::unrolled_to_component_indices(c);
+                vtk_component = indices[0] * 3 + indices[1];
+              }
+            data[p * n_vtk_components + vtk_component] =
+              values[p * n_components + c];
+          }
+    }
+
+    std::string name = std::get<2>(range);
+    std::string units;
+    if (!name.empty())
+      {
+        units = units_attribute(name);
+        DataOutBase::quantize_vtu_data(data, name, flags);
+      }
+    else
+      {
+        for (unsigned int i = first_data_set; i < last_data_set; ++i)
+          name += data_names[i] + "__";
+        name += data_names[last_data_set];
+        units = units_attribute(data_names[first_data_set]);
+        DataOutBase::quantize_vtu_data(data,
+                                       data_names[first_data_set],
+                                       flags);
+      }
+
+    DataOutBase::write_vtu_data_array(
+      data,
+      "type=\"Float32\" Name=\"" + name + "\" NumberOfComponents=\"" +
+        std::to_string(n_vtk_components) + "\"" + units,
+      flags,
+      out);
+  };
+
+  const auto write_scalar_data_set = [&](const unsigned int data_set) {
+    std::vector<float> data = evaluate_data_sets(data_set, data_set);
+    DataOutBase::quantize_vtu_data(data, data_names[data_set], flags);
+    DataOutBase::write_vtu_data_array(data,
+                                      "type=\"Float32\" Name=\"" +
+                                        data_names[data_set] + "\"" +
+                                        units_attribute(data_names[data_set]),
+                                      flags,
+                                      out);
+  };
+
+  // Write the pieces of the file in the same order as
+  // DataOutBase::write_vtu() does. Each array is written to the stream as
+  // soon as it is computed and released before the next one is computed, so
+  // that at most one array is held in memory at any time
+  DataOutBase::write_vtu_header(out, flags);
+
+  // if desired, output time and cycle of the simulation
+  const bool write_cycle =
+    (flags.cycle != std::numeric_limits<unsigned int>::min());
+  const bool write_time = (flags.time != std::numeric_limits<double>::min());
+  if (write_cycle || write_time)
+    out << "<FieldData>\n";
+  if (write_cycle)
+    out << "<DataArray type=\"Float32\" Name=\"CYCLE\" NumberOfTuples=\"1\" "
+           "format=\"ascii\">"
+        << flags.cycle << "</DataArray>\n";
+  if (write_time)
+    out << "<DataArray type=\"Float32\" Name=\"TIME\" NumberOfTuples=\"1\" "
+           "format=\"ascii\">"
+        << flags.time << "</DataArray>\n";
+  if (write_cycle || write_time)
+    out << "</FieldData>\n";
+
+  out << "<Piece NumberOfPoints=\"" << n_points << "\" NumberOfCells=\""
+      << n_cells << "\" >\n";
+  write_vertex_information();
+  write_cell_information();
+
+  out << "  <PointData Scalars=\"scalars\">\n";
+  std::vector<bool> data_set_handled(data_names.size(), false);
+  for (const auto &range : this->get_nonscalar_data_ranges())
+    {
+      for (unsigned int i = std::get<0>(range); i <= std::get<1>(range); ++i)
+        data_set_handled[i] = true;
+      write_nonscalar_data_range(range);
+    }
+  for (unsigned int data_set = 0; data_set < data_names.size(); ++data_set)
+    if (data_set_handled[data_set] == false)
+      write_scalar_data_set(data_set);
+  out << "  </PointData>\n";
+  out << " </Piece>\n";
+
+  DataOutBase::write_vtu_footer(out);
+  out << std::flush;
+
+  AssertThrow(out.fail() == false, ExcIO());
 }
 
 
@@ -1279,6 +1777,8 @@ DataOut<dim, spacedim>::set_cell_selection(
 {
   first_cell_function = first_cell;
   next_cell_function  = next_cell;
+
+  clear_geometry_cache();
 }
 
 
@@ -1334,6 +1834,27 @@ DataOut<dim, spacedim>::get_cell_selection() const
 
 
 
+template <int dim, int spacedim>
+void
+DataOut<dim, spacedim>::set_geometry_caching(const bool cache_geometry)
+{
+  this->cache_geometry = cache_geometry;
+  if (cache_geometry == false)
+    clear_geometry_cache();
+}
+
+
+
+template <int dim, int spacedim>
+void
+DataOut<dim, spacedim>::clear_geometry_cache()
+{
+  cached_cells.clear();
+  cached_patches.clear();
+}
+
+
+
 // explicit instantiations
 #include "data_out.inst"
 
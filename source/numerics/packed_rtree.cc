@@ -0,0 +1,177 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+#include <deal.II/base/memory_consumption.h>
+
+#include <deal.II/numerics/packed_rtree.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+
+DEAL_II_NAMESPACE_OPEN
+
+
+namespace internal
+{
+  namespace PackedRTreeImplementation
+  {
+    /**
+     * Sort the box indices in the range [@p begin, @p end) by the
+     * coordinates of their @p centers in directions @p direction and higher,
+     * using the sort-tile-recursive algorithm: the range is sorted along
+     * the given direction and cut into slabs that each hold a whole number
+     * of nodes of size @p fanout, and each slab is then sorted recursively
+     * in the next coordinate direction. Consecutive groups of @p fanout
+     * entries in the resulting order cover compact, nearly non-overlapping
+     * regions.
+     */
+    template <int spacedim>
+    void
+    sort_tile_recursive(const std::vector<Point<spacedim>> &centers,
+                        const unsigned int                  fanout,
+                        const unsigned int                  direction,
+                        const std::vector<unsigned int>::iterator begin,
+                        const std::vector<unsigned int>::iterator end)
+    {
+      std::sort(begin, end, [&](const unsigned int a, const unsigned int b) {
+        return centers[a][direction] < centers[b][direction];
+      });
+
+      if (direction + 1 == spacedim)
+        return;
+
+      const std::size_t n_entries = end - begin;
+      const std::size_t n_nodes   = (n_entries + fanout - 1) / fanout;
+      const std::size_t n_slabs   = static_cast<std::size_t>(
+        std::ceil(std::pow(static_cast<double>(n_nodes),
+                           1. / (spacedim - direction)) -
+                  1e-10));
+      const std::size_t entries_per_slab =
+        (n_nodes + n_slabs - 1) / n_slabs * fanout;
+
+      for (std::size_t first = 0; first < n_entries; first += entries_per_slab)
+        sort_tile_recursive(centers,
+                            fanout,
+                            direction + 1,
+                            begin + first,
+                            begin + std::min(first + entries_per_slab,
+                                             n_entries));
+    }
+  } // namespace PackedRTreeImplementation
+} // namespace internal
+
+
+
+template <int spacedim>
+PackedRTree<spacedim>::PackedRTree(
+  const std::vector<BoundingBox<spacedim>> &boxes)
+{
+  reinit(boxes);
+}
+
+
+
+template <int spacedim>
+void
+PackedRTree<spacedim>::reinit(const std::vector<BoundingBox<spacedim>> &boxes)
+{
+  levels.clear();
+  leaf_indices.clear();
+
+  if (boxes.empty())
+    return;
+
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+
+  // Order the boxes so that each group of fanout consecutive leaves, i.e.,
+  // the children of one node, is spatially compact.
+  std::vector<Point<spacedim>> centers(boxes.size());
+  for (unsigned int i = 0; i < boxes.size(); ++i)
+    centers[i] = boxes[i].center();
+
+  leaf_indices.resize(boxes.size());
+  std::iota(leaf_indices.begin(), leaf_indices.end(), 0u);
+  internal::PackedRTreeImplementation::sort_tile_recursive(
+    centers, fanout, 0, leaf_indices.begin(), leaf_indices.end());
+
+  std::vector<BoundingBox<spacedim>> current_level(boxes.size());
+  for (unsigned int i = 0; i < boxes.size(); ++i)
+    current_level[i] = boxes[leaf_indices[i]];
+
+  // Build the levels from the leaves up to the root, which is the first
+  // level that fits into a single node.
+  while (true)
+    {
+      const unsigned int n_entries = current_level.size();
+      const unsigned int n_nodes   = (n_entries + fanout - 1) / fanout;
+
+      BoxBatch empty_batch;
+      for (unsigned int d = 0; d < spacedim; ++d)
+        {
+          empty_batch.lower[d] = std::numeric_limits<double>::max();
+          empty_batch.upper[d] = -std::numeric_limits<double>::max();
+        }
+
+      AlignedVector<BoxBatch> batches(n_nodes * fanout / n_lanes, empty_batch);
+      for (unsigned int i = 0; i < n_entries; ++i)
+        {
+          const auto &corners = current_level[i].get_boundary_points();
+          for (unsigned int d = 0; d < spacedim; ++d)
+            {
+              batches[i / n_lanes].lower[d][i % n_lanes] = corners.first[d];
+              batches[i / n_lanes].upper[d][i % n_lanes] = corners.second[d];
+            }
+        }
+      levels.emplace_back(std::move(batches));
+
+      if (n_nodes == 1)
+        break;
+
+      std::vector<BoundingBox<spacedim>> next_level;
+      next_level.reserve(n_nodes);
+      for (unsigned int n = 0; n < n_nodes; ++n)
+        {
+          BoundingBox<spacedim> node_box = current_level[n * fanout];
+          for (unsigned int i = n * fanout + 1;
+               i < std::min((n + 1) * fanout, n_entries);
+               ++i)
+            node_box.merge_with(current_level[i]);
+          next_level.push_back(node_box);
+        }
+      current_level.swap(next_level);
+    }
+}
+
+
+
+template <int spacedim>
+std::size_t
+PackedRTree<spacedim>::memory_consumption() const
+{
+  std::size_t memory = MemoryConsumption::memory_consumption(leaf_indices);
+  for (const auto &level : levels)
+    memory += sizeof(level) + level.capacity() * sizeof(BoxBatch);
+  return memory;
+}
+
+
+
+template class PackedRTree<1>;
+template class PackedRTree<2>;
+template class PackedRTree<3>;
+
+DEAL_II_NAMESPACE_CLOSE
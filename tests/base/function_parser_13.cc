@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// FunctionParser evaluates value_list(), vector_value_list() and
+// vector_value() for all points and components at once. Compare the results
+// of these functions and of Function::value_batch() on a Point with
+// VectorizedArray coordinates with the point-wise values of time-dependent
+// vector-valued functions in 2d and 3d. Print the sum of the values obtained
+// by each of them and the largest difference to the point-wise values.
+
+#include <deal.II/base/function_parser.h>
+#include <deal.II/base/point.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const std::string &expressions, const unsigned int n_components)
+{
+  std::map<std::string, double> constants;
+  constants["pi"] = numbers::PI;
+
+  FunctionParser<dim> function(n_components);
+  function.initialize(FunctionParser<dim>::default_variable_names() + ",t",
+                      expressions,
+                      constants,
+                      true);
+  function.set_time(0.5);
+  deallog << expressions << std::endl;
+
+  const unsigned int      n_points = 17;
+  std::vector<Point<dim>> points(n_points);
+  for (unsigned int q = 0; q < n_points; ++q)
+    points[q] = random_point<dim>();
+
+  // value_list() for each component
+  double sum = 0, error = 0;
+  for (unsigned int c = 0; c < n_components; ++c)
+    {
+      std::vector<double> values(n_points);
+      function.value_list(points, values, c);
+      for (unsigned int q = 0; q < n_points; ++q)
+        {
+          sum += values[q];
+          error =
+            std::max(error, std::abs(values[q] - function.value(points[q], c)));
+        }
+    }
+  deallog << "  value_list: sum " << sum << ", difference " << error
+          << std::endl;
+
+  // vector_value_list() and vector_value()
+  sum   = 0;
+  error = 0;
+  std::vector<Vector<double>> vector_values(n_points,
+                                            Vector<double>(n_components));
+  function.vector_value_list(points, vector_values);
+  for (unsigned int q = 0; q < n_points; ++q)
+    {
+      Vector<double> values(n_components);
+      function.vector_value(points[q], values);
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          const double value = function.value(points[q], c);
+          sum += vector_values[q][c];
+          error = std::max({error,
+                            std::abs(vector_values[q][c] - value),
+                            std::abs(values[c] - value)});
+        }
+    }
+  deallog << "  vector_value_list: sum " << sum << ", difference " << error
+          << std::endl;
+
+  // value_batch() on a batch of points. the number of points evaluated
+  // depends on the vector width, so only print the difference
+  error                          = 0;
+  constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+  for (unsigned int q = 0; q + n_lanes <= n_points; q += n_lanes)
+    {
+      Point<dim, VectorizedArray<double>> batch;
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        for (unsigned int d = 0; d < dim; ++d)
+          batch[d][v] = points[q + v][d];
+      for (unsigned int c = 0; c < n_components; ++c)
+        {
+          const VectorizedArray<double> values =
+            function.value_batch(batch, c);
+          for (unsigned int v = 0; v < n_lanes; ++v)
+            error = std::max(error,
+                             std::abs(values[v] -
+                                      function.value(points[q + v], c)));
+        }
+    }
+  deallog << "  vectorized value: difference " << error << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>("sin(pi*x)*cos(pi*y)+t; x^2-y*t; if(x>y, x, exp(y))", 3);
+  test<2>("x*y*t", 1);
+  test<3>("x+y+z; sqrt(x*x+y*y+z*z)*t", 2);
+}
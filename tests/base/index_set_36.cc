@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Add a large number of unsorted, fragmented indices with duplicates to an
+// IndexSet at once, which sorts them in parallel chunks, and then query the
+// uncompressed set from several tasks concurrently. Do this for sets that
+// are large enough to be sorted in several chunks and for a small one, and
+// with and without indices already in the set.
+
+#include <deal.II/base/index_set.h>
+#include <deal.II/base/thread_management.h>
+
+#include <algorithm>
+#include <random>
+
+#include "../tests.h"
+
+
+void
+test(const types::global_dof_index size, const bool add_range_first)
+{
+  // every third index, plus some short runs, in random order and with
+  // duplicates
+  std::vector<types::global_dof_index> indices;
+  for (types::global_dof_index i = 0; i < size; i += 3)
+    {
+      indices.push_back(i);
+      if (i % 99 == 0 && i + 1 < size)
+        indices.push_back(i + 1);
+      if (i % 7 == 0)
+        indices.push_back(i);
+    }
+  std::vector<bool> is_in_set(size, false);
+  for (const auto i : indices)
+    is_in_set[i] = true;
+  std::shuffle(indices.begin(), indices.end(), std::mt19937());
+
+  // add some indices before, so that the new ones need to be merged with
+  // existing ones
+  IndexSet index_set(size);
+  if (add_range_first)
+    {
+      index_set.add_range(10, 20);
+      for (types::global_dof_index i = 10; i < 20; ++i)
+        is_in_set[i] = true;
+    }
+
+  index_set.add_indices(indices.begin(), indices.end());
+
+  // the set is not compressed yet; query it from several tasks at the same
+  // time
+  Threads::TaskGroup<unsigned int> tasks;
+  for (unsigned int t = 0; t < 4; ++t)
+    tasks += Threads::new_task([&]() {
+      unsigned int            n_errors = 0;
+      types::global_dof_index n        = 0;
+      for (types::global_dof_index i = 0; i < size; ++i)
+        if (is_in_set[i])
+          {
+            if (index_set.is_element(i) == false ||
+                index_set.index_within_set(i) != n ||
+                index_set.nth_index_in_set(n) != i)
+              ++n_errors;
+            ++n;
+          }
+        else if (index_set.is_element(i) == true)
+          ++n_errors;
+      if (n != index_set.n_elements())
+        ++n_errors;
+      return n_errors;
+    });
+
+  unsigned int n_errors = 0;
+  for (const unsigned int task_errors : tasks.return_values())
+    n_errors += task_errors;
+
+  deallog << "size=" << size << " n_elements=" << index_set.n_elements()
+          << " n_intervals=" << index_set.n_intervals()
+          << " n_errors=" << n_errors << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(300000, true);
+  test(300000, false);
+  test(1000, true);
+}
@@ -0,0 +1,122 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+// Check that PackedRTree returns the same boxes as a boost R-tree built with
+// pack_rtree_of_indices() for point and box intersection queries, for
+// numbers of boxes around and well above the fanout of the tree and for
+// both small and degenerate (flat) boxes. Print the total number of boxes
+// found by the queries and the number of queries whose results differ.
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/point.h>
+
+#include <deal.II/numerics/packed_rtree.h>
+#include <deal.II/numerics/rtree.h>
+
+#include <algorithm>
+
+#include "../tests.h"
+
+namespace bgi = boost::geometry::index;
+
+
+template <int dim>
+BoundingBox<dim>
+small_random_box(const double max_size, const bool flat = false)
+{
+  const Point<dim> lower = random_point<dim>();
+  Point<dim>       upper;
+  for (unsigned int d = 0; d < dim; ++d)
+    upper[d] = lower[d] + max_size * random_value<double>();
+  if (flat)
+    upper[dim - 1] = lower[dim - 1];
+  return BoundingBox<dim>(std::make_pair(lower, upper));
+}
+
+
+
+template <int dim>
+void
+test(const unsigned int n_boxes, const bool flat)
+{
+  std::vector<BoundingBox<dim>> boxes;
+  for (unsigned int i = 0; i < n_boxes; ++i)
+    boxes.push_back(small_random_box<dim>(0.2, flat));
+
+  const PackedRTree<dim> tree(boxes);
+  const auto             boost_tree = pack_rtree_of_indices(boxes);
+
+  AssertDimension(tree.size(), n_boxes);
+
+  unsigned int n_point_hits       = 0;
+  unsigned int n_box_hits         = 0;
+  unsigned int n_point_mismatches = 0;
+  unsigned int n_box_mismatches   = 0;
+  for (unsigned int q = 0; q < 200; ++q)
+    {
+      const Point<dim> p = random_point<dim>();
+
+      std::vector<unsigned int> indices, boost_indices;
+      tree.query(p, std::back_inserter(indices));
+      boost_tree.query(bgi::intersects(p), std::back_inserter(boost_indices));
+      std::sort(indices.begin(), indices.end());
+      std::sort(boost_indices.begin(), boost_indices.end());
+      n_point_hits += indices.size();
+      if (indices != boost_indices)
+        ++n_point_mismatches;
+
+      const BoundingBox<dim> box = small_random_box<dim>(0.1);
+
+      indices.clear();
+      boost_indices.clear();
+      tree.query(box, std::back_inserter(indices));
+      boost_tree.query(bgi::intersects(box),
+                       std::back_inserter(boost_indices));
+      std::sort(indices.begin(), indices.end());
+      std::sort(boost_indices.begin(), boost_indices.end());
+      n_box_hits += indices.size();
+      if (indices != boost_indices)
+        ++n_box_mismatches;
+    }
+
+  deallog << "dim " << dim << ", " << n_boxes << (flat ? " flat" : "")
+          << " boxes: point queries found " << n_point_hits << " with "
+          << n_point_mismatches << " mismatches, box queries found "
+          << n_box_hits << " with " << n_box_mismatches << " mismatches"
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (const unsigned int n_boxes : {0u, 1u, 7u, 8u, 9u, 100u, 2000u})
+    {
+      test<1>(n_boxes, false);
+      test<2>(n_boxes, false);
+      test<3>(n_boxes, false);
+    }
+
+  // boxes with zero extent in the last direction. in 1d, these are points
+  for (const unsigned int n_boxes : {9u, 2000u})
+    {
+      test<1>(n_boxes, true);
+      test<2>(n_boxes, true);
+      test<3>(n_boxes, true);
+    }
+}
@@ -0,0 +1,161 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DataOutBackgroundWriter writes the same files as
+// DataOutInterface::write_vtu_with_pvtu_record(), even if the DataOut object
+// is changed while the files are still being written. The patches are moved
+// out of the DataOut object. Errors are reported by wait().
+
+
+#include <deal.II/base/data_out_base.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+std::string
+read_file(const std::string &filename)
+{
+  std::ifstream     in(filename);
+  std::stringstream content;
+  content << in.rdbuf();
+  return content.str();
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const unsigned int n_steps = 4;
+
+  DataOutBackgroundWriter<dim> writer(2);
+  std::vector<std::string>     expected_vtu(n_steps);
+  std::vector<std::string>     expected_pvtu(n_steps);
+  Vector<double>               solution(dof_handler.n_dofs());
+  for (unsigned int step = 0; step < n_steps; ++step)
+    {
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + random_value<double>();
+
+      DataOutBase::VtkFlags flags;
+      flags.print_date_and_time = false;
+      DataOut<dim> data_out;
+      data_out.set_flags(flags);
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(solution, "solution");
+      data_out.build_patches(2);
+
+      // write the expected output with the synchronous functions
+      std::ostringstream vtu;
+      data_out.write_vtu(vtu);
+      expected_vtu[step] = vtu.str();
+      std::ostringstream pvtu;
+      data_out.write_pvtu_record(
+        pvtu, {"output_" + std::to_string(dim) + "d_" + std::to_string(step) +
+               ".0.vtu"});
+      expected_pvtu[step] = pvtu.str();
+
+      const std::string pvtu_filename =
+        writer.write_vtu_with_pvtu_record(data_out,
+                                          "./",
+                                          "output_" + std::to_string(dim) +
+                                            "d",
+                                          step,
+                                          MPI_COMM_WORLD,
+                                          1);
+      deallog << "Started writing " << pvtu_filename << ", "
+              << writer.n_pending_writes() << " writes pending, "
+              << data_out.get_patches().size() << " patches left"
+              << std::endl;
+
+      // change the data before the output is necessarily written
+      data_out.clear();
+      solution = 0;
+    }
+  writer.wait();
+  deallog << "After wait(): " << writer.n_pending_writes()
+          << " writes pending" << std::endl;
+
+  for (unsigned int step = 0; step < n_steps; ++step)
+    {
+      const std::string base =
+        "output_" + std::to_string(dim) + "d_" + std::to_string(step);
+      deallog << "Step " << step << ": "
+              << (read_file(base + ".0.vtu") == expected_vtu[step] &&
+                      read_file(base + ".pvtu") == expected_pvtu[step] ?
+                    "OK" :
+                    "FAILED")
+              << std::endl;
+    }
+
+  // writing into a directory that does not exist fails, and wait() reports
+  // the error
+  DataOut<dim> data_out;
+  data_out.attach_dof_handler(dof_handler);
+  data_out.add_data_vector(solution, "solution");
+  data_out.build_patches();
+  writer.write_vtu_with_pvtu_record(
+    data_out, "./does_not_exist/", "output", 0, MPI_COMM_WORLD, 1);
+  try
+    {
+      writer.wait();
+      deallog << "No exception" << std::endl;
+    }
+  catch (const ExceptionBase &)
+    {
+      deallog << "Exception caught, " << writer.n_pending_writes()
+              << " writes pending" << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,150 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Compressed VTU output splits data arrays larger than one megabyte into
+// several blocks that are compressed independently. Write a patch with many
+// subdivisions, decode the compression headers, and check that the blocks
+// decompress to the sizes given in the headers and to the expected point
+// coordinates.
+
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/utilities.h>
+
+#include <zlib.h>
+
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+// decode one line of compressed binary data and return the uncompressed data
+std::vector<unsigned char>
+decode_array(const std::string &line)
+{
+  // the header is encoded separately from the data. start by decoding the
+  // number of blocks to find out the length of the header
+  const std::vector<unsigned char> first_chunk =
+    Utilities::decode_base64(line.substr(0, 8));
+  std::uint32_t n_blocks;
+  std::memcpy(&n_blocks, first_chunk.data(), sizeof(std::uint32_t));
+
+  const unsigned int header_bytes = (3 + n_blocks) * sizeof(std::uint32_t);
+  const unsigned int header_chars = 4 * ((header_bytes + 2) / 3);
+
+  const std::vector<unsigned char> header_data =
+    Utilities::decode_base64(line.substr(0, header_chars));
+  std::vector<std::uint32_t> header(3 + n_blocks);
+  std::memcpy(header.data(), header_data.data(), header_bytes);
+
+  const std::vector<unsigned char> compressed_data =
+    Utilities::decode_base64(line.substr(header_chars));
+
+  std::vector<unsigned char> data;
+  std::size_t                position = 0;
+  for (unsigned int block = 0; block < n_blocks; ++block)
+    {
+      uLongf block_size = (block == n_blocks - 1 ? header[2] : header[1]);
+      std::vector<unsigned char> uncompressed(block_size);
+      const int                  err = uncompress(
+        uncompressed.data(),
+        &block_size,
+        reinterpret_cast<const Bytef *>(compressed_data.data()) + position,
+        header[3 + block]);
+      AssertThrow(err == Z_OK, ExcInternalError());
+      AssertThrow(block_size == uncompressed.size(), ExcInternalError());
+      position += header[3 + block];
+      data.insert(data.end(), uncompressed.begin(), uncompressed.end());
+    }
+  AssertThrow(position == compressed_data.size(), ExcInternalError());
+
+  deallog << "array with " << n_blocks << " blocks, " << data.size()
+          << " bytes" << std::endl;
+  return data;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  const unsigned int n_subdivisions = 400;
+  const unsigned int n_points_1d    = n_subdivisions + 1;
+
+  std::vector<DataOutBase::Patch<2, 2>> patches(1);
+  patches[0].vertices[0]    = Point<2>(0, 0);
+  patches[0].vertices[1]    = Point<2>(1, 0);
+  patches[0].vertices[2]    = Point<2>(0, 1);
+  patches[0].vertices[3]    = Point<2>(1, 1);
+  patches[0].n_subdivisions = n_subdivisions;
+  patches[0].reference_cell = ReferenceCells::get_hypercube<2>();
+  patches[0].data.reinit(1, n_points_1d * n_points_1d);
+  for (unsigned int i = 0; i < n_points_1d * n_points_1d; ++i)
+    patches[0].data(0, i) = i;
+
+  const std::vector<std::string> names(1, "data");
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+                        vectors;
+  DataOutBase::VtkFlags flags;
+  flags.compression_level = DataOutBase::CompressionLevel::best_speed;
+
+  std::stringstream out;
+  DataOutBase::write_vtu(patches, names, vectors, flags, out);
+
+  std::string line;
+  bool        next_line_is_data = false;
+  bool        first_array       = true;
+  while (std::getline(out, line))
+    {
+      if (next_line_is_data)
+        {
+          const std::vector<unsigned char> data = decode_array(line);
+
+          // the first array holds the point coordinates with three float
+          // components each
+          if (first_array)
+            {
+              std::vector<float> coordinates(data.size() / sizeof(float));
+              std::memcpy(coordinates.data(), data.data(), data.size());
+              bool ok = true;
+              for (unsigned int j = 0; j < n_points_1d; ++j)
+                for (unsigned int i = 0; i < n_points_1d; ++i)
+                  {
+                    const unsigned int p = j * n_points_1d + i;
+                    if (std::abs(coordinates[3 * p] -
+                                 float(i) / n_subdivisions) > 1e-6 ||
+                        std::abs(coordinates[3 * p + 1] -
+                                 float(j) / n_subdivisions) > 1e-6 ||
+                        coordinates[3 * p + 2] != 0.f)
+                      ok = false;
+                  }
+              deallog << "coordinates " << (ok ? "OK" : "FAILED")
+                      << std::endl;
+              first_array = false;
+            }
+        }
+      next_line_is_data = (line.find("<DataArray") != std::string::npos);
+    }
+}
@@ -0,0 +1,181 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check the lossy options of DataOutBase::VtkFlags for VTU output: rounding
+// to a number of significant bits, quantization with an absolute tolerance
+// for one field, and the reduction of the number of subdivisions of patches
+// whose data is (bi)linear.
+
+
+#include <deal.II/base/data_out_base.h>
+
+#include <cmath>
+#include <cstring>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "../tests.h"
+
+
+// write the patches in ascii format with enough digits to read the Float32
+// values back exactly
+std::string
+write(const std::vector<DataOutBase::Patch<2, 2>> &patches,
+      const DataOutBase::VtkFlags                 &flags)
+{
+  const std::vector<std::string> names = {"a", "b"};
+  const std::vector<
+    std::tuple<unsigned int,
+               unsigned int,
+               std::string,
+               DataComponentInterpretation::DataComponentInterpretation>>
+    vectors;
+
+  std::ostringstream out;
+  out.precision(9);
+  DataOutBase::write_vtu(patches, names, vectors, flags, out);
+  return out.str();
+}
+
+
+
+// return the values of the data array with the given name
+std::vector<float>
+read_data_array(const std::string &vtu, const std::string &name)
+{
+  const std::size_t tag = vtu.find("Name=\"" + name + "\"");
+  AssertThrow(tag != std::string::npos, ExcInternalError());
+  const std::size_t begin = vtu.find('\n', tag) + 1;
+  const std::size_t end   = vtu.find('\n', begin);
+
+  std::istringstream in(vtu.substr(begin, end - begin));
+  std::vector<float> values;
+  float              value;
+  while (in >> value)
+    values.push_back(value);
+  return values;
+}
+
+
+
+// return the line that contains the numbers of points and cells
+std::string
+piece_line(const std::string &vtu)
+{
+  const std::size_t begin = vtu.find("<Piece");
+  return vtu.substr(begin, vtu.find('\n', begin) - begin);
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  // two patches with 4x4 subdivisions. the data of the first one is
+  // bilinear, the second field of the second one is not
+  std::vector<DataOutBase::Patch<2, 2>> patches(2);
+  for (unsigned int p = 0; p < 2; ++p)
+    {
+      patches[p].vertices[0]    = Point<2>(p, 0);
+      patches[p].vertices[1]    = Point<2>(p + 1, 0);
+      patches[p].vertices[2]    = Point<2>(p, 1);
+      patches[p].vertices[3]    = Point<2>(p + 1, 1);
+      patches[p].n_subdivisions = 4;
+      patches[p].reference_cell = ReferenceCells::get_hypercube<2>();
+      patches[p].patch_index    = p;
+      patches[p].data.reinit(2, 25);
+      for (unsigned int j = 0; j < 5; ++j)
+        for (unsigned int i = 0; i < 5; ++i)
+          {
+            const double x = p + 0.25 * i;
+            const double y = 0.25 * j;
+
+            patches[p].data(0, j * 5 + i) = 1 + x + 2 * y;
+            patches[p].data(1, j * 5 + i) =
+              (p == 0 ? 5. : std::sin(3 * x) * y * y + 1);
+          }
+    }
+
+  DataOutBase::VtkFlags flags;
+  flags.compression_level = DataOutBase::CompressionLevel::plain_text;
+
+  const std::string  reference = write(patches, flags);
+  std::vector<float> a         = read_data_array(reference, "a");
+  std::vector<float> b         = read_data_array(reference, "b");
+  std::vector<float> values    = a;
+  values.insert(values.end(), b.begin(), b.end());
+
+  // round all values to 11 significant bits
+  {
+    DataOutBase::VtkFlags lossy_flags = flags;
+    lossy_flags.n_significant_bits    = 11;
+
+    const std::string  vtu = write(patches, lossy_flags);
+    std::vector<float> lossy_values = read_data_array(vtu, "a");
+    const std::vector<float> lossy_b = read_data_array(vtu, "b");
+    lossy_values.insert(lossy_values.end(), lossy_b.begin(), lossy_b.end());
+
+    bool ok = (lossy_values.size() == values.size());
+    for (unsigned int i = 0; i < values.size() && ok; ++i)
+      {
+        std::uint32_t bits;
+        std::memcpy(&bits, &lossy_values[i], sizeof(float));
+        if (std::abs(lossy_values[i] - values[i]) >
+              std::ldexp(std::abs(values[i]), -11) ||
+            (bits & ((1u << 13) - 1)) != 0)
+          ok = false;
+      }
+    deallog << "11 significant bits: " << (ok ? "OK" : "FAILED")
+            << std::endl;
+  }
+
+  // quantize only the second field with a tolerance of 1e-3, i.e., to
+  // multiples of 2^-9
+  {
+    DataOutBase::VtkFlags lossy_flags       = flags;
+    lossy_flags.quantization_tolerances["b"] = 1e-3;
+
+    const std::string        vtu     = write(patches, lossy_flags);
+    const std::vector<float> lossy_a = read_data_array(vtu, "a");
+    const std::vector<float> lossy_b = read_data_array(vtu, "b");
+
+    bool ok = (lossy_a == a) && (lossy_b.size() == b.size());
+    for (unsigned int i = 0; i < b.size() && ok; ++i)
+      if (std::abs(lossy_b[i] - b[i]) > 1e-3 ||
+          std::ldexp(lossy_b[i], 9) != std::round(std::ldexp(lossy_b[i], 9)))
+        ok = false;
+    deallog << "quantization of b: " << (ok ? "OK" : "FAILED") << std::endl;
+  }
+
+  // write the first patch without subdivisions since its data is bilinear
+  {
+    DataOutBase::VtkFlags lossy_flags = flags;
+    lossy_flags.subdivision_tolerance = 1e-6;
+
+    const std::string vtu = write(patches, lossy_flags);
+    deallog << piece_line(reference) << std::endl;
+    deallog << piece_line(vtu) << std::endl;
+
+    const std::vector<float> lossy_a = read_data_array(vtu, "a");
+    deallog << "values of a on the first patch:";
+    for (unsigned int i = 0; i < 4; ++i)
+      deallog << ' ' << lossy_a[i];
+    deallog << std::endl;
+  }
+}
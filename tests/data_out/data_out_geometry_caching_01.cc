@@ -0,0 +1,134 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DataOut::set_geometry_caching(): reuse one DataOut object with cached
+// geometry for several time steps, with curved cells and changing data
+// vectors, and check that the VTU output is the same as the one of a new
+// DataOut object in every step, also after the mesh has been refined or
+// moved. Print the number of cells and DoFs and the number of lines of the
+// output in every step.
+
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+template <int dim>
+std::string
+write_vtu(const DataOut<dim> &data_out)
+{
+  std::ostringstream out;
+  data_out.write_vtu(out);
+  return out.str();
+}
+
+
+
+template <int dim>
+void
+test(const DataOutBase::CompressionLevel compression_level,
+     const unsigned int                  n_subdivisions)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  const FE_Q<dim>     fe(2);
+  DoFHandler<dim>     dof_handler(tria);
+  const MappingQ<dim> mapping(2);
+
+  DataOutBase::VtkFlags flags;
+  flags.compression_level   = compression_level;
+  flags.print_date_and_time = false;
+
+  DataOut<dim> cached_data_out;
+  cached_data_out.set_geometry_caching(true);
+  cached_data_out.set_flags(flags);
+  cached_data_out.attach_dof_handler(dof_handler);
+
+  for (unsigned int step = 0; step < 6; ++step)
+    {
+      if (step == 3)
+        tria.refine_global(1);
+      if (step == 5)
+        GridTools::scale(2., tria);
+      dof_handler.distribute_dofs(fe);
+
+      Vector<double> solution(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + 0.1 * i;
+      Vector<float> cell_data(tria.n_active_cells());
+      for (unsigned int i = 0; i < cell_data.size(); ++i)
+        cell_data(i) = step * i;
+
+      cached_data_out.clear_data_vectors();
+      cached_data_out.add_data_vector(solution, "solution");
+      if (step % 2 == 1)
+        cached_data_out.add_data_vector(cell_data, "cell_data");
+      cached_data_out.build_patches(mapping, n_subdivisions);
+
+      DataOut<dim> data_out;
+      data_out.set_flags(flags);
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(solution, "solution");
+      if (step % 2 == 1)
+        data_out.add_data_vector(cell_data, "cell_data");
+      data_out.build_patches(mapping, n_subdivisions);
+
+      // write the cached output twice to also check the reuse of the
+      // encoded mesh of the previous output
+      const std::string reference = write_vtu(data_out);
+      const std::string first     = write_vtu(cached_data_out);
+      const std::string second    = write_vtu(cached_data_out);
+      deallog << "dim " << dim << ", step " << step << ": "
+              << tria.n_active_cells() << " cells, " << dof_handler.n_dofs()
+              << " DoFs, " << std::count(first.begin(), first.end(), '\n')
+              << " lines, "
+              << (first == reference && second == reference ?
+                    "same as new DataOut" :
+                    "different from new DataOut")
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(DataOutBase::CompressionLevel::plain_text, 3);
+  test<2>(DataOutBase::CompressionLevel::best_speed, 2);
+  test<3>(DataOutBase::CompressionLevel::best_speed, 3);
+  test<3>(DataOutBase::CompressionLevel::plain_text, 1);
+}
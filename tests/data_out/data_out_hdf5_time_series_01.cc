@@ -0,0 +1,120 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Write several time steps into one HDF5 file with DataOutHDF5TimeSeries.
+// The mesh is only written again once it has been refined, and all time
+// steps are listed in one XDMF file. Each process owns a slab of the mesh,
+// so the numbers of nodes and cells in the XDMF file are the sums over all
+// processes.
+
+
+#include <deal.II/base/data_out_base.h>
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/shared_tria.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <string>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+partition_into_slabs(parallel::shared::Triangulation<dim> &tria)
+{
+  const unsigned int n_ranks = Utilities::MPI::n_mpi_processes(MPI_COMM_WORLD);
+  for (const auto &cell : tria.active_cell_iterators())
+    cell->set_subdomain_id(std::min(
+      static_cast<unsigned int>(cell->center()[dim - 1] * n_ranks),
+      n_ranks - 1));
+}
+
+
+
+template <int dim>
+void
+check()
+{
+  parallel::shared::Triangulation<dim> tria(
+    MPI_COMM_WORLD,
+    Triangulation<dim>::none,
+    false,
+    parallel::shared::Triangulation<dim>::partition_custom_signal);
+  tria.signals.post_refinement.connect(
+    [&tria]() { partition_into_slabs(tria); });
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+
+  const FE_Q<dim> fe(1);
+  DoFHandler<dim> dof_handler(tria);
+
+  const std::string basename = "time_series_" + std::to_string(dim);
+  DataOutHDF5TimeSeries<dim> time_series(basename + ".h5",
+                                         basename + ".xdmf",
+                                         MPI_COMM_WORLD);
+
+  for (unsigned int step = 0; step < 4; ++step)
+    {
+      if (step == 3)
+        tria.refine_global(1);
+      dof_handler.distribute_dofs(fe);
+
+      Vector<double> solution(dof_handler.n_dofs());
+      for (unsigned int i = 0; i < solution.size(); ++i)
+        solution(i) = step + i;
+
+      DataOut<dim> data_out;
+      data_out.attach_dof_handler(dof_handler);
+      data_out.add_data_vector(solution, "solution");
+      data_out.build_patches();
+
+      time_series.write_time_step(data_out, 0.1 * step);
+      deallog << "time steps: " << time_series.n_time_steps()
+              << ", meshes: " << time_series.n_meshes()
+              << ", locally owned cells: "
+              << tria.n_locally_owned_active_cells() << std::endl;
+    }
+
+  if (Utilities::MPI::this_mpi_process(MPI_COMM_WORLD) == 0)
+    {
+      cat_file((basename + ".xdmf").c_str());
+      std::ifstream f(basename + ".h5");
+      AssertThrow(f.good(), ExcIO());
+    }
+}
+
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  check<2>();
+  check<3>();
+}
@@ -0,0 +1,137 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DataOut::write_vtu_higher_order() writes the same file as
+// DataOut::build_patches() with curved inner cells followed by
+// DataOut::write_vtu() with higher-order cells, for scalar and vector-valued
+// data on FE_Q and FE_DGQ elements and for cell data, with the points
+// computed by a MappingQCache. Also check the uncompressed format and the
+// lossy options of VtkFlags, and print the number of lines of the files.
+
+
+#include <deal.II/base/data_out_base.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+#include <deal.II/fe/mapping_q_cache.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/data_out.h>
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim>    &scalar_fe,
+     const unsigned int           n_subdivisions,
+     const DataOutBase::VtkFlags &base_flags,
+     const std::string           &description)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  MappingQCache<dim> mapping(3);
+  mapping.initialize(MappingQ<dim>(3), tria);
+
+  DoFHandler<dim> scalar_dof_handler(tria);
+  scalar_dof_handler.distribute_dofs(scalar_fe);
+  Vector<double> scalar_solution(scalar_dof_handler.n_dofs());
+  for (unsigned int i = 0; i < scalar_solution.size(); ++i)
+    scalar_solution(i) = random_value<double>();
+
+  const FESystem<dim> vector_fe(FE_Q<dim>(2), dim);
+  DoFHandler<dim>     vector_dof_handler(tria);
+  vector_dof_handler.distribute_dofs(vector_fe);
+  Vector<double> vector_solution(vector_dof_handler.n_dofs());
+  for (unsigned int i = 0; i < vector_solution.size(); ++i)
+    vector_solution(i) = random_value<double>();
+
+  Vector<float> cell_data(tria.n_active_cells());
+  for (unsigned int i = 0; i < cell_data.size(); ++i)
+    cell_data(i) = i;
+
+  DataOut<dim> data_out;
+  data_out.add_data_vector(scalar_dof_handler, scalar_solution, "scalar");
+  data_out.add_data_vector(
+    vector_dof_handler,
+    vector_solution,
+    std::vector<std::string>(dim, "velocity"),
+    std::vector<DataComponentInterpretation::DataComponentInterpretation>(
+      dim, DataComponentInterpretation::component_is_part_of_vector));
+  data_out.add_data_vector(cell_data, "cell_data");
+
+  DataOutBase::VtkFlags flags = base_flags;
+  flags.print_date_and_time   = false;
+  flags.time                  = 0.5;
+  data_out.set_flags(flags);
+
+  std::ostringstream direct;
+  data_out.write_vtu_higher_order(direct, mapping, n_subdivisions);
+
+  flags.write_higher_order_cells = true;
+  data_out.set_flags(flags);
+  data_out.build_patches(mapping,
+                         n_subdivisions,
+                         DataOut<dim>::curved_inner_cells);
+  std::ostringstream with_patches;
+  data_out.write_vtu(with_patches);
+
+  const std::string file = direct.str();
+  deallog << scalar_fe.get_name() << " with " << n_subdivisions
+          << " subdivisions, " << description << ": "
+          << std::count(file.begin(), file.end(), '\n') << " lines, "
+          << (file == with_patches.str() ? "same as write_vtu()" :
+                                           "different from write_vtu()")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  DataOutBase::VtkFlags compressed;
+  DataOutBase::VtkFlags plain_text;
+  plain_text.compression_level = DataOutBase::CompressionLevel::plain_text;
+  DataOutBase::VtkFlags significant_bits;
+  significant_bits.n_significant_bits = 10;
+  DataOutBase::VtkFlags tolerance;
+  tolerance.quantization_tolerances["scalar"] = 0.1;
+
+  test<2>(FE_Q<2>(3), 3, compressed, "compressed");
+  test<2>(FE_DGQ<2>(4), 4, plain_text, "plain text");
+  test<2>(FE_Q<2>(2), 5, significant_bits, "10 significant bits");
+  test<2>(FE_Q<2>(2), 2, tolerance, "tolerance 0.1 for scalar");
+  test<3>(FE_Q<3>(2), 2, compressed, "compressed");
+  test<3>(FE_DGQ<3>(3), 3, plain_text, "plain text");
+  test<3>(FE_DGQ<3>(2), 2, significant_bits, "10 significant bits");
+}
@@ -0,0 +1,128 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// DoFHandler::distribute_dofs() and distribute_mg_dofs() enumerate the DoFs
+// on many cells concurrently. Check that the result is still the numbering
+// of a sequential loop over the cells, i.e., that the DoF indices appear in
+// increasing order the first time they are encountered, on adaptively
+// refined meshes that are large enough to be split into several tasks.
+// Print the number of DoFs on the active mesh and on each level.
+
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <typename IteratorRange>
+bool
+is_sequential_numbering(const IteratorRange          &cells,
+                        const types::global_dof_index n_dofs,
+                        const unsigned int            dofs_per_cell,
+                        const bool                    level_dofs)
+{
+  std::vector<bool>                    touched(n_dofs, false);
+  std::vector<types::global_dof_index> dof_indices(dofs_per_cell);
+  types::global_dof_index              next_dof = 0;
+
+  for (const auto &cell : cells)
+    {
+      if (level_dofs)
+        cell->get_mg_dof_indices(dof_indices);
+      else
+        cell->get_dof_indices(dof_indices);
+
+      for (const auto i : dof_indices)
+        if (touched[i] == false)
+          {
+            if (i != next_dof)
+              return false;
+            touched[i] = true;
+            ++next_dof;
+          }
+    }
+
+  return next_dof == n_dofs;
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(dim == 2 ? 4 : 2);
+
+  unsigned int index = 0;
+  for (const auto &cell : tria.active_cell_iterators())
+    if (index++ % 7 == 0)
+      cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  dof_handler.distribute_mg_dofs();
+
+  deallog << fe.get_name() << ", " << tria.n_active_cells() << " cells"
+          << std::endl;
+  deallog << "  active: " << dof_handler.n_dofs() << " DoFs, "
+          << (is_sequential_numbering(dof_handler.active_cell_iterators(),
+                                      dof_handler.n_dofs(),
+                                      fe.n_dofs_per_cell(),
+                                      false) ?
+                "numbered in cell order" :
+                "not numbered in cell order")
+          << std::endl;
+  for (unsigned int level = 0; level < tria.n_levels(); ++level)
+    deallog << "  level " << level << ": " << dof_handler.n_dofs(level)
+            << " DoFs, "
+            << (is_sequential_numbering(
+                  dof_handler.mg_cell_iterators_on_level(level),
+                  dof_handler.n_dofs(level),
+                  fe.n_dofs_per_cell(),
+                  true) ?
+                  "numbered in cell order" :
+                  "not numbered in cell order")
+            << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_Q<2>(1));
+  test<2>(FE_Q<2>(3));
+  test<2>(FE_DGQ<2>(2));
+  test<2>(FESystem<2>(FE_Q<2>(2), 2));
+  test<3>(FE_Q<3>(1));
+  test<3>(FE_Q<3>(3));
+  test<3>(FESystem<3>(FE_Q<3>(2), 3));
+  test<3>(FESystem<3>(FE_Q<3>(2), 1, FE_Q<3>(1), 1));
+}
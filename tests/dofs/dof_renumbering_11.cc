@@ -0,0 +1,87 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Check DoFRenumbering::compute_nested_dissection() and
+// DoFRenumbering::nested_dissection(): the new indices need to be a
+// permutation, and renumbering must not change the number of couplings
+// between DoFs. Print the number of DoFs and of couplings before and after
+// renumbering for linear and quadratic elements.
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+
+#include <algorithm>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_shell(tria, Point<dim>(), 0.5, 1.);
+  tria.refine_global(dim == 2 ? 3 : 1);
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  DynamicSparsityPattern dsp_before(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp_before);
+
+  std::vector<types::global_dof_index> new_indices(dof_handler.n_dofs());
+  DoFRenumbering::compute_nested_dissection(new_indices, dof_handler);
+
+  std::vector<types::global_dof_index> sorted_indices = new_indices;
+  std::sort(sorted_indices.begin(), sorted_indices.end());
+  bool is_permutation = true;
+  for (types::global_dof_index i = 0; i < sorted_indices.size(); ++i)
+    if (sorted_indices[i] != i)
+      is_permutation = false;
+
+  DoFRenumbering::nested_dissection(dof_handler);
+
+  DynamicSparsityPattern dsp_after(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp_after);
+
+  deallog << fe.get_name() << ": " << dof_handler.n_dofs() << " DoFs, "
+          << (is_permutation ? "permutation" : "no permutation") << std::endl;
+  deallog << "  couplings before: " << dsp_before.n_nonzero_elements()
+          << ", after: " << dsp_after.n_nonzero_elements() << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(1);
+  test<2>(2);
+  test<3>(1);
+  test<3>(2);
+}
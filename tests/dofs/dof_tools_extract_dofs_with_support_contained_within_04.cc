@@ -159,7 +159,7 @@ test()
         auto       local_vector_begin  = local_rhs.begin();
         const auto local_vector_end    = local_rhs.end();
         auto       local_indices_begin = local_dof_indices.begin();
-        const std::vector<std::pair<types::global_dof_index, double>> *line_ptr;
+        const AffineConstraints<double>::ConstraintLine::Entries *line_ptr;
         for (; local_vector_begin != local_vector_end;
              ++local_vector_begin, ++local_indices_begin)
           {
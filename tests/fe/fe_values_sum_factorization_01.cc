@@ -0,0 +1,141 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// FEValues::get_function_values() and get_function_gradients() evaluate
+// FE_Q and FE_DGQ functions of high degree with sum factorization. Compare
+// the results, also those obtained through FEValuesViews::Scalar and for
+// vectors of floats, to the sums over the shape functions on affine and
+// distorted meshes. Print the integrals of the function and of the square
+// of its gradient.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe,
+     const unsigned int        n_q_points_1d,
+     const bool                distorted)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(1);
+  if (distorted)
+    GridTools::distort_random(0.2, tria, false);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  Vector<double> solution(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < solution.size(); ++i)
+    solution(i) = random_value<double>();
+  Vector<float> solution_float(solution);
+
+  const MappingQ<dim> mapping(distorted ? 2 : 1);
+  const QGauss<dim>   quadrature(n_q_points_1d);
+  FEValues<dim>       fe_values(mapping,
+                                fe,
+                                quadrature,
+                                update_values | update_gradients |
+                                  update_JxW_values);
+
+  const FEValuesExtractors::Scalar     scalar(0);
+  std::vector<double>                  values(quadrature.size());
+  std::vector<Tensor<1, dim>>          gradients(quadrature.size());
+  std::vector<double>                  view_values(quadrature.size());
+  std::vector<Tensor<1, dim>>          view_gradients(quadrature.size());
+  std::vector<float>                   float_values(quadrature.size());
+  std::vector<Tensor<1, dim, float>>   float_gradients(quadrature.size());
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+
+  double error = 0, float_error = 0;
+  double integral = 0, gradient_integral = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      fe_values.reinit(cell);
+      fe_values.get_function_values(solution, values);
+      fe_values.get_function_gradients(solution, gradients);
+      fe_values[scalar].get_function_values(solution, view_values);
+      fe_values[scalar].get_function_gradients(solution, view_gradients);
+      fe_values.get_function_values(solution_float, float_values);
+      fe_values.get_function_gradients(solution_float, float_gradients);
+      cell->get_dof_indices(dof_indices);
+
+      for (const unsigned int q : fe_values.quadrature_point_indices())
+        {
+          double         value = 0;
+          Tensor<1, dim> gradient;
+          for (const unsigned int i : fe_values.dof_indices())
+            {
+              value += solution(dof_indices[i]) * fe_values.shape_value(i, q);
+              gradient += solution(dof_indices[i]) * fe_values.shape_grad(i, q);
+            }
+          error += std::abs(values[q] - value) +
+                   std::abs(view_values[q] - value) +
+                   (gradients[q] - gradient).norm() +
+                   (view_gradients[q] - gradient).norm();
+          float_error += std::abs(float_values[q] - value) +
+                         (Tensor<1, dim>(float_gradients[q]) - gradient).norm();
+          integral += values[q] * fe_values.JxW(q);
+          gradient_integral += gradients[q].norm_square() * fe_values.JxW(q);
+        }
+    }
+
+  deallog << fe.get_name() << " with " << n_q_points_1d
+          << " points per direction" << (distorted ? ", distorted mesh" : "")
+          << std::endl;
+  deallog << "  integral " << integral << ", of squared gradient "
+          << gradient_integral << ", "
+          << (error < 1e-10 && float_error < 1e-3 ?
+                "same as sum over shape functions" :
+                "different from sum over shape functions")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.precision(5);
+
+  test<2>(FE_Q<2>(4), 5, true);
+  test<2>(FE_Q<2>(4), 5, false);
+  test<2>(FE_DGQ<2>(3), 6, true);
+  test<2>(FE_Q<2>(2), 3, true);
+  test<2>(FE_DGQ<2>(1), 2, false);
+  test<3>(FE_Q<3>(3), 4, true);
+  test<3>(FE_DGQ<3>(4), 4, true);
+  test<3>(FE_Q<3>(2), 3, false);
+}
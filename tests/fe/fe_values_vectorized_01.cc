@@ -0,0 +1,176 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Assemble the cell matrices and right hand sides of a Laplace problem on
+// batches of cells with FEValuesVectorized and compare them to the ones
+// computed with FEValues on each cell separately, for several element and
+// mapping degrees. The number of cells is not a multiple of the vector
+// width, so the last batch is only partially filled. Print the sum of the
+// diagonal entries of the cell matrices and the sum of the right hand side
+// entries, which is the integral of the right hand side function.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_vectorized.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int fe_degree, const unsigned int mapping_degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  const FE_Q<dim> fe(fe_degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim> mapping(mapping_degree);
+  const QGauss<dim>   quadrature(fe_degree + 1);
+  const UpdateFlags   flags = update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values;
+  FEValues<dim>           fe_values(mapping, fe, quadrature, flags);
+  FEValuesVectorized<dim> fe_values_vectorized(mapping,
+                                               fe,
+                                               quadrature,
+                                               flags);
+
+  const unsigned int n_lanes       = VectorizedArray<double>::size();
+  const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+
+  Table<2, VectorizedArray<double>> cell_matrix(dofs_per_cell, dofs_per_cell);
+  std::vector<VectorizedArray<double>> cell_rhs(dofs_per_cell);
+  FullMatrix<double>                   reference_matrix(dofs_per_cell);
+  Vector<double>                       reference_rhs(dofs_per_cell);
+
+  double       error     = 0;
+  double       trace     = 0;
+  double       rhs_sum   = 0;
+  unsigned int n_batches = 0;
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cells.push_back(cell);
+      if (cells.size() < n_lanes && std::next(cell) != dof_handler.end())
+        continue;
+
+      fe_values_vectorized.reinit(make_array_view(cells));
+      ++n_batches;
+
+      for (const unsigned int i : fe_values_vectorized.dof_indices())
+        {
+          for (const unsigned int j : fe_values_vectorized.dof_indices())
+            {
+              VectorizedArray<double> sum = 0.;
+              for (const unsigned int q :
+                   fe_values_vectorized.quadrature_point_indices())
+                sum += fe_values_vectorized.shape_grad(i, q) *
+                       fe_values_vectorized.shape_grad(j, q) *
+                       fe_values_vectorized.JxW(q);
+              cell_matrix(i, j) = sum;
+            }
+
+          VectorizedArray<double> sum = 0.;
+          for (const unsigned int q :
+               fe_values_vectorized.quadrature_point_indices())
+            sum += fe_values_vectorized.shape_value(i, q) *
+                   fe_values_vectorized.quadrature_point(q).norm_square() *
+                   fe_values_vectorized.JxW(q);
+          cell_rhs[i] = sum;
+        }
+
+      for (unsigned int v = 0; v < n_lanes; ++v)
+        {
+          reference_matrix = 0;
+          reference_rhs    = 0;
+          if (v < cells.size())
+            {
+              fe_values.reinit(cells[v]);
+              for (const unsigned int q : fe_values.quadrature_point_indices())
+                for (const unsigned int i : fe_values.dof_indices())
+                  {
+                    for (const unsigned int j : fe_values.dof_indices())
+                      reference_matrix(i, j) += fe_values.shape_grad(i, q) *
+                                                fe_values.shape_grad(j, q) *
+                                                fe_values.JxW(q);
+                    reference_rhs(i) +=
+                      fe_values.shape_value(i, q) *
+                      fe_values.quadrature_point(q).norm_square() *
+                      fe_values.JxW(q);
+                  }
+            }
+
+          // unused lanes have to give zero contributions
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            {
+              for (unsigned int j = 0; j < dofs_per_cell; ++j)
+                error +=
+                  std::abs(cell_matrix(i, j)[v] - reference_matrix(i, j));
+              error += std::abs(cell_rhs[i][v] - reference_rhs(i));
+              trace += cell_matrix(i, i)[v];
+              rhs_sum += cell_rhs[i][v];
+            }
+        }
+
+      cells.clear();
+    }
+
+  deallog << fe.get_name() << ", mapping degree " << mapping_degree << ", "
+          << tria.n_active_cells() << " cells, "
+          << (n_batches ==
+                  (tria.n_active_cells() + n_lanes - 1) / n_lanes ?
+                "all cells in batches" :
+                "wrong number of batches")
+          << std::endl;
+  deallog << "  trace " << trace << ", rhs sum " << rhs_sum << ", "
+          << (error < 1e-10 ? "same as FEValues" : "different from FEValues")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(1, 1);
+  test<2>(2, 2);
+  test<2>(3, 2);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(1, 2);
+  test<3>(2, 2);
+  deallog.pop();
+}
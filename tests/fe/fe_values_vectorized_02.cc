@@ -0,0 +1,110 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+// Compare the shape values and gradients of FEValuesVectorized with the ones
+// of FEValues on each cell of the batch, both for an element whose shape
+// data is evaluated once in the constructor (FE_Q) and for one whose values
+// depend on the cell and are copied from FEValues in each reinit()
+// (FE_DGPNonparametric).
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_dgp_nonparametric.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_vectorized.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim>     mapping(2);
+  const QGauss<dim>       quadrature(fe.degree + 1);
+  const UpdateFlags       flags = update_values | update_gradients;
+  FEValues<dim>           fe_values(mapping, fe, quadrature, flags);
+  FEValuesVectorized<dim> fe_values_vectorized(mapping,
+                                               fe,
+                                               quadrature,
+                                               flags);
+
+  const unsigned int n_lanes = VectorizedArray<double>::size();
+
+  double value_error    = 0;
+  double gradient_error = 0;
+  std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    {
+      cells.push_back(cell);
+      if (cells.size() < n_lanes && std::next(cell) != dof_handler.end())
+        continue;
+
+      fe_values_vectorized.reinit(make_array_view(cells));
+      for (unsigned int v = 0; v < cells.size(); ++v)
+        {
+          fe_values.reinit(cells[v]);
+          for (const unsigned int q : fe_values.quadrature_point_indices())
+            for (const unsigned int i : fe_values.dof_indices())
+              {
+                value_error =
+                  std::max(value_error,
+                           std::abs(fe_values_vectorized.shape_value(i, q)[v] -
+                                    fe_values.shape_value(i, q)));
+                for (unsigned int d = 0; d < dim; ++d)
+                  gradient_error = std::max(
+                    gradient_error,
+                    std::abs(fe_values_vectorized.shape_grad(i, q)[d][v] -
+                             fe_values.shape_grad(i, q)[d]));
+              }
+        }
+      cells.clear();
+    }
+
+  deallog << fe.get_name() << ": values "
+          << (value_error < 1e-12 ? "same as FEValues" :
+                                    "different from FEValues")
+          << ", gradients "
+          << (gradient_error < 1e-10 ? "same as FEValues" :
+                                       "different from FEValues")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(FE_Q<2>(2));
+  test<2>(FE_DGPNonparametric<2>(2));
+  test<3>(FE_Q<3>(2));
+  test<3>(FE_DGPNonparametric<3>(1));
+}
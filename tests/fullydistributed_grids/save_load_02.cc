@@ -0,0 +1,105 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test TriangulationDescription::Utilities::save_description_from_triangulation:
+// write the descriptions of a partitioned serial triangulation on one
+// process and load them with fullydistributed::Triangulation::load(). The
+// result must be the same as the one of
+// create_description_from_triangulation().
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include "../grid/tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const unsigned int n_refinements, const MPI_Comm comm)
+{
+  const std::string filename = "save_load_02_" + std::to_string(dim) + "d_out";
+
+  Triangulation<dim> basetria;
+  GridGenerator::subdivided_hyper_cube(basetria, 4);
+  basetria.refine_global(n_refinements);
+
+  GridTools::partition_triangulation_zorder(
+    Utilities::MPI::n_mpi_processes(comm), basetria);
+
+  if (Utilities::MPI::this_mpi_process(comm) == 0)
+    TriangulationDescription::Utilities::save_description_from_triangulation(
+      basetria, Utilities::MPI::n_mpi_processes(comm), filename);
+  MPI_Barrier(comm);
+
+  parallel::fullydistributed::Triangulation<dim> tria_loaded(comm);
+  tria_loaded.load(filename);
+
+  parallel::fullydistributed::Triangulation<dim> tria_created(comm);
+  tria_created.create_triangulation(
+    TriangulationDescription::Utilities::create_description_from_triangulation(
+      basetria, comm));
+
+  deallog << "n_global_active_cells: " << tria_loaded.n_global_active_cells()
+          << std::endl;
+
+  AssertThrow(tria_loaded.n_global_active_cells() ==
+                tria_created.n_global_active_cells(),
+              ExcInternalError());
+  AssertThrow(tria_loaded.n_locally_owned_active_cells() ==
+                tria_created.n_locally_owned_active_cells(),
+              ExcInternalError());
+  AssertThrow(tria_loaded.n_active_cells() == tria_created.n_active_cells(),
+              ExcInternalError());
+
+  auto cell_created = tria_created.begin_active();
+  for (const auto &cell_loaded : tria_loaded.active_cell_iterators())
+    {
+      AssertThrow(cell_loaded->id() == cell_created->id(), ExcInternalError());
+      AssertThrow(cell_loaded->subdomain_id() == cell_created->subdomain_id(),
+                  ExcInternalError());
+      AssertThrow(cell_loaded->center() == cell_created->center(),
+                  ExcInternalError());
+      ++cell_created;
+    }
+
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  deallog.push("2d");
+  test<2>(2, comm);
+  deallog.pop();
+
+  deallog.push("3d");
+  test<3>(1, comm);
+  deallog.pop();
+}
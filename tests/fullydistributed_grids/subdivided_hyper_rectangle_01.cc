@@ -0,0 +1,116 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Create a fully distributed subdivided hyper rectangle directly with
+// TriangulationDescription::Utilities::
+// create_description_from_subdivided_hyper_rectangle() and compare its
+// locally relevant cells with the ones of the serial mesh created by
+// GridGenerator::subdivided_hyper_rectangle().
+
+#include <deal.II/base/mpi.h>
+
+#include <deal.II/distributed/fully_distributed_tria.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+#include <deal.II/grid/tria_description.h>
+
+#include "../tests.h"
+
+using namespace dealii;
+
+template <int dim>
+void
+test(const bool colorize, const MPI_Comm comm)
+{
+  std::vector<unsigned int> repetitions(dim);
+  Point<dim>                p1, p2;
+  for (unsigned int d = 0; d < dim; ++d)
+    {
+      repetitions[d] = d + 2;
+      p1[d]          = -1.;
+      p2[d]          = 2. + d;
+    }
+  if (dim == 1)
+    repetitions[0] = 5;
+
+  Triangulation<dim> tria_serial;
+  GridGenerator::subdivided_hyper_rectangle(
+    tria_serial, repetitions, p1, p2, colorize);
+
+  parallel::fullydistributed::Triangulation<dim> tria_pft(comm);
+  tria_pft.create_triangulation(
+    TriangulationDescription::Utilities::
+      create_description_from_subdivided_hyper_rectangle<dim>(
+        repetitions, p1, p2, comm, colorize));
+
+  unsigned int n_locally_owned = 0;
+  unsigned int n_ghost         = 0;
+  unsigned int n_errors        = 0;
+  for (const auto &cell : tria_pft.active_cell_iterators())
+    {
+      if (cell->is_locally_owned())
+        ++n_locally_owned;
+      else if (cell->is_ghost())
+        ++n_ghost;
+      else
+        continue;
+
+      const auto serial_cell = tria_serial.create_cell_iterator(cell->id());
+
+      for (const unsigned int v : cell->vertex_indices())
+        if (cell->vertex(v) != serial_cell->vertex(v))
+          ++n_errors;
+
+      if (cell->material_id() != serial_cell->material_id())
+        ++n_errors;
+
+      if (cell->is_locally_owned())
+        for (const unsigned int f : cell->face_indices())
+          if (serial_cell->face(f)->at_boundary() &&
+              (cell->face(f)->at_boundary() == false ||
+               cell->face(f)->boundary_id() !=
+                 serial_cell->face(f)->boundary_id()))
+            ++n_errors;
+    }
+
+  deallog << "colorize=" << colorize
+          << " n_global_active_cells=" << tria_pft.n_global_active_cells()
+          << " n_locally_owned=" << n_locally_owned << " n_ghost=" << n_ghost
+          << (n_errors == 0 ? " OK" : " FAILED") << std::endl;
+}
+
+int
+main(int argc, char *argv[])
+{
+  Utilities::MPI::MPI_InitFinalize mpi_initialization(argc, argv, 1);
+  MPILogInitAll                    all;
+
+  const MPI_Comm comm = MPI_COMM_WORLD;
+
+  for (const bool colorize : {false, true})
+    {
+      deallog.push("1d");
+      test<1>(colorize, comm);
+      deallog.pop();
+      deallog.push("2d");
+      test<2>(colorize, comm);
+      deallog.pop();
+      deallog.push("3d");
+      test<3>(colorize, comm);
+      deallog.pop();
+    }
+}
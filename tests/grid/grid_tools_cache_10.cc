@@ -0,0 +1,111 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check that GridTools::Cache::get_cell_bounding_boxes_rtree() correctly
+// updates the tree after refinement and coarsening of the triangulation.
+
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools_cache.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+namespace bgi = boost::geometry::index;
+
+
+template <int dim>
+void
+check(const GridTools::Cache<dim> &cache)
+{
+  const Triangulation<dim> &tria    = cache.get_triangulation();
+  const Mapping<dim>       &mapping = cache.get_mapping();
+
+  std::vector<std::pair<BoundingBox<dim>,
+                        typename Triangulation<dim>::active_cell_iterator>>
+    entries;
+  cache.get_cell_bounding_boxes_rtree().query(
+    bgi::satisfies([](const auto &) { return true; }),
+    std::back_inserter(entries));
+
+  deallog << "n_active_cells: " << tria.n_active_cells()
+          << ", entries in tree: " << entries.size() << std::endl;
+
+  std::set<typename Triangulation<dim>::active_cell_iterator> cells;
+  for (const auto &entry : entries)
+    {
+      AssertThrow(entry.second->is_active(), ExcInternalError());
+      const BoundingBox<dim> box = mapping.get_bounding_box(entry.second);
+      AssertThrow(box.get_boundary_points() ==
+                    entry.first.get_boundary_points(),
+                  ExcInternalError());
+      cells.insert(entry.second);
+    }
+  AssertThrow(cells.size() == tria.n_active_cells(), ExcInternalError());
+}
+
+
+template <int dim>
+void
+test(const unsigned int n_refinements)
+{
+  deallog << "Testing for dim = " << dim << std::endl;
+
+  Triangulation<dim> tria;
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(n_refinements);
+
+  GridTools::Cache<dim> cache(tria);
+  check(cache);
+
+  // refine the first four cells
+  auto cell = tria.begin_active();
+  for (unsigned int i = 0; i < 4; ++i, ++cell)
+    cell->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  check(cache);
+
+  // coarsen the children of the first refined cell again and refine another
+  // cell at the same time
+  for (const auto &child : tria.begin(n_refinements)->child_iterators())
+    child->set_coarsen_flag();
+  tria.begin_active(n_refinements)->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  check(cache);
+
+  // refine and coarsen once more without querying the tree in between
+  tria.begin_active(n_refinements)->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+  for (const auto &child : tria.begin_active(n_refinements + 1)
+                             ->parent()
+                             ->child_iterators())
+    child->set_coarsen_flag();
+  tria.execute_coarsening_and_refinement();
+  check(cache);
+
+  deallog << "OK" << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test<2>(3);
+  test<3>(2);
+}
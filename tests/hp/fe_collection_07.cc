@@ -0,0 +1,121 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Check FECollection::hp_object_dof_identities(): the pairwise identities
+// have to match the ones computed by hp_{vertex,line,quad}_dof_identities(),
+// they have to be computed only once, and they have to be shared between
+// copies of a collection until one of the copies is modified. Also check
+// that repeated queries of find_dominating_fe() and
+// find_dominating_fe_extended() return the same results.
+
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/hp/fe_collection.h>
+
+#include "../tests.h"
+
+
+std::vector<std::pair<unsigned int, unsigned int>>
+reduce(const std::vector<std::map<unsigned int, unsigned int>> &identities,
+       const unsigned int                                       fe_index_1,
+       const unsigned int                                       fe_index_2)
+{
+  std::vector<std::pair<unsigned int, unsigned int>> result;
+  for (const auto &identity : identities)
+    result.emplace_back(identity.at(fe_index_1), identity.at(fe_index_2));
+  return result;
+}
+
+
+
+template <int dim>
+void
+test()
+{
+  hp::FECollection<dim> fe_collection;
+  for (unsigned int degree = 1; degree <= 4; ++degree)
+    fe_collection.push_back(FE_Q<dim>(degree));
+
+  bool ok = true;
+  for (unsigned int i = 0; i < fe_collection.size(); ++i)
+    for (unsigned int j = 0; j < fe_collection.size(); ++j)
+      if (i != j)
+        {
+          const std::set<unsigned int> fes{i, j};
+
+          std::vector<std::vector<std::pair<unsigned int, unsigned int>>>
+            expected;
+          expected.push_back(
+            reduce(fe_collection.hp_vertex_dof_identities(fes), i, j));
+          expected.push_back(
+            reduce(fe_collection.hp_line_dof_identities(fes), i, j));
+          if (dim == 3)
+            expected.push_back(
+              reduce(fe_collection.hp_quad_dof_identities(fes), i, j));
+
+          if (i < j)
+            deallog << i << ' ' << j << ':';
+          for (unsigned int structdim = 0; structdim < expected.size();
+               ++structdim)
+            {
+              const auto &identities =
+                fe_collection.hp_object_dof_identities(structdim, i, j);
+              if (identities != expected[structdim] ||
+                  &identities !=
+                    &fe_collection.hp_object_dof_identities(structdim, i, j))
+                ok = false;
+              if (i < j)
+                deallog << ' ' << identities.size();
+            }
+          if (i < j)
+            deallog << std::endl;
+        }
+  deallog << "identities " << (ok ? "OK" : "FAILED") << std::endl;
+
+  // copies share the stored identities until they are modified
+  hp::FECollection<dim> copy(fe_collection);
+  deallog << "copy shares identities: "
+          << (&copy.hp_object_dof_identities(1, 1, 3) ==
+              &fe_collection.hp_object_dof_identities(1, 1, 3))
+          << std::endl;
+  copy.push_back(FE_Q<dim>(5));
+  deallog << "modified copy shares identities: "
+          << (&copy.hp_object_dof_identities(1, 1, 3) ==
+              &fe_collection.hp_object_dof_identities(1, 1, 3))
+          << std::endl;
+
+  for (unsigned int n = 0; n < 2; ++n)
+    deallog << "dominating: "
+            << fe_collection.find_dominating_fe({1, 2, 3}, /*codim=*/dim)
+            << ' ' << fe_collection.find_dominating_fe_extended({2, 3})
+            << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>();
+  deallog.pop();
+  deallog.push("3d");
+  test<3>();
+  deallog.pop();
+}
@@ -0,0 +1,115 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// DoFTools::make_hanging_node_constraints() collects the constraints of
+// chunks of cells in separate objects if several threads are available and
+// merges them afterwards. Check that this gives exactly the same constraints
+// as a single sweep over all cells on an adaptively refined mesh, both with
+// a single element and with different finite elements, for several numbers
+// of threads. Print the number of constraints and of their entries.
+
+#include <deal.II/base/multithread_info.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/hp/fe_collection.h>
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int max_degree)
+{
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(dim == 2 ? 5 : 3);
+
+  unsigned int index = 0;
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (index++ % 5 == 0)
+      cell->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  hp::FECollection<dim> fe_collection;
+  for (unsigned int degree = 1; degree <= max_degree; ++degree)
+    fe_collection.push_back(FE_Q<dim>(degree));
+
+  DoFHandler<dim> dof_handler(triangulation);
+  index = 0;
+  for (const auto &cell : dof_handler.active_cell_iterators())
+    cell->set_active_fe_index((index++ / 3) % fe_collection.size());
+  dof_handler.distribute_dofs(fe_collection);
+
+  MultithreadInfo::set_thread_limit(1);
+  AffineConstraints<double> serial_constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, serial_constraints);
+
+  std::size_t n_entries = 0;
+  for (const auto &line : serial_constraints.get_lines())
+    n_entries += line.entries.size();
+  deallog << fe_collection.size() << " elements: "
+          << serial_constraints.n_constraints() << " constraints with "
+          << n_entries << " entries" << std::endl;
+
+  for (const unsigned int n_threads : {2u, 3u, 8u})
+    {
+      MultithreadInfo::set_thread_limit(n_threads);
+      AffineConstraints<double> constraints;
+      DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+
+      bool identical =
+        (serial_constraints.n_constraints() == constraints.n_constraints());
+      if (identical)
+        for (unsigned int i = 0; i < constraints.n_constraints(); ++i)
+          {
+            const auto &line        = constraints.get_lines()[i];
+            const auto &serial_line = serial_constraints.get_lines()[i];
+            if (line.index != serial_line.index ||
+                line.entries != serial_line.entries ||
+                line.inhomogeneity != serial_line.inhomogeneity)
+              identical = false;
+          }
+
+      deallog << "  " << n_threads << " threads: "
+              << (identical ? "identical" : "different") << std::endl;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  test<2>(1);
+  test<2>(4);
+  deallog.pop();
+  deallog.push("3d");
+  test<3>(2);
+  test<3>(4);
+  deallog.pop();
+}
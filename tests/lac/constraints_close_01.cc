@@ -0,0 +1,126 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// AffineConstraints::close() resolves chains of constraints level by level.
+// Set up long chains of constraints, some of which end in DoFs that are only
+// constrained to an inhomogeneity, add them in scrambled order, and check
+// that the closed constraints only refer to unconstrained DoFs and evaluate
+// to the same values as the original chains. Each constrained DoF depends
+// either on the next two DoFs or on a single other one, which gives chains
+// that are resolved into many or into at most one entry.
+
+
+#include <deal.II/lac/affine_constraints.h>
+
+#include "../tests.h"
+
+
+// the DoF a constrained DoF depends on if it only has one entry: usually the
+// next constrained one, which makes for long chains, but every fifth chain
+// ends in an unconstrained DoF
+types::global_dof_index
+next_dof(const types::global_dof_index i)
+{
+  return ((i + 1) % 3 == 0 && i % 5 != 0) ? i + 2 : i + 1;
+}
+
+
+
+void
+test(const bool two_entries)
+{
+  const unsigned int n = 900;
+
+  std::vector<types::global_dof_index> constrained_dofs;
+  for (unsigned int i = 0; i < n - 2; ++i)
+    if (i % 3 != 0)
+      constrained_dofs.push_back(i);
+
+  // values of the unconstrained DoFs and reference values of the constrained
+  // ones, computed from the back
+  std::vector<double> values(n);
+  for (unsigned int i = n; i-- > 0;)
+    if (i % 3 == 0 || i >= n - 2)
+      values[i] = i;
+    else if (i % 99 == 5)
+      values[i] = 2.;
+    else if (two_entries)
+      values[i] = 1. + 0.5 * values[i + 1] + 0.25 * values[i + 2];
+    else
+      values[i] = 1. + 0.5 * values[next_dof(i)];
+
+  AffineConstraints<double> constraints;
+  const unsigned int        n_constrained = constrained_dofs.size();
+  for (unsigned int k = 0; k < n_constrained; ++k)
+    {
+      const types::global_dof_index i =
+        constrained_dofs[(k * 367) % n_constrained];
+      constraints.add_line(i);
+      if (i % 99 == 5)
+        constraints.set_inhomogeneity(i, 2.);
+      else
+        {
+          if (two_entries)
+            {
+              constraints.add_entry(i, i + 1, 0.5);
+              constraints.add_entry(i, i + 2, 0.25);
+            }
+          else
+            constraints.add_entry(i, next_dof(i), 0.5);
+          constraints.set_inhomogeneity(i, 1.);
+        }
+    }
+  constraints.close();
+
+  unsigned int max_entries = 0;
+  double       max_error   = 0.;
+  bool         chain_left  = false;
+  for (const auto &line : constraints.get_lines())
+    {
+      double value = line.inhomogeneity;
+      for (const auto &entry : line.entries)
+        {
+          if (constraints.is_constrained(entry.first))
+            chain_left = true;
+          value += entry.second * values[entry.first];
+        }
+      max_entries = std::max<unsigned int>(max_entries, line.entries.size());
+      max_error = std::max(max_error,
+                           std::abs(value - values[line.index]) /
+                             std::abs(values[line.index]));
+    }
+
+  std::size_t n_entries = 0;
+  for (const auto &line : constraints.get_lines())
+    n_entries += line.entries.size();
+
+  deallog << "n_constraints=" << constraints.n_constraints()
+          << " n_entries=" << n_entries << " max_entries=" << max_entries
+          << (chain_left ? " chains left" : " no chains left")
+          << (max_error < 1e-12 ? ", values match" : ", values differ")
+          << std::endl;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  test(true);
+  test(false);
+}
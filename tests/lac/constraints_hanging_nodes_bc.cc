@@ -115,7 +115,7 @@ test()
                     library_constraints.is_constrained(i),
                   ExcInternalError());
       using constraint_format =
-        const std::vector<std::pair<types::global_dof_index, double>> &;
+        const AffineConstraints<double>::ConstraintLine::Entries &;
       if (correct_constraints.is_constrained(i))
         {
           constraint_format correct =
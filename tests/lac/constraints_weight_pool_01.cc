@@ -0,0 +1,168 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// AffineConstraints::enable_weight_pool(): check that distribute(),
+// condense() and distribute_local_to_global() for vectors give the same
+// results with and without the pooled weights, including after shift().
+// Print the norm of the result and the largest difference between the two.
+
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+void
+fill(AffineConstraints<double> &constraints,
+     const unsigned int         n,
+     const bool                 inhomogeneous)
+{
+  for (unsigned int i = 1; i < n - 2; i += 2)
+    {
+      constraints.add_line(i);
+      if (i % 4 == 1)
+        {
+          constraints.add_entry(i, i - 1, 0.5);
+          constraints.add_entry(i, i + 1, 0.5);
+        }
+      else
+        {
+          constraints.add_entry(i, i - 1, 0.375);
+          constraints.add_entry(i, i + 1, 0.75);
+          constraints.add_entry(i, i + 3, -0.125);
+        }
+      if (inhomogeneous && i % 40 == 3)
+        constraints.set_inhomogeneity(i, 1.);
+    }
+}
+
+
+
+void
+compare(const Vector<double> &v1,
+        const Vector<double> &v2,
+        const std::string    &name)
+{
+  Vector<double> difference = v1;
+  difference -= v2;
+  deallog << name << ": norm " << v1.l2_norm() << ", difference "
+          << difference.linfty_norm() << std::endl;
+}
+
+
+
+void
+test(const bool inhomogeneous)
+{
+  const unsigned int n = 1000;
+
+  AffineConstraints<double> constraints, pooled_constraints,
+    pooled_after_close;
+  fill(constraints, n, inhomogeneous);
+  fill(pooled_constraints, n, inhomogeneous);
+  fill(pooled_after_close, n, inhomogeneous);
+  constraints.close();
+  pooled_constraints.enable_weight_pool();
+  pooled_constraints.close();
+  pooled_after_close.close();
+  pooled_after_close.enable_weight_pool();
+
+  deallog << (inhomogeneous ? "inhomogeneous, " : "homogeneous, ")
+          << pooled_constraints.n_constraints() << " constraints, "
+          << pooled_constraints.n_weight_patterns() << " weight patterns"
+          << std::endl;
+
+  Vector<double> vector(n);
+  for (unsigned int i = 0; i < n; ++i)
+    vector(i) = 1. + (i % 7);
+
+  {
+    Vector<double> v1 = vector, v2 = vector, v3 = vector;
+    constraints.distribute(v1);
+    pooled_constraints.distribute(v2);
+    pooled_after_close.distribute(v3);
+    compare(v1, v2, "distribute");
+    compare(v1, v3, "distribute after close");
+  }
+
+  {
+    Vector<double> v1(n), v2(n);
+    std::vector<types::global_dof_index> indices(8);
+    std::vector<double>                  values(8);
+    for (unsigned int c = 0; c + 8 < n; c += 7)
+      {
+        for (unsigned int i = 0; i < 8; ++i)
+          {
+            indices[i] = c + i;
+            values[i]  = vector(c + i);
+          }
+        constraints.distribute_local_to_global(values.begin(),
+                                               values.end(),
+                                               indices.begin(),
+                                               v1);
+        pooled_constraints.distribute_local_to_global(values.begin(),
+                                                      values.end(),
+                                                      indices.begin(),
+                                                      v2);
+      }
+    compare(v1, v2, "distribute_local_to_global");
+  }
+
+  if (inhomogeneous == false)
+    {
+      Vector<double> v1 = vector, v2 = vector;
+      constraints.condense(v1);
+      pooled_constraints.condense(v2);
+      compare(v1, v2, "condense");
+    }
+
+  {
+    constraints.shift(n);
+    pooled_constraints.shift(n);
+    Vector<double> v1(2 * n), v2(2 * n);
+    for (unsigned int i = 0; i < n; ++i)
+      v1(n + i) = v2(n + i) = vector(i);
+    constraints.distribute(v1);
+    pooled_constraints.distribute(v2);
+    compare(v1, v2, "distribute after shift");
+  }
+
+  pooled_constraints.clear();
+  fill(pooled_constraints, n, inhomogeneous);
+  pooled_constraints.close();
+  constraints.clear();
+  fill(constraints, n, inhomogeneous);
+  constraints.close();
+  {
+    Vector<double> v1 = vector, v2 = vector;
+    constraints.distribute(v1);
+    pooled_constraints.distribute(v2);
+    compare(v1, v2, "distribute after clear");
+  }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(false);
+  test(true);
+}
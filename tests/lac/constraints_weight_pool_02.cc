@@ -0,0 +1,103 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// AffineConstraints::enable_weight_pool(): check that the hanging node
+// constraints of an adaptively refined mesh are reduced to a few unique
+// weight patterns, that get_lines() returns the same entries from the pool,
+// that the pool uses less memory than the entries of the individual lines,
+// and that distribute() gives the same result with the pooled weights.
+
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/vector.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int degree)
+{
+  Triangulation<dim> tria;
+  GridGenerator::hyper_ball(tria);
+  tria.refine_global(1);
+  for (unsigned int cycle = 0; cycle < 2; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] < 0.)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  FE_Q<dim>       fe(degree);
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints, pooled_constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  DoFTools::make_hanging_node_constraints(dof_handler, pooled_constraints);
+  constraints.close();
+  pooled_constraints.enable_weight_pool();
+  pooled_constraints.close();
+
+  Vector<double> v1(dof_handler.n_dofs());
+  for (unsigned int i = 0; i < v1.size(); ++i)
+    v1(i) = 1. + (i % 11);
+  Vector<double> v2 = v1;
+  constraints.distribute(v1);
+  pooled_constraints.distribute(v2);
+  v2 -= v1;
+
+  bool same_entries = true;
+  for (unsigned int i = 0; i < constraints.n_constraints(); ++i)
+    if (constraints.get_lines()[i].entries !=
+          pooled_constraints.get_lines()[i].entries ||
+        pooled_constraints.get_lines()[i].entries.is_pooled() == false)
+      same_entries = false;
+
+  deallog << fe.get_name() << ": " << dof_handler.n_dofs() << " dofs, "
+          << constraints.n_constraints() << " constraints, "
+          << constraints.n_weight_patterns() << " / "
+          << pooled_constraints.n_weight_patterns()
+          << " weight patterns, distribute: " << v1.l2_norm() << ' '
+          << v2.linfty_norm() << std::endl;
+  const bool less_memory = pooled_constraints.memory_consumption() <
+                           constraints.memory_consumption();
+  deallog << "  pooled entries " << (same_entries ? "are the same" : "differ")
+          << ", memory " << (less_memory ? "reduced" : "not reduced")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree < 4; ++degree)
+    test<2>(degree);
+  for (unsigned int degree = 1; degree < 3; ++degree)
+    test<3>(degree);
+}
@@ -0,0 +1,139 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// MappingQ uses a shortcut on cells on which the mapping is affine. Check
+// the data computed by FEValues on a parallelepiped against the analytic
+// affine map, and check that the shortcut is not taken once a vertex of the
+// cell is moved. Print the cell volumes and the variation of the Jacobian
+// between the quadrature points on the distorted cell.
+
+
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+test(const unsigned int mapping_degree)
+{
+  Point<dim> corners[dim];
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int e = 0; e < dim; ++e)
+      corners[d][e] = (d == e ? 1. + 0.5 * d : 0.1 * (d + 2 * e + 1));
+  Point<dim> shift;
+  for (unsigned int d = 0; d < dim; ++d)
+    shift[d] = 0.3 * (d + 1);
+
+  Triangulation<dim> tria;
+  GridGenerator::parallelepiped(tria, corners);
+  GridTools::shift(shift, tria);
+
+  // the affine map is x = shift + A xi
+  Tensor<2, dim> A;
+  for (unsigned int d = 0; d < dim; ++d)
+    for (unsigned int e = 0; e < dim; ++e)
+      A[e][d] = corners[d][e];
+  const Tensor<2, dim> A_inv_T = transpose(invert(A));
+
+  const FE_Q<dim>     fe(2);
+  const MappingQ<dim> mapping(mapping_degree);
+  const QGauss<dim>   quadrature(3);
+  FEValues<dim>       fe_values(mapping,
+                                fe,
+                                quadrature,
+                                update_quadrature_points | update_gradients |
+                                  update_JxW_values | update_jacobians |
+                                  update_inverse_jacobians |
+                                  update_jacobian_grads);
+  fe_values.reinit(tria.begin_active());
+
+  double error  = 0;
+  double volume = 0;
+  for (const unsigned int q : fe_values.quadrature_point_indices())
+    {
+      volume += fe_values.JxW(q);
+      const Point<dim> &xi = quadrature.point(q);
+      error += (fe_values.quadrature_point(q) - (shift + A * xi)).norm();
+      error += std::abs(fe_values.JxW(q) -
+                        determinant(A) * quadrature.weight(q));
+      for (unsigned int d = 0; d < dim; ++d)
+        for (unsigned int e = 0; e < dim; ++e)
+          {
+            error += std::abs(fe_values.jacobian(q)[e][d] - A[e][d]);
+            error +=
+              std::abs(fe_values.inverse_jacobian(q)[d][e] - A_inv_T[e][d]);
+          }
+      error += fe_values.jacobian_grad(q).norm();
+      for (const unsigned int i : fe_values.dof_indices())
+        error +=
+          (fe_values.shape_grad(i, q) - A_inv_T * fe.shape_grad(i, xi)).norm();
+    }
+  deallog << "mapping degree " << mapping_degree
+          << ", affine cell: volume " << volume << " (exact "
+          << determinant(A) << "), "
+          << (error < 1e-10 ? "matches affine map" : "differs from affine map")
+          << std::endl;
+
+  // move the last vertex; now the Jacobian has to vary between the
+  // quadrature points. use a new FEValues object since the cell would
+  // otherwise be considered a translation of the previous one
+  tria.begin_active()->vertex(GeometryInfo<dim>::vertices_per_cell - 1) +=
+    0.1 * shift;
+  FEValues<dim> fe_values_distorted(mapping,
+                                    fe,
+                                    quadrature,
+                                    update_jacobians | update_JxW_values);
+  fe_values_distorted.reinit(tria.begin_active());
+  double variation        = 0;
+  double distorted_volume = 0;
+  for (const unsigned int q : fe_values.quadrature_point_indices())
+    {
+      variation += (Tensor<2, dim>(fe_values_distorted.jacobian(q)) -
+                    Tensor<2, dim>(fe_values_distorted.jacobian(0)))
+                     .norm();
+      distorted_volume += fe_values_distorted.JxW(q);
+    }
+  deallog << "mapping degree " << mapping_degree
+          << ", distorted cell: volume " << distorted_volume
+          << ", variation of Jacobian " << variation << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  for (unsigned int degree = 1; degree <= 3; ++degree)
+    {
+      deallog.push("2d");
+      test<2>(degree);
+      deallog.pop();
+      deallog.push("3d");
+      test<3>(degree);
+      deallog.pop();
+    }
+}
@@ -0,0 +1,158 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test MatrixFreeTools::estimate_kelly_error() against
+// KellyErrorEstimator::estimate() for high-order elements on meshes with
+// hanging nodes, both on a curved mesh and on an affine one. Print the norm
+// of the indicators computed by both functions and the largest difference
+// of a single cell indicator relative to the largest indicator.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/error_estimator.h>
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class SmoothFunction : public Function<dim>
+{
+public:
+  SmoothFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    double value = std::sin(2. * p[0] + component);
+    for (unsigned int d = 1; d < dim; ++d)
+      value *= std::cos((d + 2.) * p[d]);
+    return value;
+  }
+};
+
+
+
+template <int dim, int n_components>
+void
+test(const FiniteElement<dim> &fe, const bool curved)
+{
+  Triangulation<dim> tria;
+  if (curved)
+    GridGenerator::hyper_ball(tria);
+  else
+    GridGenerator::subdivided_hyper_cube(tria, 2, -1., 1.);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  const MappingQ<dim>     mapping(curved ? 2 : 1);
+  const unsigned int      degree = fe.degree;
+  const QGauss<1>         quadrature(degree + 1);
+  MatrixFree<dim, double> matrix_free;
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags_inner_faces =
+    update_gradients | update_JxW_values;
+  matrix_free.reinit(
+    mapping, dof_handler, constraints, quadrature, additional_data);
+
+  LinearAlgebra::distributed::Vector<double> solution;
+  matrix_free.initialize_dof_vector(solution);
+  VectorTools::interpolate(mapping,
+                           dof_handler,
+                           SmoothFunction<dim>(n_components),
+                           solution);
+  constraints.distribute(solution);
+
+  Vector<float> error_kelly(tria.n_active_cells());
+  KellyErrorEstimator<dim>::estimate(mapping,
+                                     dof_handler,
+                                     QGauss<dim - 1>(degree + 1),
+                                     {},
+                                     solution,
+                                     error_kelly);
+
+  Vector<float> error_matrix_free;
+  MatrixFreeTools::estimate_kelly_error<dim,
+                                        -1,
+                                        0,
+                                        n_components,
+                                        double,
+                                        VectorizedArray<double>>(
+    matrix_free, solution, error_matrix_free);
+
+  AssertDimension(error_matrix_free.size(), error_kelly.size());
+  Vector<float> difference(error_kelly);
+  difference -= error_matrix_free;
+
+  deallog << fe.get_name() << (curved ? ", curved mesh, " : ", affine mesh, ")
+          << tria.n_active_cells() << " cells" << std::endl;
+  deallog << "  norm of indicators: " << error_kelly.l2_norm()
+          << ", matrix-free: " << error_matrix_free.l2_norm() << std::endl;
+  deallog << "  relative difference below 1e-5: "
+          << (difference.linfty_norm() < 1e-5 * error_kelly.linfty_norm() ?
+                "yes" :
+                "no")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.precision(5);
+
+  test<2, 1>(FE_Q<2>(4), true);
+  test<2, 1>(FE_Q<2>(1), false);
+  test<2, 1>(FE_DGQ<2>(3), true);
+  test<2, 1>(FE_DGQ<2>(2), false);
+  test<2, 2>(FESystem<2>(FE_Q<2>(3), 2), true);
+  test<3, 1>(FE_Q<3>(3), true);
+  test<3, 1>(FE_Q<3>(2), false);
+}
@@ -0,0 +1,175 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// Test MatrixFreeTools::integrate_difference() against
+// VectorTools::integrate_difference() for the L2 norm and the H1 seminorm
+// and norm, for scalar and vector-valued elements on curved and affine
+// meshes with hanging nodes. Print the global errors computed from the cell
+// contributions of both functions.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/matrix_free/matrix_free.h>
+#include <deal.II/matrix_free/tools.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class SmoothFunction : public Function<dim>
+{
+public:
+  SmoothFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    double value = std::sin(2. * p[0] + component);
+    for (unsigned int d = 1; d < dim; ++d)
+      value *= std::cos((d + 2.) * p[d]);
+    return value;
+  }
+
+  virtual Tensor<1, dim>
+  gradient(const Point<dim> &p, const unsigned int component) const override
+  {
+    Tensor<1, dim> gradient;
+    for (unsigned int e = 0; e < dim; ++e)
+      {
+        gradient[e] = (e == 0 ? 2. * std::cos(2. * p[0] + component) :
+                                std::sin(2. * p[0] + component));
+        for (unsigned int d = 1; d < dim; ++d)
+          gradient[e] *= (e == d ? -(d + 2.) * std::sin((d + 2.) * p[d]) :
+                                   std::cos((d + 2.) * p[d]));
+      }
+    return gradient;
+  }
+};
+
+
+
+template <int dim, int n_components>
+void
+test(const FiniteElement<dim> &fe, const bool curved)
+{
+  Triangulation<dim> tria;
+  if (curved)
+    GridGenerator::hyper_ball(tria);
+  else
+    GridGenerator::subdivided_hyper_cube(tria, 2, -1., 1.);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  const MappingQ<dim>     mapping(curved ? 2 : 1);
+  const unsigned int      degree = fe.degree;
+  MatrixFree<dim, double> matrix_free;
+
+  typename MatrixFree<dim, double>::AdditionalData additional_data;
+  additional_data.mapping_update_flags = update_values | update_gradients |
+                                         update_JxW_values |
+                                         update_quadrature_points;
+  matrix_free.reinit(
+    mapping, dof_handler, constraints, QGauss<1>(degree + 2), additional_data);
+
+  // interpolate the function we compare with, so that the errors are
+  // interpolation errors that decrease with the degree
+  const SmoothFunction<dim>                  exact_solution(n_components);
+  LinearAlgebra::distributed::Vector<double> solution;
+  matrix_free.initialize_dof_vector(solution);
+  VectorTools::interpolate(mapping, dof_handler, exact_solution, solution);
+  constraints.distribute(solution);
+
+  deallog << fe.get_name() << (curved ? ", curved mesh" : ", affine mesh")
+          << std::endl;
+  const std::vector<std::pair<VectorTools::NormType, std::string>> norms = {
+    {VectorTools::L2_norm, "L2_norm"},
+    {VectorTools::H1_seminorm, "H1_seminorm"},
+    {VectorTools::H1_norm, "H1_norm"}};
+  for (const auto &[norm, name] : norms)
+    {
+      Vector<float> difference;
+      VectorTools::integrate_difference(mapping,
+                                        dof_handler,
+                                        solution,
+                                        exact_solution,
+                                        difference,
+                                        QGauss<dim>(degree + 2),
+                                        norm);
+
+      Vector<float> difference_matrix_free;
+      MatrixFreeTools::integrate_difference<dim,
+                                            -1,
+                                            0,
+                                            n_components,
+                                            double,
+                                            VectorizedArray<double>>(
+        matrix_free, solution, exact_solution, difference_matrix_free, norm);
+
+      deallog << "  " << name << ": "
+              << VectorTools::compute_global_error(tria, difference, norm)
+              << ", matrix-free: "
+              << VectorTools::compute_global_error(tria,
+                                                   difference_matrix_free,
+                                                   norm)
+              << std::endl;
+    }
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.precision(5);
+
+  test<2, 1>(FE_Q<2>(3), true);
+  test<2, 1>(FE_Q<2>(1), false);
+  test<2, 2>(FESystem<2>(FE_Q<2>(2), 2), true);
+  test<2, 2>(FESystem<2>(FE_DGQ<2>(3), 2), false);
+  test<3, 1>(FE_DGQ<3>(2), true);
+  test<3, 1>(FE_Q<3>(2), false);
+}
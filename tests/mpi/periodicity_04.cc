@@ -230,8 +230,7 @@ check(const unsigned int orientation, bool reverse)
       const unsigned int line = constraints_lines.nth_index_in_set(i);
       if (constraints.is_constrained(line))
         {
-          const std::vector<std::pair<types::global_dof_index, double>>
-            *entries = constraints.get_constraint_entries(line);
+          const auto *entries = constraints.get_constraint_entries(line);
           Assert(entries->size() == 1, ExcInternalError());
           const Point<dim> point1     = support_points[line];
           const Point<dim> point2     = support_points[(*entries)[0].first];
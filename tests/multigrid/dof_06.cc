@@ -0,0 +1,113 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// The level DoF indices of all vertices are stored in one array and the
+// levels are enumerated concurrently. Check on a locally refined mesh that
+// the indices of a vertex on a level are the same for all cells of that
+// level that share the vertex, and that every level index is used. Print
+// the number of vertices and DoFs on each level for several elements.
+
+#include <deal.II/dofs/dof_accessor.h>
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <algorithm>
+#include <map>
+
+#include "../tests.h"
+
+
+template <int dim>
+void
+check(const FiniteElement<dim> &fe)
+{
+  Triangulation<dim> tria(
+    Triangulation<dim>::limit_level_difference_at_vertices);
+  GridGenerator::hyper_cube(tria);
+  tria.refine_global(2);
+  for (unsigned int cycle = 0; cycle < 2; ++cycle)
+    {
+      for (const auto &cell : tria.active_cell_iterators())
+        if (cell->center()[0] < 0.3 && cell->center()[1] < 0.3)
+          cell->set_refine_flag();
+      tria.execute_coarsening_and_refinement();
+    }
+
+  deallog << fe.get_name() << std::endl;
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+  dof_handler.distribute_mg_dofs();
+
+  std::vector<types::global_dof_index> dof_indices(fe.n_dofs_per_cell());
+  for (unsigned int level = 0; level < tria.n_levels(); ++level)
+    {
+      bool              ok = true;
+      std::vector<bool> used(dof_handler.n_dofs(level), false);
+      std::map<unsigned int, std::vector<types::global_dof_index>>
+        vertex_dofs;
+      for (const auto &cell : dof_handler.mg_cell_iterators_on_level(level))
+        {
+          cell->get_mg_dof_indices(dof_indices);
+          for (const auto i : dof_indices)
+            if (i < used.size())
+              used[i] = true;
+            else
+              ok = false;
+
+          for (const unsigned int v : cell->vertex_indices())
+            {
+              std::vector<types::global_dof_index> indices(
+                fe.n_dofs_per_vertex());
+              for (unsigned int i = 0; i < fe.n_dofs_per_vertex(); ++i)
+                indices[i] = cell->mg_vertex_dof_index(level, v, i);
+
+              const auto it =
+                vertex_dofs.emplace(cell->vertex_index(v), indices).first;
+              if (it->second != indices)
+                ok = false;
+            }
+        }
+      if (std::find(used.begin(), used.end(), false) != used.end())
+        ok = false;
+
+      deallog << "  level " << level << ": " << vertex_dofs.size()
+              << " vertices, " << dof_handler.n_dofs(level) << " DoFs, "
+              << (ok ? "consistent" : "inconsistent") << std::endl;
+    }
+}
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.push("2d");
+  check<2>(FE_Q<2>(1));
+  check<2>(FESystem<2>(FE_Q<2>(2), 2));
+  check<2>(FE_Q<2>(3));
+  deallog.pop();
+  deallog.push("3d");
+  check<3>(FE_Q<3>(1));
+  check<3>(FESystem<3>(FE_Q<3>(2), 2));
+  deallog.pop();
+}
@@ -0,0 +1,57 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+// Like the _01_exception test, but for a task without return value: check
+// that Task<void>::join() re-throws the exception thrown by the task the
+// first time it is called, and that later calls return normally.
+
+#include <deal.II/base/thread_management.h>
+
+#include "../tests.h"
+
+
+void
+test()
+{
+  std::this_thread::sleep_for(std::chrono::seconds(3));
+
+  throw 42;
+}
+
+
+int
+main()
+{
+  initlog();
+
+  Threads::Task<void> t = Threads::new_task(test);
+
+  // Here, an exception should be triggered:
+  try
+    {
+      t.join();
+      deallog << "No exception" << std::endl;
+    }
+  catch (int i)
+    {
+      Assert(i == 42, ExcInternalError());
+      deallog << "Exception " << i << std::endl;
+    }
+
+  // The exception has been consumed, so joining again just returns:
+  t.join();
+  deallog << "OK" << std::endl;
+}
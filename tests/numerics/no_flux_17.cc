@@ -65,10 +65,10 @@ compare_constraints(const AffineConstraints<double> &constraints1,
           return false;
         }
 
-      const std::vector<std::pair<types::global_dof_index, double>>
-        *constraint_entries_1 = constraints1.get_constraint_entries(line_index);
-      const std::vector<std::pair<types::global_dof_index, double>>
-        *constraint_entries_2 = constraints2.get_constraint_entries(line_index);
+      const auto *constraint_entries_1 =
+        constraints1.get_constraint_entries(line_index);
+      const auto *constraint_entries_2 =
+        constraints2.get_constraint_entries(line_index);
       if (constraint_entries_1 == nullptr && constraint_entries_2 == nullptr)
         {
           return true;
@@ -109,9 +109,9 @@ test(unsigned order)
               return;
             }
 
-          const std::vector<std::pair<types::global_dof_index, double>> &c1 =
+          const auto &c1 =
             *constraints_fes.get_constraint_entries(lines.nth_index_in_set(i));
-          const std::vector<std::pair<types::global_dof_index, double>> &c2 =
+          const auto &c2 =
             *constraints_fe.get_constraint_entries(lines.nth_index_in_set(i));
 
           for (std::size_t j = 0; j < c1.size(); ++j)
@@ -0,0 +1,165 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// VectorTools::project() integrates the right hand side with FEEvaluation
+// when the quadrature formula is a tensor product, and inverts the mass
+// matrix of discontinuous elements cell by cell. Project a smooth function
+// into LinearAlgebra::distributed::Vector for scalar, vector-valued and
+// discontinuous elements, with tensor-product and other quadrature formulas,
+// on affine and deformed meshes, and print the L2 errors of the projection
+// and of the interpolation of the same function.
+
+#include <deal.II/base/function.h>
+#include <deal.II/base/quadrature_lib.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_dgq.h>
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_system.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/affine_constraints.h>
+#include <deal.II/lac/la_parallel_vector.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/vector_tools.h>
+
+#include "../tests.h"
+
+
+template <int dim>
+class SmoothFunction : public Function<dim>
+{
+public:
+  SmoothFunction(const unsigned int n_components)
+    : Function<dim>(n_components)
+  {}
+
+  virtual double
+  value(const Point<dim> &p, const unsigned int component) const override
+  {
+    double value = std::sin(2. * p[0] + component);
+    for (unsigned int d = 1; d < dim; ++d)
+      value *= std::cos((d + 2.) * p[d]);
+    return value;
+  }
+};
+
+
+
+template <int dim>
+double
+compute_l2_error(const Mapping<dim>                               &mapping,
+                 const DoFHandler<dim>                            &dof_handler,
+                 const LinearAlgebra::distributed::Vector<double> &solution,
+                 const Function<dim>                              &function)
+{
+  Vector<float> cellwise_error;
+  VectorTools::integrate_difference(mapping,
+                                    dof_handler,
+                                    solution,
+                                    function,
+                                    cellwise_error,
+                                    QGauss<dim>(dof_handler.get_fe().degree +
+                                                2),
+                                    VectorTools::L2_norm);
+  return VectorTools::compute_global_error(dof_handler.get_triangulation(),
+                                           cellwise_error,
+                                           VectorTools::L2_norm);
+}
+
+
+
+template <int dim>
+void
+test(const FiniteElement<dim> &fe,
+     const Quadrature<dim>    &quadrature,
+     const bool                deformed)
+{
+  Triangulation<dim> tria;
+  GridGenerator::subdivided_hyper_cube(tria, 2, -1., 1.);
+  // move the center vertex to make the cells non-affine
+  if (deformed)
+    GridTools::transform(
+      [](const Point<dim> &p) {
+        double factor = 0.15;
+        for (unsigned int d = 0; d < dim; ++d)
+          factor *= 1. - p[d] * p[d];
+        Point<dim> result = p;
+        for (unsigned int d = 0; d < dim; ++d)
+          result[d] += factor;
+        return result;
+      },
+      tria);
+  tria.refine_global(1);
+  tria.begin_active()->set_refine_flag();
+  tria.execute_coarsening_and_refinement();
+
+  DoFHandler<dim> dof_handler(tria);
+  dof_handler.distribute_dofs(fe);
+
+  AffineConstraints<double> constraints;
+  DoFTools::make_hanging_node_constraints(dof_handler, constraints);
+  constraints.close();
+
+  const MappingQ<dim>       mapping(1);
+  const SmoothFunction<dim> function(fe.n_components());
+
+  LinearAlgebra::distributed::Vector<double> projected(dof_handler.n_dofs());
+  LinearAlgebra::distributed::Vector<double> interpolated(dof_handler.n_dofs());
+
+  VectorTools::project(
+    mapping, dof_handler, constraints, quadrature, function, projected);
+  VectorTools::interpolate(mapping, dof_handler, function, interpolated);
+  constraints.distribute(interpolated);
+
+  deallog << fe.get_name() << " with " << quadrature.size()
+          << " quadrature points" << (deformed ? ", deformed mesh" : "")
+          << std::endl;
+  deallog << "  L2 error of projection: "
+          << compute_l2_error(mapping, dof_handler, projected, function)
+          << ", of interpolation: "
+          << compute_l2_error(mapping, dof_handler, interpolated, function)
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  deallog.precision(5);
+
+  test<2>(FE_Q<2>(3), QGauss<2>(4), false);
+  test<2>(FE_Q<2>(3), QGaussLobatto<2>(5), true);
+  test<2>(FE_DGQ<2>(2), QGauss<2>(3), false);
+  test<2>(FE_DGQ<2>(2), QGauss<2>(4), true);
+  test<2>(FESystem<2>(FE_Q<2>(2), 2), QGauss<2>(3), false);
+  test<2>(FESystem<2>(FE_DGQ<2>(3), 2), QGauss<2>(5), true);
+  test<2>(FE_Q<2>(2), Quadrature<2>(QGauss<1>(3), QGauss<1>(4)), false);
+  test<3>(FE_Q<3>(2), QGauss<3>(3), true);
+  test<3>(FESystem<3>(FE_DGQ<3>(1), 3), QGauss<3>(2), false);
+  test<3>(FE_DGQ<3>(2), QGauss<3>(3), true);
+}
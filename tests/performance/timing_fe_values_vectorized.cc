@@ -0,0 +1,216 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for FEValuesVectorized. It computes the cell
+// matrices and right hand sides of a Laplace problem with FE_Q(2) elements
+// on a curved three-dimensional mesh, once cell by cell with FEValues and
+// once on batches of cells with FEValuesVectorized, and measures the time
+// spent in reinit() and in the loops over the degrees of freedom and
+// quadrature points separately. The cell matrices are not added to a
+// global matrix.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/conditional_ostream.h>
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+#include <deal.II/base/vectorization.h>
+
+#include <deal.II/dofs/dof_handler.h>
+
+#include <deal.II/fe/fe_q.h>
+#include <deal.II/fe/fe_values.h>
+#include <deal.II/fe/fe_values_vectorized.h>
+#include <deal.II/fe/mapping_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/full_matrix.h>
+#include <deal.II/lac/vector.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+dealii::ConditionalOStream debug_output(std::cout, false);
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"fe_values_reinit",
+           "fe_values_integrate",
+           "fe_values_vectorized_reinit",
+           "fe_values_vectorized_integrate"}};
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  constexpr int dim = 3;
+
+  unsigned int n_refinements = 0;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        n_refinements = 1;
+        break;
+      case TestingEnvironment::medium:
+        n_refinements = 2;
+        break;
+      case TestingEnvironment::heavy:
+        n_refinements = 3;
+        break;
+    }
+
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_shell(triangulation, Point<dim>(), 0.5, 1., 12);
+  triangulation.refine_global(n_refinements);
+
+  const FE_Q<dim> fe(2);
+  DoFHandler<dim> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const MappingQ<dim> mapping(2);
+  const QGauss<dim>   quadrature(fe.degree + 1);
+  const UpdateFlags   flags = update_values | update_gradients |
+                            update_quadrature_points | update_JxW_values;
+
+  const unsigned int dofs_per_cell = fe.n_dofs_per_cell();
+
+  // cell by cell with FEValues
+  double fe_values_reinit    = 0;
+  double fe_values_integrate = 0;
+  double checksum            = 0;
+  {
+    FEValues<dim>      fe_values(mapping, fe, quadrature, flags);
+    FullMatrix<double> cell_matrix(dofs_per_cell, dofs_per_cell);
+    Vector<double>     cell_rhs(dofs_per_cell);
+
+    Timer reinit_timer;
+    Timer integrate_timer;
+    reinit_timer.stop();
+    integrate_timer.stop();
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        reinit_timer.start();
+        fe_values.reinit(cell);
+        reinit_timer.stop();
+
+        integrate_timer.start();
+        for (const unsigned int i : fe_values.dof_indices())
+          {
+            for (const unsigned int j : fe_values.dof_indices())
+              {
+                double sum = 0.;
+                for (const unsigned int q :
+                     fe_values.quadrature_point_indices())
+                  sum += fe_values.shape_grad(i, q) *
+                         fe_values.shape_grad(j, q) * fe_values.JxW(q);
+                cell_matrix(i, j) = sum;
+              }
+
+            double sum = 0.;
+            for (const unsigned int q : fe_values.quadrature_point_indices())
+              sum += fe_values.shape_value(i, q) *
+                     fe_values.quadrature_point(q).norm_square() *
+                     fe_values.JxW(q);
+            cell_rhs(i) = sum;
+          }
+        integrate_timer.stop();
+
+        checksum += cell_matrix.trace() + cell_rhs.l1_norm();
+      }
+    fe_values_reinit    = reinit_timer.wall_time();
+    fe_values_integrate = integrate_timer.wall_time();
+  }
+
+  // on batches of cells with FEValuesVectorized
+  double fe_values_vectorized_reinit    = 0;
+  double fe_values_vectorized_integrate = 0;
+  double checksum_vectorized            = 0;
+  {
+    constexpr unsigned int n_lanes = VectorizedArray<double>::size();
+
+    FEValuesVectorized<dim> fe_values(mapping, fe, quadrature, flags);
+    Table<2, VectorizedArray<double>> cell_matrix(dofs_per_cell,
+                                                  dofs_per_cell);
+    std::vector<VectorizedArray<double>> cell_rhs(dofs_per_cell);
+
+    Timer reinit_timer;
+    Timer integrate_timer;
+    reinit_timer.stop();
+    integrate_timer.stop();
+    std::vector<typename DoFHandler<dim>::active_cell_iterator> cells;
+    for (const auto &cell : dof_handler.active_cell_iterators())
+      {
+        cells.push_back(cell);
+        if (cells.size() < n_lanes && std::next(cell) != dof_handler.end())
+          continue;
+
+        reinit_timer.start();
+        fe_values.reinit(make_array_view(cells));
+        reinit_timer.stop();
+
+        integrate_timer.start();
+        for (const unsigned int i : fe_values.dof_indices())
+          {
+            for (const unsigned int j : fe_values.dof_indices())
+              {
+                VectorizedArray<double> sum = 0.;
+                for (const unsigned int q :
+                     fe_values.quadrature_point_indices())
+                  sum += fe_values.shape_grad(i, q) *
+                         fe_values.shape_grad(j, q) * fe_values.JxW(q);
+                cell_matrix(i, j) = sum;
+              }
+
+            VectorizedArray<double> sum = 0.;
+            for (const unsigned int q : fe_values.quadrature_point_indices())
+              sum += fe_values.shape_value(i, q) *
+                     fe_values.quadrature_point(q).norm_square() *
+                     fe_values.JxW(q);
+            cell_rhs[i] = sum;
+          }
+        integrate_timer.stop();
+
+        for (unsigned int v = 0; v < cells.size(); ++v)
+          for (unsigned int i = 0; i < dofs_per_cell; ++i)
+            checksum_vectorized +=
+              cell_matrix(i, i)[v] + std::abs(cell_rhs[i][v]);
+        cells.clear();
+      }
+    fe_values_vectorized_reinit    = reinit_timer.wall_time();
+    fe_values_vectorized_integrate = integrate_timer.wall_time();
+  }
+
+  debug_output << "Number of cells: " << triangulation.n_active_cells()
+               << ", checksums " << checksum << ' ' << checksum_vectorized
+               << std::endl;
+
+  return {fe_values_reinit,
+          fe_values_integrate,
+          fe_values_vectorized_reinit,
+          fe_values_vectorized_integrate};
+}
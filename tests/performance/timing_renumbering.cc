@@ -0,0 +1,166 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark for DoF renumberings on a three-dimensional,
+// adaptively refined mesh with FE_Q(2) elements. It measures the time to
+// compute the Cuthill-McKee and (if deal.II is configured with METIS) the
+// nested dissection numbering, and the time of a fixed number of sparse
+// matrix-vector products with the mass matrix in the numbering created by
+// DoFHandler::distribute_dofs() and after each of the renumberings.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/quadrature_lib.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/dofs/dof_handler.h>
+#include <deal.II/dofs/dof_renumbering.h>
+#include <deal.II/dofs/dof_tools.h>
+
+#include <deal.II/fe/fe_q.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparse_matrix.h>
+#include <deal.II/lac/sparsity_pattern.h>
+#include <deal.II/lac/vector.h>
+
+#include <deal.II/numerics/matrix_creator.h>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"vmult_distribute_dofs",
+           "compute_cuthill_mckee",
+           "vmult_cuthill_mckee",
+           "vmult_reverse_cuthill_mckee",
+#ifdef DEAL_II_WITH_METIS
+           "compute_nested_dissection",
+           "vmult_nested_dissection"
+#endif
+          }};
+}
+
+
+
+double
+time_vmult(const DoFHandler<3> &dof_handler, const unsigned int n_vmults)
+{
+  DynamicSparsityPattern dsp(dof_handler.n_dofs());
+  DoFTools::make_sparsity_pattern(dof_handler, dsp);
+  SparsityPattern sparsity_pattern;
+  sparsity_pattern.copy_from(dsp);
+
+  SparseMatrix<double> matrix(sparsity_pattern);
+  MatrixCreator::create_mass_matrix(dof_handler,
+                                    QGauss<3>(dof_handler.get_fe().degree + 1),
+                                    matrix);
+
+  Vector<double> src(dof_handler.n_dofs()), dst(dof_handler.n_dofs());
+  src = 1.;
+
+  Timer timer;
+  for (unsigned int i = 0; i < n_vmults; ++i)
+    {
+      matrix.vmult(dst, src);
+      src.add(1e-3, dst);
+    }
+  timer.stop();
+
+  return timer.wall_time();
+}
+
+
+
+Measurement
+perform_single_measurement()
+{
+  constexpr int dim = 3;
+
+  unsigned int n_refinements = 0;
+  unsigned int n_vmults      = 0;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        n_refinements = 2;
+        n_vmults      = 100;
+        break;
+      case TestingEnvironment::medium:
+        n_refinements = 3;
+        n_vmults      = 100;
+        break;
+      case TestingEnvironment::heavy:
+        n_refinements = 4;
+        n_vmults      = 100;
+        break;
+    }
+
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_shell(triangulation, Point<dim>(), 0.5, 1., 12);
+  triangulation.refine_global(n_refinements);
+  for (const auto &cell : triangulation.active_cell_iterators())
+    if (cell->center().norm() < 0.6)
+      cell->set_refine_flag();
+  triangulation.execute_coarsening_and_refinement();
+
+  FE_Q<dim>       fe(2);
+  DoFHandler<dim> dof_handler(triangulation);
+  dof_handler.distribute_dofs(fe);
+
+  const double vmult_distribute_dofs = time_vmult(dof_handler, n_vmults);
+
+  Timer timer;
+  DoFRenumbering::Cuthill_McKee(dof_handler);
+  timer.stop();
+  const double compute_cuthill_mckee = timer.wall_time();
+  const double vmult_cuthill_mckee   = time_vmult(dof_handler, n_vmults);
+
+  dof_handler.distribute_dofs(fe);
+  DoFRenumbering::Cuthill_McKee(dof_handler, true);
+  const double vmult_reverse_cuthill_mckee =
+    time_vmult(dof_handler, n_vmults);
+
+#ifdef DEAL_II_WITH_METIS
+  dof_handler.distribute_dofs(fe);
+  timer.restart();
+  DoFRenumbering::nested_dissection(dof_handler);
+  timer.stop();
+  const double compute_nested_dissection = timer.wall_time();
+  const double vmult_nested_dissection   = time_vmult(dof_handler, n_vmults);
+#endif
+
+  return {vmult_distribute_dofs,
+          compute_cuthill_mckee,
+          vmult_cuthill_mckee,
+          vmult_reverse_cuthill_mckee,
+#ifdef DEAL_II_WITH_METIS
+          compute_nested_dissection,
+          vmult_nested_dissection
+#endif
+  };
+}
@@ -0,0 +1,138 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+//
+// Description:
+//
+// A performance benchmark comparing the boost::geometry R-tree created by
+// pack_rtree_of_indices() with the vectorized PackedRTree for the bounding
+// boxes of the cells of a distorted three-dimensional mesh. It measures the
+// time to build both trees and the time to find the cells whose bounding box
+// contains each of a large number of random points.
+//
+// Status: experimental
+//
+
+#include <deal.II/base/bounding_box.h>
+#include <deal.II/base/timer.h>
+
+#include <deal.II/grid/grid_generator.h>
+#include <deal.II/grid/grid_tools.h>
+#include <deal.II/grid/tria.h>
+
+#include <deal.II/numerics/packed_rtree.h>
+#include <deal.II/numerics/rtree.h>
+
+#include <random>
+
+#include "performance_test_driver.h"
+
+using namespace dealii;
+
+namespace bgi = boost::geometry::index;
+
+
+std::tuple<Metric, unsigned int, std::vector<std::string>>
+describe_measurements()
+{
+  return {Metric::timing,
+          4,
+          {"build_boost_rtree",
+           "build_packed_rtree",
+           "query_boost_rtree",
+           "query_packed_rtree"}};
+}
+
+
+Measurement
+perform_single_measurement()
+{
+  constexpr int dim = 3;
+
+  unsigned int n_refinements = 0;
+  unsigned int n_points      = 0;
+  switch (get_testing_environment())
+    {
+      case TestingEnvironment::light:
+        n_refinements = 5;
+        n_points      = 1000000;
+        break;
+      case TestingEnvironment::medium:
+        n_refinements = 6;
+        n_points      = 4000000;
+        break;
+      case TestingEnvironment::heavy:
+        n_refinements = 7;
+        n_points      = 16000000;
+        break;
+    }
+
+  Triangulation<dim> triangulation;
+  GridGenerator::hyper_cube(triangulation);
+  triangulation.refine_global(n_refinements);
+  GridTools::distort_random(0.25, triangulation);
+
+  std::vector<BoundingBox<dim>> boxes;
+  boxes.reserve(triangulation.n_active_cells());
+  for (const auto &cell : triangulation.active_cell_iterators())
+    boxes.push_back(cell->bounding_box());
+
+  std::mt19937                           random_number_generator;
+  std::uniform_real_distribution<double> distribution(0., 1.);
+  std::vector<Point<dim>>                points(n_points);
+  for (auto &point : points)
+    for (unsigned int d = 0; d < dim; ++d)
+      point[d] = distribution(random_number_generator);
+
+  std::map<std::string, dealii::Timer> timer;
+
+  timer["build_boost_rtree"].start();
+  const auto boost_tree = pack_rtree_of_indices(boxes);
+  timer["build_boost_rtree"].stop();
+
+  timer["build_packed_rtree"].start();
+  const PackedRTree<dim> packed_tree(boxes);
+  timer["build_packed_rtree"].stop();
+
+  std::vector<unsigned int> indices;
+  std::size_t               n_boost_hits = 0;
+
+  timer["query_boost_rtree"].start();
+  for (const auto &point : points)
+    {
+      indices.clear();
+      boost_tree.query(bgi::intersects(point), std::back_inserter(indices));
+      n_boost_hits += indices.size();
+    }
+  timer["query_boost_rtree"].stop();
+
+  std::size_t n_packed_hits = 0;
+
+  timer["query_packed_rtree"].start();
+  for (const auto &point : points)
+    {
+      indices.clear();
+      packed_tree.query(point, std::back_inserter(indices));
+      n_packed_hits += indices.size();
+    }
+  timer["query_packed_rtree"].stop();
+
+  AssertThrow(n_boost_hits == n_packed_hits, ExcInternalError());
+
+  return {timer["build_boost_rtree"].wall_time(),
+          timer["build_packed_rtree"].wall_time(),
+          timer["query_boost_rtree"].wall_time(),
+          timer["query_packed_rtree"].wall_time()};
+}
@@ -0,0 +1,159 @@
+// ---------------------------------------------------------------------
+//
+// Copyright (C) 2023 by the deal.II authors
+//
+// This file is part of the deal.II library.
+//
+// The deal.II library is free software; you can use it, redistribute
+// it, and/or modify it under the terms of the GNU Lesser General
+// Public License as published by the Free Software Foundation; either
+// version 2.1 of the License, or (at your option) any later version.
+// The full text of the license can be found in the file LICENSE.md at
+// the top level directory of deal.II.
+//
+// ---------------------------------------------------------------------
+
+
+
+// SparsityTools::reorder_Cuthill_McKee searches the next level of nodes in
+// parallel if the current level is large. Check that the result is the same
+// as the one of a simple sequential implementation of the algorithm, for the
+// graph of a 27-point stencil on a structured grid that is large enough to
+// trigger the parallel search, as well as for graphs that consist of two
+// such components. Print the bandwidth of the graph before and after the
+// renumbering.
+
+#include <deal.II/lac/dynamic_sparsity_pattern.h>
+#include <deal.II/lac/sparsity_tools.h>
+
+#include <algorithm>
+#include <numeric>
+
+#include "../tests.h"
+
+
+void
+add_grid_graph(DynamicSparsityPattern &dsp,
+               const unsigned int      n,
+               const unsigned int      offset)
+{
+  for (unsigned int k = 0; k < n; ++k)
+    for (unsigned int j = 0; j < n; ++j)
+      for (unsigned int i = 0; i < n; ++i)
+        for (unsigned int kk = (k > 0 ? k - 1 : 0); kk <= std::min(k + 1, n - 1);
+             ++kk)
+          for (unsigned int jj = (j > 0 ? j - 1 : 0);
+               jj <= std::min(j + 1, n - 1);
+               ++jj)
+            for (unsigned int ii = (i > 0 ? i - 1 : 0);
+                 ii <= std::min(i + 1, n - 1);
+                 ++ii)
+              dsp.add(offset + (k * n + j) * n + i,
+                      offset + (kk * n + jj) * n + ii);
+}
+
+
+
+std::vector<types::global_dof_index>
+reference_Cuthill_McKee(const DynamicSparsityPattern &dsp)
+{
+  const types::global_dof_index        n = dsp.n_rows();
+  std::vector<types::global_dof_index> new_indices(n,
+                                                   numbers::invalid_dof_index);
+  types::global_dof_index              next_free = 0;
+
+  while (next_free < n)
+    {
+      // start a new component at the unnumbered node with the smallest
+      // coordination number
+      types::global_dof_index start = numbers::invalid_dof_index;
+      for (types::global_dof_index i = 0; i < n; ++i)
+        if (new_indices[i] == numbers::invalid_dof_index &&
+            (start == numbers::invalid_dof_index ||
+             dsp.row_length(i) < dsp.row_length(start)))
+          start = i;
+
+      std::vector<types::global_dof_index> front(1, start);
+      new_indices[start] = next_free++;
+      while (front.empty() == false)
+        {
+          std::vector<std::pair<unsigned int, types::global_dof_index>> next;
+          for (const auto dof : front)
+            for (unsigned int c = 0; c < dsp.row_length(dof); ++c)
+              {
+                const auto column = dsp.column_number(dof, c);
+                if (new_indices[column] == numbers::invalid_dof_index)
+                  next.emplace_back(dsp.row_length(column), column);
+              }
+          std::sort(next.begin(), next.end());
+          next.erase(std::unique(next.begin(), next.end()), next.end());
+
+          front.clear();
+          for (const auto &entry : next)
+            {
+              new_indices[entry.second] = next_free++;
+              front.push_back(entry.second);
+            }
+        }
+    }
+
+  return new_indices;
+}
+
+
+
+types::global_dof_index
+bandwidth(const DynamicSparsityPattern               &dsp,
+          const std::vector<types::global_dof_index> &new_indices)
+{
+  types::global_dof_index result = 0;
+  for (types::global_dof_index row = 0; row < dsp.n_rows(); ++row)
+    for (unsigned int c = 0; c < dsp.row_length(row); ++c)
+      {
+        const types::global_dof_index i = new_indices[row];
+        const types::global_dof_index j =
+          new_indices[dsp.column_number(row, c)];
+        result = std::max(result, (i > j ? i - j : j - i));
+      }
+  return result;
+}
+
+
+
+void
+test(const unsigned int n, const unsigned int n_components)
+{
+  const types::global_dof_index n_nodes = n * n * n;
+
+  DynamicSparsityPattern dsp(n_components * n_nodes, n_components * n_nodes);
+  for (unsigned int c = 0; c < n_components; ++c)
+    add_grid_graph(dsp, n, c * n_nodes);
+
+  std::vector<types::global_dof_index> new_indices(dsp.n_rows());
+  SparsityTools::reorder_Cuthill_McKee(dsp, new_indices);
+
+  std::vector<types::global_dof_index> identity(dsp.n_rows());
+  std::iota(identity.begin(), identity.end(), types::global_dof_index(0));
+
+  deallog << "n=" << n << " components=" << n_components
+          << ": bandwidth before " << bandwidth(dsp, identity) << ", after "
+          << bandwidth(dsp, new_indices) << ", "
+          << (new_indices == reference_Cuthill_McKee(dsp) ?
+                "same as reference" :
+                "different from reference")
+          << std::endl;
+}
+
+
+
+int
+main()
+{
+  initlog();
+
+  test(1, 1);
+  test(5, 1);
+  test(40, 1);
+  test(30, 2);
+  test(12, 3);
+}